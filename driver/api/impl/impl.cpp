@@ -93,7 +93,12 @@ SQLRETURN SetEnvAttr(
         LOG("SetEnvAttr: " << attribute);
 
         switch (attribute) {
-            case SQL_ATTR_CONNECTION_POOLING:
+            case SQL_ATTR_CONNECTION_POOLING: {
+                environment.connection_pooling = static_cast<SQLUINTEGER>(reinterpret_cast<std::uintptr_t>(value));
+                LOG("Set connection pooling to " << environment.connection_pooling);
+                return SQL_SUCCESS;
+            }
+
             case SQL_ATTR_CP_MATCH:
             case SQL_ATTR_OUTPUT_NTS:
                 return SQL_SUCCESS;
@@ -138,6 +143,8 @@ SQLRETURN GetEnvAttr(
                 return fillOutputPOD<SQLUINTEGER>(environment.odbc_version, out_value, out_value_length);
 
             case SQL_ATTR_CONNECTION_POOLING:
+                return fillOutputPOD<SQLUINTEGER>(environment.connection_pooling, out_value, out_value_length);
+
             case SQL_ATTR_CP_MATCH:
             case SQL_ATTR_OUTPUT_NTS:
             default:
@@ -163,11 +170,7 @@ SQLRETURN SetConnectAttr(
             case SQL_ATTR_CONNECTION_TIMEOUT: {
                 auto connection_timeout = static_cast<SQLUSMALLINT>(reinterpret_cast<intptr_t>(value));
                 LOG("Set connection timeout: " << connection_timeout);
-                connection.connection_timeout = connection.timeout;
-                if (connection.session)
-                    connection.session->setTimeout(Poco::Timespan(connection.connection_timeout, 0),
-                        Poco::Timespan(connection.timeout, 0),
-                        Poco::Timespan(connection.timeout, 0));
+                connection.connection_timeout = connection.timeout; // Applied to the sessions, when they are leased to the statements.
                 return SQL_SUCCESS;
             }
 
@@ -207,8 +210,12 @@ SQLRETURN SetConnectAttr(
                 connection.setAttr(SQL_ATTR_METADATA_ID, value);
                 return SQL_SUCCESS;
 
-            case SQL_ATTR_ACCESS_MODE:
             case SQL_ATTR_ASYNC_ENABLE:
+                // The default for the statements of the connection, both existing and future ones.
+                connection.setAttr(SQL_ATTR_ASYNC_ENABLE, value);
+                return SQL_SUCCESS;
+
+            case SQL_ATTR_ACCESS_MODE:
             case SQL_ATTR_AUTO_IPD:
             case SQL_ATTR_AUTOCOMMIT:
             case SQL_ATTR_CONNECTION_DEAD:
@@ -246,7 +253,7 @@ SQLRETURN GetConnectAttr(
         switch (attribute) {
             CASE_NUM(SQL_ATTR_CONNECTION_DEAD, SQLUINTEGER, SQL_CD_FALSE);
             CASE_FALLTHROUGH(SQL_ATTR_CONNECTION_TIMEOUT);
-            CASE_NUM(SQL_ATTR_LOGIN_TIMEOUT, SQLUSMALLINT, connection.session ? connection.session->getTimeout().seconds() : connection.timeout);
+            CASE_NUM(SQL_ATTR_LOGIN_TIMEOUT, SQLUSMALLINT, connection.timeout);
             CASE_NUM(SQL_ATTR_TXN_ISOLATION, SQLINTEGER, SQL_TXN_SERIALIZABLE); // mssql linked server
             CASE_NUM(SQL_ATTR_AUTOCOMMIT, SQLINTEGER, SQL_AUTOCOMMIT_ON);
 
@@ -277,8 +284,13 @@ SQLRETURN GetConnectAttr(
                     out_value, out_value_length
                 );
 
-            case SQL_ATTR_ACCESS_MODE:
             case SQL_ATTR_ASYNC_ENABLE:
+                return fillOutputPOD<SQLULEN>(
+                    connection.getAttrAs<SQLULEN>(SQL_ATTR_ASYNC_ENABLE, SQL_ASYNC_ENABLE_OFF),
+                    out_value, out_value_length
+                );
+
+            case SQL_ATTR_ACCESS_MODE:
             case SQL_ATTR_AUTO_IPD:
             case SQL_ATTR_ODBC_CURSORS:
             case SQL_ATTR_PACKET_SIZE:
@@ -396,16 +408,38 @@ SQLRETURN SetStmtAttr(
                 statement.setAttr(SQL_ATTR_METADATA_ID, value);
                 return SQL_SUCCESS;
 
+            case SQL_ATTR_ASYNC_ENABLE:
+                statement.setAttr(SQL_ATTR_ASYNC_ENABLE, value);
+                return SQL_SUCCESS;
+
+            case SQL_ATTR_ASYNC_STMT_NOTIFICATION_CALLBACK:
+            case SQL_ATTR_ASYNC_STMT_NOTIFICATION_CONTEXT:
+#if defined(SQL_ATTR_ASYNC_STMT_EVENT)
+            case SQL_ATTR_ASYNC_STMT_EVENT:
+#endif
+                statement.setAttr(attribute, value);
+                return SQL_SUCCESS;
+
             case SQL_ATTR_APP_ROW_DESC:
             case SQL_ATTR_APP_PARAM_DESC:
             case SQL_ATTR_IMP_ROW_DESC:
             case SQL_ATTR_IMP_PARAM_DESC:
                 return setDescriptorHandle(statement, attribute, reinterpret_cast<SQLHANDLE>(value));
 
+            case SQL_ATTR_CONCURRENCY: {
+                // Rows can only be added, see SQLBulkOperations(SQL_ADD), so any updatable concurrency is served the same way.
+                const auto concurrency = reinterpret_cast<SQLULEN>(value);
+                if (concurrency == SQL_CONCUR_READ_ONLY || concurrency == SQL_CONCUR_LOCK) {
+                    statement.setAttr(SQL_ATTR_CONCURRENCY, concurrency);
+                    return SQL_SUCCESS;
+                }
+
+                statement.setAttr(SQL_ATTR_CONCURRENCY, SQL_CONCUR_LOCK);
+                throw SqlException("Option value changed", "01S02", SQL_SUCCESS_WITH_INFO);
+            }
+
             case SQL_ATTR_CURSOR_SCROLLABLE:
             case SQL_ATTR_CURSOR_SENSITIVITY:
-            case SQL_ATTR_ASYNC_ENABLE:
-            case SQL_ATTR_CONCURRENCY:
             case SQL_ATTR_CURSOR_TYPE: /// Libreoffice Base
             case SQL_ATTR_ENABLE_AUTO_IPD:
             case SQL_ATTR_FETCH_BOOKMARK_PTR:
@@ -471,8 +505,6 @@ SQLRETURN GetStmtAttr(
 
             CASE_NUM(SQL_ATTR_CURSOR_SCROLLABLE, SQLULEN, SQL_NONSCROLLABLE);
             CASE_NUM(SQL_ATTR_CURSOR_SENSITIVITY, SQLULEN, SQL_INSENSITIVE);
-            CASE_NUM(SQL_ATTR_ASYNC_ENABLE, SQLULEN, SQL_ASYNC_ENABLE_OFF);
-            CASE_NUM(SQL_ATTR_CONCURRENCY, SQLULEN, SQL_CONCUR_READ_ONLY);
             CASE_NUM(SQL_ATTR_CURSOR_TYPE, SQLULEN, SQL_CURSOR_FORWARD_ONLY);
             CASE_NUM(SQL_ATTR_ENABLE_AUTO_IPD, SQLULEN, SQL_FALSE);
             CASE_NUM(SQL_ATTR_MAX_LENGTH, SQLULEN, 0);
@@ -487,12 +519,31 @@ SQLRETURN GetStmtAttr(
                     out_value, out_value_length
                 );
 
+            CASE_FALLTHROUGH(SQL_ATTR_CONCURRENCY)
+                return fillOutputPOD<SQLULEN>(
+                    statement.getAttrAs<SQLULEN>(SQL_ATTR_CONCURRENCY, SQL_CONCUR_READ_ONLY),
+                    out_value, out_value_length
+                );
+
             CASE_FALLTHROUGH(SQL_ATTR_NOSCAN)
                 return fillOutputPOD<SQLULEN>(
                     statement.getAttrAs<SQLULEN>(SQL_ATTR_NOSCAN, SQL_NOSCAN_OFF),
                     out_value, out_value_length
                 );
 
+            CASE_FALLTHROUGH(SQL_ATTR_ASYNC_ENABLE)
+                return fillOutputPOD<SQLULEN>(
+                    (statement.isAsyncEnabled() ? SQL_ASYNC_ENABLE_ON : SQL_ASYNC_ENABLE_OFF),
+                    out_value, out_value_length
+                );
+
+            CASE_FALLTHROUGH(SQL_ATTR_ASYNC_STMT_NOTIFICATION_CALLBACK)
+            CASE_FALLTHROUGH(SQL_ATTR_ASYNC_STMT_NOTIFICATION_CONTEXT)
+#if defined(SQL_ATTR_ASYNC_STMT_EVENT)
+            CASE_FALLTHROUGH(SQL_ATTR_ASYNC_STMT_EVENT)
+#endif
+                return fillOutputPOD<SQLPOINTER>(statement.getAttrAs<SQLPOINTER>(attribute), out_value, out_value_length);
+
             case SQL_ATTR_ROW_NUMBER: {
                 if (!statement.hasResultSet())
                     throw SqlException("Invalid cursor state", "24000");
@@ -1243,6 +1294,26 @@ SQLRETURN EndTran(
     return CALL_WITH_TYPED_HANDLE_SKIP_DIAG(handle_type, handle, func);
 }
 
+SQLRETURN Cancel(
+    SQLHSTMT       StatementHandle
+) noexcept {
+    auto func = [&] (Statement & statement) -> SQLRETURN {
+        // If another thread is in a call on the statement, only the query of the statement is killed, and the call fails with HY008.
+        // Otherwise, the statement is cancelled right here, as usual, once the calls on the other handles of the connection, if any, are done.
+        if (statement.isInCall()) {
+            statement.requestCancel();
+            return SQL_SUCCESS;
+        }
+
+        return CALL_WITH_TYPED_HANDLE_ASYNC_CAPABLE(SQL_HANDLE_STMT, StatementHandle, [] (Statement & statement) {
+            statement.cancel();
+            return SQL_SUCCESS;
+        });
+    };
+
+    return CALL_WITH_TYPED_HANDLE_UNSERIALIZED(SQL_HANDLE_STMT, StatementHandle, func);
+}
+
 SQLRETURN fillBinding(
     Statement & statement,
     ResultSet & result_set,
@@ -1286,7 +1357,7 @@ SQLRETURN fillBinding(
         binding_info.scale = record.getAttrAs<SQLSMALLINT>(SQL_DESC_SCALE, 0);
     }
 
-    return result_set.extractField(row_idx, column_idx, binding_info);
+    return result_set.getData(row_idx, column_idx, binding_info);
 }
 
 SQLRETURN fetchBindings(
@@ -1294,17 +1365,17 @@ SQLRETURN fetchBindings(
     SQLSMALLINT orientation,
     SQLLEN offset
 ) {
-    auto & ard_desc = statement.getEffectiveDescriptor(SQL_ATTR_APP_ROW_DESC);
     auto & ird_desc = statement.getEffectiveDescriptor(SQL_ATTR_IMP_ROW_DESC);
 
-    const auto row_set_size = ard_desc.getAttrAs<SQLULEN>(SQL_DESC_ARRAY_SIZE, 1);
     auto * rows_fetched_ptr = ird_desc.getAttrAs<SQLULEN *>(SQL_DESC_ROWS_PROCESSED_PTR, 0);
     auto * array_status_ptr = ird_desc.getAttrAs<SQLUSMALLINT *>(SQL_DESC_ARRAY_STATUS_PTR, 0);
 
     if (rows_fetched_ptr)
         *rows_fetched_ptr = 0;
 
-    if (!statement.hasResultSet() || row_set_size == 0) {
+    if (!statement.hasResultSet()) {
+        const auto row_set_size = statement.getEffectiveDescriptor(SQL_ATTR_APP_ROW_DESC).getAttrAs<SQLULEN>(SQL_DESC_ARRAY_SIZE, 1);
+
         if (array_status_ptr) {
             for (std::size_t row_idx = 0; row_idx < row_set_size; ++row_idx) {
                 array_status_ptr[row_idx] = SQL_ROW_NOROW;
@@ -1314,8 +1385,24 @@ SQLRETURN fetchBindings(
         return SQL_NO_DATA;
     }
 
+    const auto & binding_plan = statement.getBindingPlan();
+    const auto row_set_size = binding_plan.row_set_size;
+
+    if (row_set_size == 0)
+        return SQL_NO_DATA;
+
     auto & result_set = statement.getResultSet();
-    const auto rows_fetched = result_set.fetchRowSet(orientation, offset, row_set_size);
+    std::size_t rows_fetched = 0;
+
+    try {
+        rows_fetched = result_set.fetchRowSet(orientation, offset, row_set_size);
+    }
+    catch (...) {
+        // The response of a killed query is cut short.
+        if (statement.isCancelRequested())
+            throw SqlException("Operation canceled", "HY008");
+        throw;
+    }
 
     if (rows_fetched == 0) {
         statement.getDiagHeader().setAttr(SQL_DIAG_ROW_COUNT, result_set.getAffectedRowCount());
@@ -1332,96 +1419,85 @@ SQLRETURN fetchBindings(
     if (rows_fetched_ptr)
         *rows_fetched_ptr = rows_fetched;
 
-    const auto ard_record_count = ard_desc.getRecordCount();
-    ard_desc.getRecord(ard_record_count, SQL_ATTR_APP_ROW_DESC); // ...just to make sure that record container is in sync with SQL_DESC_COUNT.
-    const auto & ard_records = ard_desc.getRecordContainer(); // ...only for faster access in a loop.
-
-    const auto bind_type = ard_desc.getAttrAs<SQLULEN>(SQL_DESC_BIND_TYPE, SQL_BIND_TYPE_DEFAULT);
-    const auto * bind_offset_ptr = ard_desc.getAttrAs<SQLULEN *>(SQL_DESC_BIND_OFFSET_PTR, 0);
-    const auto bind_offset = (bind_offset_ptr ? *bind_offset_ptr : 0);
+    const auto bind_offset = (binding_plan.bind_offset_ptr ? *binding_plan.bind_offset_ptr : 0);
 
     bool success_with_info_met = false;
     std::size_t error_num = 0;
 
-    BindingInfo * base_bindings = nullptr;
-    if (ard_record_count > 0) {
-        base_bindings = static_cast<BindingInfo *>(stack_alloc(ard_record_count * sizeof(BindingInfo)));
-        if (base_bindings == nullptr)
+    const auto make_row_binding = [&] (const ColumnBinding & column, std::size_t row_idx) {
+        const auto & base_binding = column.base;
+
+        BindingInfo binding_info = base_binding;
+        binding_info.value = (SQLPOINTER)(base_binding.value ? ((char *)(base_binding.value) + row_idx * column.value_stride + bind_offset) : 0);
+        binding_info.value_size = (SQLLEN *)(base_binding.value_size ? ((char *)(base_binding.value_size) + row_idx * column.sz_ind_stride + bind_offset) : 0);
+        binding_info.indicator = (SQLLEN *)(base_binding.indicator ? ((char *)(base_binding.indicator) + row_idx * column.sz_ind_stride + bind_offset) : 0);
+
+        return binding_info;
+    };
+
+    // The extractors depend on how the values of the fetched row set are stored, so they are resolved once per row set.
+    // Columns, whose values can be written to the column-wise bound arrays as they are, are written right here, entirely,
+    // and are left without an extractor.
+    const auto bound_column_count = binding_plan.columns.size();
+    ColumnData::Extractor * extractors = nullptr;
+    if (bound_column_count > 0) {
+        extractors = static_cast<ColumnData::Extractor *>(stack_alloc(bound_column_count * sizeof(ColumnData::Extractor)));
+        if (extractors == nullptr)
             throw std::bad_alloc();
-        std::fill(base_bindings, base_bindings + ard_record_count, BindingInfo{});
-    }
 
-    // Prepare the base binding info for all columns before iterating over the row set.
-    for (std::size_t column_num = 1; column_num <= ard_record_count; ++column_num) { // Skipping the bookmark (0) column.
-        const auto column_idx = column_num - 1;
-        const auto & ard_record = ard_records[column_num];
-        auto & base_binding = base_bindings[column_idx];
-
-        base_binding.c_type = ard_record.getAttrAs<SQLSMALLINT>(SQL_DESC_CONCISE_TYPE, SQL_C_DEFAULT);
-        base_binding.value = ard_record.getAttrAs<SQLPOINTER>(SQL_DESC_DATA_PTR, 0);
-        base_binding.value_max_size = ard_record.getAttrAs<SQLLEN>(SQL_DESC_OCTET_LENGTH, 0);
-        base_binding.value_size = ard_record.getAttrAs<SQLLEN *>(SQL_DESC_OCTET_LENGTH_PTR, 0);
-        base_binding.indicator = ard_record.getAttrAs<SQLLEN *>(SQL_DESC_INDICATOR_PTR, 0);
+        for (std::size_t i = 0; i < bound_column_count; ++i) {
+            const auto & column = binding_plan.columns[i];
+            extractors[i] = nullptr;
+
+            if (binding_plan.column_wise) {
+                auto binding_info = make_row_binding(column, 0);
+                if (result_set.extractColumn(column.column_idx, binding_info))
+                    continue;
+            }
+
+            extractors[i] = result_set.getExtractor(column.column_idx, column.base.c_type);
+        }
     }
 
     for (std::size_t row_idx = 0; row_idx < rows_fetched; ++row_idx) {
-        for (std::size_t column_num = 1; column_num <= ard_record_count; ++column_num) { // Skipping the bookmark (0) column.
-            const auto column_idx = column_num - 1;
-            auto & base_binding = base_bindings[column_idx];
-            SQLRETURN code = SQL_SUCCESS;
-
-            if (
-                base_binding.value ||
-                base_binding.value_size ||
-                base_binding.indicator
-            ) { // Only if the column is bound...
-                const auto next_value_ptr_increment = (bind_type == SQL_BIND_BY_COLUMN ? base_binding.value_max_size : bind_type);
-                const auto next_sz_ind_ptr_increment = (bind_type == SQL_BIND_BY_COLUMN ? sizeof(SQLLEN) : bind_type);
-
-                BindingInfo binding_info;
-                binding_info.c_type = base_binding.c_type;
-                binding_info.value_max_size = base_binding.value_max_size;
-                binding_info.value = (SQLPOINTER)(base_binding.value ? ((char *)(base_binding.value) + row_idx * next_value_ptr_increment + bind_offset) : 0);
-                binding_info.value_size = (SQLLEN *)(base_binding.value_size ? ((char *)(base_binding.value_size) + row_idx * next_sz_ind_ptr_increment + bind_offset) : 0);
-                binding_info.indicator = (SQLLEN *)(base_binding.indicator ? ((char *)(base_binding.indicator) + row_idx * next_sz_ind_ptr_increment + bind_offset) : 0);
-
-                // TODO: fill per-row and per-column diagnostics on (some soft?) errors.
-                const auto code = fillBinding(
-                    statement,
-                    result_set,
-                    row_idx,
-                    column_idx,
-                    binding_info
-                );
-            }
+        SQLUSMALLINT row_status = SQL_ROW_SUCCESS;
+
+        for (std::size_t i = 0; i < bound_column_count; ++i) {
+            if (!extractors[i])
+                continue;
+
+            const auto & column = binding_plan.columns[i];
+            auto binding_info = make_row_binding(column, row_idx);
+
+            // TODO: fill per-row and per-column diagnostics on (some soft?) errors.
+            const auto code = result_set.extractField(row_idx, column.column_idx, extractors[i], binding_info);
 
             switch (code) {
                 case SQL_SUCCESS: {
-                    if (array_status_ptr)
-                        array_status_ptr[row_idx] = SQL_ROW_SUCCESS;
-
                     break;
                 }
 
                 case SQL_SUCCESS_WITH_INFO: {
                     success_with_info_met = true;
 
-                    if (array_status_ptr)
-                        array_status_ptr[row_idx] = SQL_ROW_SUCCESS_WITH_INFO;
+                    if (row_status == SQL_ROW_SUCCESS)
+                        row_status = SQL_ROW_SUCCESS_WITH_INFO;
 
                     break;
                 }
 
                 default: {
-                    ++error_num;
-
-                    if (array_status_ptr)
-                        array_status_ptr[row_idx] = SQL_ROW_ERROR;
-
+                    row_status = SQL_ROW_ERROR;
                     break;
                 }
             }
         }
+
+        if (row_status == SQL_ROW_ERROR)
+            ++error_num;
+
+        if (array_status_ptr)
+            array_status_ptr[row_idx] = row_status;
     }
 
     if (array_status_ptr) {
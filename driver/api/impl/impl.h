@@ -185,6 +185,10 @@ namespace impl {
         SQLSMALLINT     completion_type
     ) noexcept;
 
+    SQLRETURN Cancel(
+        SQLHSTMT       StatementHandle
+    ) noexcept;
+
     SQLRETURN GetData(
         SQLHSTMT       StatementHandle,
         SQLUSMALLINT   Col_or_Param_Num,
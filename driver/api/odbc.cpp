@@ -73,15 +73,16 @@ SQLRETURN SQL_API EXPORTED_FUNCTION(SQLFreeHandle)(SQLSMALLINT handleType, SQLHA
 SQLRETURN SQL_API EXPORTED_FUNCTION(SQLFreeStmt)(HSTMT statement_handle, SQLUSMALLINT option) {
     LOG(__FUNCTION__ << " option=" << option);
 
+    // Like SQLFreeHandle(), may be called while a function is being executed asynchronously on the statement.
+    if (option == SQL_DROP)
+        return impl::freeHandle(statement_handle);
+
     return CALL_WITH_TYPED_HANDLE(SQL_HANDLE_STMT, statement_handle, [&] (Statement & statement) -> SQLRETURN {
         switch (option) {
             case SQL_CLOSE: /// Close the cursor, ignore the remaining results. If there is no cursor, then noop.
                 statement.closeCursor();
                 return SQL_SUCCESS;
 
-            case SQL_DROP:
-                return impl::freeHandle(statement_handle);
-
             case SQL_UNBIND:
                 statement.resetColBindings();
                 return SQL_SUCCESS;
@@ -176,9 +177,9 @@ SQLRETURN SQL_API EXPORTED_FUNCTION_MAYBE_W(SQLGetInfo)(
 
             /// UINTEGER single values
             CASE_NUM(SQL_ODBC_INTERFACE_CONFORMANCE, SQLUINTEGER, SQL_OIC_CORE)
-            CASE_NUM(SQL_ASYNC_MODE, SQLUINTEGER, SQL_AM_NONE)
+            CASE_NUM(SQL_ASYNC_MODE, SQLUINTEGER, SQL_AM_STATEMENT)
 #if defined(SQL_ASYNC_NOTIFICATION)
-            CASE_NUM(SQL_ASYNC_NOTIFICATION, SQLUINTEGER, SQL_ASYNC_NOTIFICATION_NOT_CAPABLE)
+            CASE_NUM(SQL_ASYNC_NOTIFICATION, SQLUINTEGER, SQL_ASYNC_NOTIFICATION_CAPABLE)
 #endif
             CASE_NUM(SQL_DEFAULT_TXN_ISOLATION, SQLUINTEGER, SQL_TXN_SERIALIZABLE)
 #if defined(SQL_DRIVER_AWARE_POOLING_CAPABLE)
@@ -186,6 +187,7 @@ SQLRETURN SQL_API EXPORTED_FUNCTION_MAYBE_W(SQLGetInfo)(
 #endif
             CASE_NUM(SQL_PARAM_ARRAY_ROW_COUNTS, SQLUINTEGER, SQL_PARC_BATCH)
             CASE_NUM(SQL_PARAM_ARRAY_SELECTS, SQLUINTEGER, SQL_PAS_BATCH)
+            CASE_NUM(SQL_FORWARD_ONLY_CURSOR_ATTRIBUTES1, SQLUINTEGER, SQL_CA1_BULK_ADD)
             CASE_NUM(SQL_SQL_CONFORMANCE, SQLUINTEGER, SQL_SC_SQL92_ENTRY)
 
             /// USMALLINT single values
@@ -346,7 +348,6 @@ SQLRETURN SQL_API EXPORTED_FUNCTION_MAYBE_W(SQLGetInfo)(
             CASE_FALLTHROUGH(SQL_DROP_TRANSLATION)
             CASE_FALLTHROUGH(SQL_DYNAMIC_CURSOR_ATTRIBUTES1)
             CASE_FALLTHROUGH(SQL_DYNAMIC_CURSOR_ATTRIBUTES2)
-            CASE_FALLTHROUGH(SQL_FORWARD_ONLY_CURSOR_ATTRIBUTES1)
             CASE_FALLTHROUGH(SQL_FORWARD_ONLY_CURSOR_ATTRIBUTES2)
             CASE_FALLTHROUGH(SQL_KEYSET_CURSOR_ATTRIBUTES1)
             CASE_FALLTHROUGH(SQL_KEYSET_CURSOR_ATTRIBUTES2)
@@ -506,19 +507,23 @@ SQLRETURN SQL_API EXPORTED_FUNCTION_MAYBE_W(SQLPrepare)(HSTMT statement_handle,
 SQLRETURN SQL_API EXPORTED_FUNCTION(SQLExecute)(HSTMT statement_handle) {
     LOG(__FUNCTION__);
 
-    return CALL_WITH_TYPED_HANDLE(SQL_HANDLE_STMT, statement_handle, [&](Statement & statement) {
-        statement.executeQuery();
-        return SQL_SUCCESS;
+    return CALL_WITH_TYPED_HANDLE_ASYNC_CAPABLE(SQL_HANDLE_STMT, statement_handle, [&](Statement & statement) {
+        return statement.executeAsyncCapable(SQL_API_SQLEXECUTE, std::string{}, [&] {
+            statement.executeQuery();
+            return (statement.needsData() ? SQL_NEED_DATA : SQL_SUCCESS);
+        });
     });
 }
 
 SQLRETURN SQL_API EXPORTED_FUNCTION_MAYBE_W(SQLExecDirect)(HSTMT statement_handle, SQLTCHAR * statement_text, SQLINTEGER statement_text_size) {
     //LOG(__FUNCTION__ << " statement_text_size=" << statement_text_size << " statement_text=" << statement_text);
 
-    return CALL_WITH_TYPED_HANDLE(SQL_HANDLE_STMT, statement_handle, [&](Statement & statement) {
+    return CALL_WITH_TYPED_HANDLE_ASYNC_CAPABLE(SQL_HANDLE_STMT, statement_handle, [&](Statement & statement) {
         const auto query = toUTF8(statement_text, statement_text_size);
-        statement.executeQuery(query);
-        return SQL_SUCCESS;
+        return statement.executeAsyncCapable(SQL_API_SQLEXECDIRECT, query, [&] {
+            statement.executeQuery(query);
+            return (statement.needsData() ? SQL_NEED_DATA : SQL_SUCCESS);
+        });
     });
 }
 
@@ -789,7 +794,7 @@ SQLRETURN SQL_API EXPORTED_FUNCTION(SQLMoreResults)(HSTMT statement_handle) {
 SQLRETURN SQL_API EXPORTED_FUNCTION(SQLDisconnect)(HDBC connection_handle) {
     LOG(__FUNCTION__);
     return CALL_WITH_TYPED_HANDLE(SQL_HANDLE_DBC, connection_handle, [&](Connection & connection) {
-        connection.session->reset();
+        connection.disconnect();
         return SQL_SUCCESS;
     });
 }
@@ -951,12 +956,14 @@ SQLRETURN SQL_API EXPORTED_FUNCTION_MAYBE_W(SQLTables)(
         }
 
         query << " ORDER BY TABLE_TYPE, TABLE_CAT, TABLE_SCHEM, TABLE_NAME";
-        statement.executeQuery(query.str());
 
-        return SQL_SUCCESS;
+        return statement.executeAsyncCapable(SQL_API_SQLTABLES, query.str(), [&] {
+            statement.executeQuery(query.str());
+            return SQL_SUCCESS;
+        });
     };
 
-    return CALL_WITH_TYPED_HANDLE(SQL_HANDLE_STMT, StatementHandle, func);
+    return CALL_WITH_TYPED_HANDLE_ASYNC_CAPABLE(SQL_HANDLE_STMT, StatementHandle, func);
 }
 
 SQLRETURN SQL_API EXPORTED_FUNCTION_MAYBE_W(SQLColumns)(
@@ -1050,12 +1057,14 @@ SQLRETURN SQL_API EXPORTED_FUNCTION_MAYBE_W(SQLColumns)(
         }
 
         query << " ORDER BY TABLE_CAT, TABLE_SCHEM, TABLE_NAME, ORDINAL_POSITION";
-        statement.executeQuery(query.str(), std::make_unique<SQLColumnsResultSetMutator>(statement));
 
-        return SQL_SUCCESS;
+        return statement.executeAsyncCapable(SQL_API_SQLCOLUMNS, query.str(), [&] {
+            statement.executeQuery(query.str(), std::make_unique<SQLColumnsResultSetMutator>(statement));
+            return SQL_SUCCESS;
+        });
     };
 
-    return CALL_WITH_TYPED_HANDLE(SQL_HANDLE_STMT, StatementHandle, func);
+    return CALL_WITH_TYPED_HANDLE_ASYNC_CAPABLE(SQL_HANDLE_STMT, StatementHandle, func);
 }
 
 SQLRETURN SQL_API EXPORTED_FUNCTION_MAYBE_W(SQLGetTypeInfo)(
@@ -1064,7 +1073,7 @@ SQLRETURN SQL_API EXPORTED_FUNCTION_MAYBE_W(SQLGetTypeInfo)(
 ) {
     LOG(__FUNCTION__ << "(type = " << type << ")");
 
-    return CALL_WITH_TYPED_HANDLE(SQL_HANDLE_STMT, statement_handle, [&](Statement & statement) {
+    return CALL_WITH_TYPED_HANDLE_ASYNC_CAPABLE(SQL_HANDLE_STMT, statement_handle, [&](Statement & statement) {
         std::stringstream query;
         query << "SELECT * FROM (";
 
@@ -1130,8 +1139,10 @@ SQLRETURN SQL_API EXPORTED_FUNCTION_MAYBE_W(SQLGetTypeInfo)(
         if (first)
             query.str("SELECT 1 WHERE 0");
 
-        statement.executeQuery(query.str());
-        return SQL_SUCCESS;
+        return statement.executeAsyncCapable(SQL_API_SQLGETTYPEINFO, query.str(), [&] {
+            statement.executeQuery(query.str());
+            return SQL_SUCCESS;
+        });
     });
 }
 
@@ -1182,12 +1193,8 @@ SQLRETURN SQL_API EXPORTED_FUNCTION_MAYBE_W(SQLBrowseConnect)(HDBC connection_ha
 SQLRETURN SQL_API EXPORTED_FUNCTION(SQLCancel)(
     SQLHSTMT     StatementHandle
 ) {
-    auto func = [&] (Statement & statement) {
-        statement.closeCursor();
-        return SQL_SUCCESS;
-    };
-
-    return CALL_WITH_TYPED_HANDLE(SQL_HANDLE_STMT, StatementHandle, func);
+    LOG(__FUNCTION__);
+    return impl::Cancel(StatementHandle);
 }
 
 SQLRETURN SQL_API EXPORTED_FUNCTION_MAYBE_W(SQLGetCursorName)(
@@ -1213,14 +1220,18 @@ SQLRETURN SQL_API EXPORTED_FUNCTION(SQLGetFunctions)(HDBC connection_handle, SQL
             SET_EXISTS(SQL_API_SQLBINDPARAM);
 #endif
             //SET_EXISTS(SQL_API_SQLBROWSECONNECT);
-            //SET_EXISTS(SQL_API_SQLBULKOPERATIONS);
+            SET_EXISTS(SQL_API_SQLBULKOPERATIONS);
             SET_EXISTS(SQL_API_SQLCANCEL);
-            //SET_EXISTS(SQL_API_SQLCANCELHANDLE);
+#if defined(SQL_API_SQLCANCELHANDLE)
+            SET_EXISTS(SQL_API_SQLCANCELHANDLE);
+#endif
             SET_EXISTS(SQL_API_SQLCLOSECURSOR);
             SET_EXISTS(SQL_API_SQLCOLATTRIBUTE);
             //SET_EXISTS(SQL_API_SQLCOLUMNPRIVILEGES);
             SET_EXISTS(SQL_API_SQLCOLUMNS);
-            //SET_EXISTS(SQL_API_SQLCOMPLETEASYNC);
+#if defined(SQL_API_SQLCOMPLETEASYNC)
+            SET_EXISTS(SQL_API_SQLCOMPLETEASYNC);
+#endif
             SET_EXISTS(SQL_API_SQLCONNECT);
             SET_EXISTS(SQL_API_SQLCOPYDESC);
             SET_EXISTS(SQL_API_SQLDESCRIBECOL);
@@ -1252,12 +1263,12 @@ SQLRETURN SQL_API EXPORTED_FUNCTION(SQLGetFunctions)(HDBC connection_handle, SQL
             SET_EXISTS(SQL_API_SQLNATIVESQL);
             SET_EXISTS(SQL_API_SQLNUMPARAMS);
             SET_EXISTS(SQL_API_SQLNUMRESULTCOLS);
-            //SET_EXISTS(SQL_API_SQLPARAMDATA);
+            SET_EXISTS(SQL_API_SQLPARAMDATA);
             SET_EXISTS(SQL_API_SQLPREPARE);
             //SET_EXISTS(SQL_API_SQLPRIMARYKEYS);
             //SET_EXISTS(SQL_API_SQLPROCEDURECOLUMNS);
             //SET_EXISTS(SQL_API_SQLPROCEDURES);
-            //SET_EXISTS(SQL_API_SQLPUTDATA);
+            SET_EXISTS(SQL_API_SQLPUTDATA);
             SET_EXISTS(SQL_API_SQLROWCOUNT);
             SET_EXISTS(SQL_API_SQLSETCONNECTATTR);
             //SET_EXISTS(SQL_API_SQLSETCURSORNAME);
@@ -1300,12 +1311,27 @@ SQLRETURN SQL_API EXPORTED_FUNCTION(SQLGetFunctions)(HDBC connection_handle, SQL
 
 SQLRETURN SQL_API EXPORTED_FUNCTION(SQLParamData)(HSTMT StatementHandle, PTR * Value) {
     LOG(__FUNCTION__);
-    return SQL_ERROR;
+
+    return CALL_WITH_TYPED_HANDLE(SQL_HANDLE_STMT, StatementHandle, [&](Statement & statement) {
+        SQLPOINTER token = nullptr;
+
+        if (!statement.advanceToNextDataAtExecParam(token))
+            return SQL_SUCCESS;
+
+        if (Value)
+            *Value = token;
+
+        return SQL_NEED_DATA;
+    });
 }
 
 SQLRETURN SQL_API EXPORTED_FUNCTION(SQLPutData)(HSTMT StatementHandle, PTR Data, SQLLEN StrLen_or_Ind) {
     LOG(__FUNCTION__);
-    return SQL_ERROR;
+
+    return CALL_WITH_TYPED_HANDLE(SQL_HANDLE_STMT, StatementHandle, [&](Statement & statement) {
+        statement.putDataAtExecParamData(Data, StrLen_or_Ind);
+        return SQL_SUCCESS;
+    });
 }
 
 SQLRETURN SQL_API EXPORTED_FUNCTION_MAYBE_W(SQLSetCursorName)(HSTMT StatementHandle, SQLTCHAR * CursorName, SQLSMALLINT NameLength) {
@@ -1515,17 +1541,70 @@ SQLRETURN SQL_API EXPORTED_FUNCTION(SQLBulkOperations)(
     SQLSMALLINT      Operation
 ) {
     LOG(__FUNCTION__);
-    return SQL_ERROR;
+
+    return CALL_WITH_TYPED_HANDLE(SQL_HANDLE_STMT, StatementHandle, [&](Statement & statement) {
+        if (Operation != SQL_ADD)
+            throw SqlException("Optional feature not implemented", "HYC00");
+
+        statement.insertBoundRows();
+        return SQL_SUCCESS;
+    });
 }
 
 SQLRETURN SQL_API EXPORTED_FUNCTION(SQLCancelHandle)(SQLSMALLINT HandleType, SQLHANDLE Handle) {
     LOG(__FUNCTION__);
-    return SQL_ERROR;
+
+    switch (HandleType) {
+        case SQL_HANDLE_STMT:
+            return impl::Cancel(Handle);
+
+        case SQL_HANDLE_DBC: {
+            // No function is ever executed asynchronously on a connection, so there is nothing to cancel.
+            auto func = [&] (Connection & connection) {
+                return SQL_SUCCESS;
+            };
+
+            return CALL_WITH_TYPED_HANDLE(SQL_HANDLE_DBC, Handle, func);
+        }
+    }
+
+    return SQL_INVALID_HANDLE;
 }
 
 SQLRETURN SQL_API EXPORTED_FUNCTION(SQLCompleteAsync)(SQLSMALLINT HandleType, SQLHANDLE Handle, RETCODE * AsyncRetCodePtr) {
     LOG(__FUNCTION__);
-    return SQL_ERROR;
+
+    switch (HandleType) {
+        case SQL_HANDLE_STMT: {
+            if (!AsyncRetCodePtr)
+                return SQL_ERROR;
+
+            // The diagnostics of the completed function are reported as usual, while SQLCompleteAsync() itself succeeds.
+            auto func = [&] (Statement & statement) -> SQLRETURN {
+                if (!statement.isExecutingAsync())
+                    return SQL_NO_DATA;
+
+                *AsyncRetCodePtr = CALL_WITH_TYPED_HANDLE_ASYNC_CAPABLE(SQL_HANDLE_STMT, Handle, [&] (Statement & statement) {
+                    return statement.completeAsyncExecution(true);
+                });
+
+                return SQL_SUCCESS;
+            };
+
+            return CALL_WITH_TYPED_HANDLE_SKIP_DIAG(SQL_HANDLE_STMT, Handle, func);
+        }
+
+        case SQL_HANDLE_DBC: {
+            // No function is ever executed asynchronously on a connection.
+            auto func = [&] (Connection & connection) {
+                return SQL_NO_DATA;
+            };
+
+            return CALL_WITH_TYPED_HANDLE_SKIP_DIAG(SQL_HANDLE_DBC, Handle, func);
+        }
+    }
+
+    return SQL_INVALID_HANDLE;
 }
 
 SQLRETURN SQL_API EXPORTED_FUNCTION(SQLEndTran)(
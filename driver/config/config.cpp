@@ -252,7 +252,12 @@ key_value_map_t readDSNInfo(const std::string & dsn_utf8) {
             INI_STRINGMAXLENGTH,
             INI_DRIVERLOG,
             INI_DRIVERLOGFILE,
-            INI_AUTO_SESSION_ID
+            INI_AUTO_SESSION_ID,
+            INI_COMPRESSION,
+            INI_REQUEST_COMPRESSION,
+            INI_BACKGROUND_FETCH,
+            INI_READ_BUFFER_SIZE,
+            INI_SESSION_POOLING
         }
     ) {
         if (
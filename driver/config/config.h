@@ -33,6 +33,11 @@ struct ConnInfo {
     std::string driverlog;
     std::string driverlogfile;
     std::string auto_session_id;
+    std::string compression;
+    std::string request_compression;
+    std::string background_fetch;
+    std::string read_buffer_size;
+    std::string session_pooling;
 };
 
 key_value_map_t readDSNInfo(const std::string & dsn);
@@ -32,6 +32,11 @@
 #define INI_DRIVERLOG       "DriverLog"
 #define INI_DRIVERLOGFILE   "DriverLogFile"
 #define INI_AUTO_SESSION_ID "AutoSessionId"
+#define INI_COMPRESSION     "Compression"     /* Compression method of the data received from the server */
+#define INI_REQUEST_COMPRESSION "RequestCompression" /* Compression method of the data sent to the server */
+#define INI_BACKGROUND_FETCH "BackgroundFetch" /* Number of row blocks decoded ahead in a background thread */
+#define INI_READ_BUFFER_SIZE "ReadBufferSize" /* Min number of bytes read from the response at once */
+#define INI_SESSION_POOLING "SessionPooling" /* Keep HTTP sessions of disconnected connections for reuse by new ones */
 
 #if defined(UNICODE)
 #   define INI_DSN_DEFAULT          DSN_DEFAULT_UNICODE
@@ -52,6 +57,11 @@
 #define INI_HUGE_INT_AS_STRING_DEFAULT "off"
 #define INI_STRINGMAXLENGTH_DEFAULT "1048575"
 #define INI_AUTO_SESSION_ID_DEFAULT "off"
+#define INI_COMPRESSION_DEFAULT     "off"
+#define INI_REQUEST_COMPRESSION_DEFAULT "off"
+#define INI_BACKGROUND_FETCH_DEFAULT "0"
+#define INI_READ_BUFFER_SIZE_DEFAULT "8192"
+#define INI_SESSION_POOLING_DEFAULT "off"
 
 #ifdef NDEBUG
 #    define INI_DRIVERLOG_DEFAULT "off"
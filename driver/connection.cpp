@@ -1,4 +1,5 @@
 #include "driver/utils/utils.h"
+#include "driver/utils/session_pool.h"
 #include "driver/config/ini_defines.h"
 #include "driver/connection.h"
 #include "driver/descriptor.h"
@@ -6,8 +7,13 @@
 
 #include <Poco/Base64Encoder.h>
 #include <Poco/Net/HTTPClientSession.h>
+#include <Poco/Net/HTTPRequest.h>
+#include <Poco/Net/HTTPResponse.h>
 #include <Poco/NumberParser.h> // TODO: switch to std
 #include <Poco/URI.h>
+
+#include <algorithm>
+#include <limits>
 #include <random>
 
 #if !defined(WORKAROUND_DISABLE_SSL)
@@ -48,6 +54,28 @@ void SSLInit(bool ssl_strict, const std::string & privateKeyFile, const std::str
 }
 #endif
 
+// Parses the value of a compression DSN attribute into a Content-Encoding/Accept-Encoding HTTP header value (empty if no compression).
+bool tryParseCompressionMethod(const std::string & value, std::string & method) {
+    if (value.empty() || (isYesOrNo(value) && !isYes(value))) {
+        method.clear();
+        return true;
+    }
+
+    if (isYes(value)) {
+        method = "gzip";
+        return true;
+    }
+
+    for (const auto & known_method : {"gzip", "deflate", "lz4"}) {
+        if (Poco::UTF8::icompare(value, known_method) == 0) {
+            method = known_method;
+            return true;
+        }
+    }
+
+    return false;
+}
+
 std::string GenerateSessionId() {
     std::mt19937 generator(std::random_device{}());
     std::uniform_int_distribution<std::uint64_t> distribution(0);
@@ -67,7 +95,15 @@ const TypeInfo & Connection::getTypeInfo(const std::string & type_name, const st
 
     const auto tmp_type_without_parameters_id = convertUnparametrizedTypeNameToTypeId(tmp_type_name_without_parameters);
 
-    if (huge_int_as_string && tmp_type_without_parameters_id == DataSourceTypeId::UInt64) {
+    if (
+        huge_int_as_string && (
+            tmp_type_without_parameters_id == DataSourceTypeId::UInt64 ||
+            tmp_type_without_parameters_id == DataSourceTypeId::Int128 ||
+            tmp_type_without_parameters_id == DataSourceTypeId::UInt128 ||
+            tmp_type_without_parameters_id == DataSourceTypeId::Int256 ||
+            tmp_type_without_parameters_id == DataSourceTypeId::UInt256
+        )
+    ) {
         tmp_type_name = "String";
         tmp_type_name_without_parameters = "String";
     }
@@ -93,6 +129,7 @@ Poco::URI Connection::getUri() const {
     bool database_set = false;
     bool default_format_set = false;
     bool session_id_set = false;
+    bool enable_http_compression_set = false;
 
     for (const auto& parameter : uri.getQueryParameters()) {
         if (Poco::UTF8::icompare(parameter.first, "default_format") == 0) {
@@ -104,6 +141,9 @@ Poco::URI Connection::getUri() const {
         else if (Poco::UTF8::icompare(parameter.first, "session_id") == 0 && !parameter.second.empty()) {
             session_id_set = true;
         }
+        else if (Poco::UTF8::icompare(parameter.first, "enable_http_compression") == 0) {
+            enable_http_compression_set = true;
+        }
     }
 
     if (!default_format_set)
@@ -118,11 +158,14 @@ Poco::URI Connection::getUri() const {
         uri.addQueryParameter("session_id", session_id);
     }
 
+    if (!compression.empty() && !enable_http_compression_set)
+        uri.addQueryParameter("enable_http_compression", "1");
+
     return uri;
 }
 
 void Connection::connect(const std::string & connection_string) {
-    if (session && session->connected())
+    if (connected)
         throw SqlException("Connection name in use", "08002");
 
     auto cs_fields = readConnectionString(connection_string);
@@ -178,6 +221,28 @@ void Connection::connect(const std::string & connection_string) {
     resetConfiguration();
     setConfiguration(cs_fields, dsn_fields);
 
+    connected = true;
+
+    if (verify_connection_early) {
+        try {
+            verifyConnection();
+        }
+        catch (...) {
+            disconnect();
+            throw;
+        }
+    }
+}
+
+bool Connection::isConnected() const noexcept {
+    return connected;
+}
+
+std::shared_ptr<std::recursive_mutex> Connection::getCallMutex() const noexcept {
+    return call_mutex;
+}
+
+std::unique_ptr<Poco::Net::HTTPClientSession> Connection::createSession() {
     LOG("Creating session with " << proto << "://" << server << ":" << port);
 
 #if !defined(WORKAROUND_DISABLE_SSL)
@@ -188,22 +253,168 @@ void Connection::connect(const std::string & connection_string) {
     }
 #endif
 
-    session = (
+    std::unique_ptr<Poco::Net::HTTPClientSession> new_session = (
 #if !defined(WORKAROUND_DISABLE_SSL)
         is_ssl ? std::make_unique<Poco::Net::HTTPSClientSession>() :
 #endif
         std::make_unique<Poco::Net::HTTPClientSession>()
     );
 
-    session->setHost(server);
-    session->setPort(port);
-    session->setKeepAlive(true);
-    session->setTimeout(Poco::Timespan(connection_timeout, 0), Poco::Timespan(timeout, 0), Poco::Timespan(timeout, 0));
-    session->setKeepAliveTimeout(Poco::Timespan(86400, 0));
+    new_session->setHost(server);
+    new_session->setPort(port);
+    new_session->setKeepAlive(true);
+    setSessionTimeouts(*new_session);
+    new_session->setKeepAliveTimeout(Poco::Timespan(86400, 0));
 
-    if (verify_connection_early) {
-        verifyConnection();
+    return new_session;
+}
+
+std::unique_ptr<Poco::Net::HTTPClientSession> Connection::borrowSession() {
+    if (isSessionPoolingEnabled()) {
+        if (auto pooled_session = SessionPool::getInstance().take(getSessionPoolKey())) {
+            LOG("Reusing pooled session with " << proto << "://" << server << ":" << port);
+            setSessionTimeouts(*pooled_session);
+            return pooled_session;
+        }
     }
+
+    return createSession();
+}
+
+void Connection::returnSession(std::unique_ptr<Poco::Net::HTTPClientSession> && returned_session) {
+    if (!returned_session)
+        return;
+
+    if (isSessionPoolingEnabled() && isSessionReusable(*returned_session))
+        SessionPool::getInstance().put(getSessionPoolKey(), std::move(returned_session));
+    else
+        returned_session->reset();
+
+    returned_session.reset();
+}
+
+std::unique_ptr<Poco::Net::HTTPClientSession> Connection::leaseSession(const Statement & requester) {
+    if (!connected)
+        throw SqlException("Connection does not exist", "08003");
+
+    if (hasNamedSession()) {
+        for (auto & [handle, statement] : statements) {
+            if (statement.get() != &requester && statement->isQueryInFlight()) {
+                LOG("Closing the cursor of statement " << handle << ", since only one query at a time may run within the session");
+                statement->closeCursor();
+            }
+        }
+    }
+
+    if (!idle_sessions.empty()) {
+        auto leased_session = std::move(idle_sessions.back());
+        idle_sessions.pop_back();
+
+        // The timeouts may have been changed since the session was created.
+        setSessionTimeouts(*leased_session);
+        return leased_session;
+    }
+
+    return borrowSession();
+}
+
+void Connection::releaseSession(std::unique_ptr<Poco::Net::HTTPClientSession> && released_session) {
+    if (!released_session)
+        return;
+
+    if (connected && isSessionReusable(*released_session))
+        idle_sessions.emplace_back(std::move(released_session));
+    else
+        returnSession(std::move(released_session));
+}
+
+void Connection::disconnect() {
+    // The statements release their sessions, once their cursors are closed.
+    for (auto & [handle, statement] : statements) {
+        statement->closeCursor();
+    }
+
+    connected = false;
+
+    for (auto & idle_session : idle_sessions) {
+        returnSession(std::move(idle_session));
+    }
+
+    idle_sessions.clear();
+}
+
+void Connection::killQuery(const std::string & query_id) {
+    // Only the config of the connection is used here, which can't be changed while any statement is being executed,
+    // and the sessions are taken directly from the pool, which is thread-safe, bypassing the idle sessions of the connection.
+    try {
+        auto uri = getUri();
+
+        // The server rejects concurrent queries within the same named session, and the query to kill is still running in it.
+        auto query_parameters = uri.getQueryParameters();
+        query_parameters.erase(
+            std::remove_if(query_parameters.begin(), query_parameters.end(), [] (const auto & parameter) {
+                return (Poco::UTF8::icompare(parameter.first, "session_id") == 0);
+            }),
+            query_parameters.end()
+        );
+        uri.setQueryParameters(query_parameters);
+
+        Poco::Net::HTTPRequest request(Poco::Net::HTTPRequest::HTTP_POST, uri.getPathEtc(), Poco::Net::HTTPRequest::HTTP_1_1);
+        request.setKeepAlive(true);
+        request.setChunkedTransferEncoding(true);
+        request.setCredentials("Basic", buildCredentialsString());
+        request.setHost(uri.getHost());
+        request.set("User-Agent", buildUserAgentString());
+
+        const auto kill_query = "KILL QUERY WHERE query_id = '" + query_id + "' ASYNC FORMAT Null";
+        LOG(request.getMethod() << " " << request.getHost() << request.getURI() << " body=" << kill_query);
+
+        auto kill_session = borrowSession();
+        kill_session->sendRequest(request) << kill_query;
+
+        Poco::Net::HTTPResponse response;
+        auto & response_stream = kill_session->receiveResponse(response);
+        response_stream.ignore(std::numeric_limits<std::streamsize>::max());
+
+        if (response.getStatus() != Poco::Net::HTTPResponse::HTTP_OK) {
+            LOG("Failed to kill query " << query_id << ": HTTP status code: " << response.getStatus());
+            return;
+        }
+
+        if (response_stream.eof() && !response_stream.bad())
+            returnSession(std::move(kill_session));
+    }
+    catch (const Poco::Exception & ex) {
+        LOG("Failed to kill query " << query_id << ": " << ex.displayText());
+    }
+    catch (const std::exception & ex) {
+        LOG("Failed to kill query " << query_id << ": " << ex.what());
+    }
+}
+
+bool Connection::hasNamedSession() const {
+    const auto query_parameters = getUri().getQueryParameters();
+    return std::any_of(query_parameters.begin(), query_parameters.end(), [] (const auto & parameter) {
+        return (Poco::UTF8::icompare(parameter.first, "session_id") == 0 && !parameter.second.empty());
+    });
+}
+
+bool Connection::isSessionReusable(const Poco::Net::HTTPClientSession & target_session) const {
+    // A session that has followed a redirect points to some other server now.
+    return (target_session.connected() && target_session.getHost() == server && target_session.getPort() == port);
+}
+
+bool Connection::isSessionPoolingEnabled() const {
+    // Driver managers usually pool the connections themselves, and don't pass the attribute to the driver, so it is not the only switch.
+    return (session_pooling || getParent().connection_pooling != SQL_CP_OFF);
+}
+
+std::string Connection::getSessionPoolKey() const {
+    return SessionPool::makeKey(proto, server, port, sslmode, privateKeyFile, certificateFile, caLocation);
+}
+
+void Connection::setSessionTimeouts(Poco::Net::HTTPClientSession & target_session) const {
+    target_session.setTimeout(Poco::Timespan(connection_timeout, 0), Poco::Timespan(timeout, 0), Poco::Timespan(timeout, 0));
 }
 
 void Connection::resetConfiguration() {
@@ -224,6 +435,11 @@ void Connection::resetConfiguration() {
     default_format.clear();
     database.clear();
     stringmaxlength = 0;
+    compression.clear();
+    request_compression.clear();
+    background_fetch = 0;
+    read_buffer_size = 0;
+    session_pooling = false;
 }
 
 void Connection::setConfiguration(const key_value_map_t & cs_fields, const key_value_map_t & dsn_fields) {
@@ -404,6 +620,40 @@ void Connection::setConfiguration(const key_value_map_t & cs_fields, const key_v
                 auto_session_id = isYes(value);
             }
         }
+        else if (Poco::UTF8::icompare(key, INI_COMPRESSION) == 0) {
+            recognized_key = true;
+            valid_value = tryParseCompressionMethod(value, compression);
+        }
+        else if (Poco::UTF8::icompare(key, INI_REQUEST_COMPRESSION) == 0) {
+            recognized_key = true;
+            valid_value = tryParseCompressionMethod(value, request_compression);
+        }
+        else if (Poco::UTF8::icompare(key, INI_BACKGROUND_FETCH) == 0) {
+            recognized_key = true;
+            unsigned int typed_value = 0;
+            valid_value = (value.empty() || Poco::NumberParser::tryParseUnsigned(value, typed_value));
+            if (valid_value) {
+                background_fetch = typed_value;
+            }
+        }
+        else if (Poco::UTF8::icompare(key, INI_READ_BUFFER_SIZE) == 0) {
+            recognized_key = true;
+            unsigned int typed_value = 0;
+            valid_value = (value.empty() || (
+                Poco::NumberParser::tryParseUnsigned(value, typed_value) &&
+                typed_value > 0
+            ));
+            if (valid_value) {
+                read_buffer_size = typed_value;
+            }
+        }
+        else if (Poco::UTF8::icompare(key, INI_SESSION_POOLING) == 0) {
+            recognized_key = true;
+            valid_value = (value.empty() || isYesOrNo(value));
+            if (valid_value) {
+                session_pooling = isYes(value);
+            }
+        }
 
         return std::make_tuple(recognized_key, valid_value);
     };
@@ -536,6 +786,9 @@ void Connection::setConfiguration(const key_value_map_t & cs_fields, const key_v
 
     if (stringmaxlength == 0)
         stringmaxlength = TypeInfo::string_max_size;
+
+    if (read_buffer_size == 0)
+        read_buffer_size = AmortizedIStreamReader::default_min_read_size;
 }
 
 void Connection::verifyConnection() {
@@ -670,5 +923,16 @@ Statement& Connection::allocateChild<Statement>() {
 
 template <>
 void Connection::deallocateChild<Statement>(SQLHANDLE handle) noexcept {
-    statements.erase(handle);
+    const auto it = statements.find(handle);
+    if (it == statements.end())
+        return;
+
+    // Let the statement release its session, so that it can be reused by the others.
+    try {
+        it->second->closeCursor();
+    }
+    catch (...) {
+    }
+
+    statements.erase(it);
 }
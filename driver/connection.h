@@ -3,16 +3,19 @@
 #include "driver/driver.h"
 #include "driver/environment.h"
 #include "driver/config/config.h"
+#include "driver/utils/lru_cache.h"
 
 #include <Poco/Net/HTTPClientSession.h>
 #include <Poco/URI.h>
 
 #include <memory>
 #include <mutex>
+#include <vector>
 
 class DescriptorRecord;
 class Descriptor;
 class Statement;
+struct QueryTemplate;
 
 class Connection
     : public Child<Environment, Connection>
@@ -42,14 +45,22 @@ public: // Configuration fields.
     bool huge_int_as_string = false;
     std::int32_t stringmaxlength = 0;
     bool auto_session_id = false;
+    std::string compression; // Empty if the data is requested uncompressed, otherwise the value for Accept-Encoding HTTP header.
+    std::string request_compression; // Empty if the queries are sent uncompressed, otherwise the value for Content-Encoding HTTP header.
+    std::uint32_t background_fetch = 0; // Max number of row blocks decoded ahead in a background thread, 0 means rows are decoded while being fetched.
+    std::uint32_t read_buffer_size = 0;
+    bool session_pooling = false; // Also enabled by SQL_ATTR_CONNECTION_POOLING environment attribute, see isSessionPoolingEnabled().
 
 public:
     std::string useragent;
 
-    std::unique_ptr<Poco::Net::HTTPClientSession> session;
     int retry_count = 3;
     int redirect_limit = 10;
 
+    // Parsed queries, keyed by their original text, so that the statements that prepare the same text don't parse it again.
+    // Bounded by the size of the texts too, since generated queries may be huge. A text bigger than the whole budget is never cached.
+    LRUCache<std::string, std::shared_ptr<const QueryTemplate>> query_templates{256, 4 * 1024 * 1024};
+
 public:
     explicit Connection(Environment & environment);
 
@@ -60,6 +71,37 @@ public:
 
     void connect(const std::string & connection_string);
 
+    // Calls on the connection, and on all its statements and descriptors, are serialized by this mutex.
+    std::shared_ptr<std::recursive_mutex> getCallMutex() const noexcept;
+
+    // Whether the connection has been established by connect(), and not closed by disconnect() since.
+    bool isConnected() const noexcept;
+
+    // Create a new HTTP session to the server, configured the same way as all the others.
+    std::unique_ptr<Poco::Net::HTTPClientSession> createSession();
+
+    // Take an idle session to the server from the process-wide pool, if pooling is enabled, or create a new one.
+    std::unique_ptr<Poco::Net::HTTPClientSession> borrowSession();
+
+    // Give the session back to the pool, for reuse by this or any other connection. It is simply closed, if pooling is disabled.
+    void returnSession(std::unique_ptr<Poco::Net::HTTPClientSession> && returned_session);
+
+    // Lease a session to a statement, that is about to send a request: an idle session of this connection, if any, or a borrowed one.
+    // Each statement with a request in flight, or a response to read, holds a session of its own, so their responses don't interfere.
+    // The server runs only one query at a time within a named session (session_id), so in that case the cursors of the other statements,
+    // whose queries are still in flight, are closed first, the same way their responses were dropped, when all of them shared one session.
+    std::unique_ptr<Poco::Net::HTTPClientSession> leaseSession(const Statement & requester);
+
+    // Take back the session leased by a statement, and keep it idle for the next request, if it can be reused.
+    void releaseSession(std::unique_ptr<Poco::Net::HTTPClientSession> && released_session);
+
+    // Close the cursors of all the statements, and return all the sessions of the connection to the pool.
+    void disconnect();
+
+    // Ask the server to stop executing the query, by a KILL QUERY request sent through a separate session.
+    // Safe to call while another thread is blocked in a call on this connection. Failures are only logged, since it is a best effort anyway.
+    void killQuery(const std::string & query_id);
+
     // Return a Base64 encoded string of "user:password".
     std::string buildCredentialsString() const;
 
@@ -97,7 +139,16 @@ private:
     // Verify the connection and credentials by trying to remotely execute a simple "SELECT 1" query.
     void verifyConnection();
 
+    bool isSessionReusable(const Poco::Net::HTTPClientSession & target_session) const;
+    bool hasNamedSession() const;
+    bool isSessionPoolingEnabled() const;
+    std::string getSessionPoolKey() const;
+    void setSessionTimeouts(Poco::Net::HTTPClientSession & target_session) const;
+
 private:
+    const std::shared_ptr<std::recursive_mutex> call_mutex = std::make_shared<std::recursive_mutex>();
+    bool connected = false;
+    std::vector<std::unique_ptr<Poco::Net::HTTPClientSession>> idle_sessions; // Not leased to any statement at the moment.
     std::unordered_map<SQLHANDLE, std::shared_ptr<Descriptor>> descriptors;
     std::unordered_map<SQLHANDLE, std::shared_ptr<Statement>> statements;
 };
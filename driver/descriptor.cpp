@@ -1,8 +1,21 @@
 #include "driver/descriptor.h"
 
 #include <algorithm>
+#include <atomic>
+
+namespace {
+
+std::uint64_t nextDescriptorVersion() {
+    static std::atomic<std::uint64_t> last_version{0};
+    return ++last_version;
+}
+
+} // namespace
 
 void DescriptorRecord::onAttrChange(int attr) {
+    if (owner)
+        owner->touch();
+
     switch (attr) {
         case SQL_DESC_TYPE: {
             const auto type = getAttrAs<SQLSMALLINT>(SQL_DESC_TYPE);
@@ -159,6 +172,7 @@ void DescriptorRecord::consistencyCheck() {
 
 Descriptor::Descriptor(Connection & connection)
     : ChildType(connection)
+    , version(nextDescriptorVersion())
 {
     setAttr(SQL_DESC_COUNT, 0);
 }
@@ -173,6 +187,11 @@ Descriptor & Descriptor::operator= (Descriptor & other) {
 
         attrs = other_attrs;
         records = other.records;
+        touch();
+
+        for (auto & record : records) {
+            record.owner = this;
+        }
 
         if (alloc_type_set)
             setAttr(SQL_DESC_ALLOC_TYPE, alloc_type);
@@ -196,7 +215,7 @@ DescriptorRecord & Descriptor::getRecord(std::size_t num, SQLINTEGER current_rol
     if (records.empty()) {
         // Initialize at least 0th BOOKMARK record
         records.reserve(10);
-        records.emplace_back();
+        records.emplace_back().owner = this;
         getParent().initAsDescRec(records[0], current_role);
     }
 
@@ -212,7 +231,7 @@ DescriptorRecord & Descriptor::getRecord(std::size_t num, SQLINTEGER current_rol
     }
 
     while (records.size() <= std::max(curr_rec_count, num)) {
-        records.emplace_back();
+        records.emplace_back().owner = this;
         getParent().initAsDescRec(records.back(), current_role);
     }
 
@@ -226,3 +245,15 @@ DescriptorRecord & Descriptor::getRecord(std::size_t num, SQLINTEGER current_rol
 const std::vector<DescriptorRecord> & Descriptor::getRecordContainer() const {
     return records;
 }
+
+std::uint64_t Descriptor::getVersion() const {
+    return version;
+}
+
+void Descriptor::onAttrChange(int attr) {
+    touch();
+}
+
+void Descriptor::touch() {
+    version = nextDescriptorVersion();
+}
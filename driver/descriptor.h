@@ -6,6 +6,10 @@
 
 #include <unordered_map>
 
+#include <cstdint>
+
+class Descriptor;
+
 class DescriptorRecord
     : public AttributeContainer
 {
@@ -20,6 +24,11 @@ public:
 
 protected:
     virtual void onAttrChange(int attr) final override;
+
+private:
+    friend class Descriptor;
+
+    Descriptor * owner = nullptr; // The descriptor that is notified about the changes of the record, if any.
 };
 
 class Descriptor
@@ -37,6 +46,19 @@ public:
 
     const std::vector<DescriptorRecord> & getRecordContainer() const;
 
+    // Changes every time an attribute of the descriptor, or of any of its records, changes.
+    // Versions are unique across all descriptors, so that a (descriptor, version) pair can be used as a key of the state derived from it.
+    std::uint64_t getVersion() const;
+
+protected:
+    virtual void onAttrChange(int attr) final override;
+
+private:
+    friend class DescriptorRecord;
+
+    void touch();
+
 private:
     std::vector<DescriptorRecord> records;
+    std::uint64_t version = 0;
 };
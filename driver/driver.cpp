@@ -35,19 +35,32 @@ Environment & Driver::allocateChild<Environment>() {
     auto child_sptr = std::make_shared<Environment>(*this);
     auto & child = *child_sptr;
     auto handle = child.getHandle();
+    std::scoped_lock lock(environments_mutex);
     environments.emplace(handle, std::move(child_sptr));
     return child;
 }
 
 template <>
 void Driver::deallocateChild<Environment>(SQLHANDLE handle) noexcept {
-    environments.erase(handle);
+    std::shared_ptr<Environment> child_sptr;
+
+    {
+        std::scoped_lock lock(environments_mutex);
+        const auto it = environments.find(handle);
+        if (it != environments.end()) {
+            child_sptr = std::move(it->second);
+            environments.erase(it);
+        }
+    }
+
+    // The environment is destroyed, along with all its connections, outside of the lock.
 }
 
 void Driver::onAttrChange(int attr) {
     switch (attr) {
         case CH_SQL_ATTR_DRIVERLOG:
         case CH_SQL_ATTR_DRIVERLOGFILE: {
+            std::scoped_lock lock(log_mutex);
             bool stream_open = (log_file_stream.is_open() && log_file_stream);
             const bool enable_logging = isLoggingEnabled();
             const auto log_file_attr = getAttrAs<std::string>(CH_SQL_ATTR_DRIVERLOGFILE);
@@ -83,6 +96,10 @@ bool Driver::isLoggingEnabled() const {
     return (getAttrAs<SQLUINTEGER>(CH_SQL_ATTR_DRIVERLOG) == SQL_OPT_TRACE_ON);
 }
 
+std::recursive_mutex & Driver::getLogMutex() const noexcept {
+    return log_mutex;
+}
+
 std::ostream & Driver::getLogStream() {
     return (log_file_stream ? log_file_stream : std::clog);
 }
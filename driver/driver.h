@@ -2,6 +2,7 @@
 
 #include "driver/platform/platform.h"
 #include "driver/utils/utils.h"
+#include "driver/utils/sharded_map.h"
 #include "driver/attributes.h"
 #include "driver/diagnostics.h"
 #include "driver/object.h"
@@ -12,6 +13,8 @@
 #include <functional>
 #include <iostream>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <sstream>
 #include <string>
 #include <type_traits>
@@ -26,6 +29,7 @@
         try { \
             auto & context_ = context; \
             if (context_.isLoggingEnabled()) { \
+                std::scoped_lock log_lock_(context_.getDriver().getLogMutex()); \
                 auto & stream_ = context_.getLogStream(); \
                 context_.writeLogMessagePrefix(stream_); \
                 stream_ << " " << file << ":" << line; \
@@ -51,6 +55,14 @@
 #define CALL_WITH_TYPED_HANDLE(handle_type, handle, callable)           (Driver::getInstance().call(callable, handle, handle_type))
 #define CALL_WITH_TYPED_HANDLE_SKIP_DIAG(handle_type, handle, callable) (Driver::getInstance().call(callable, handle, handle_type, true))
 
+// The callable is not serialized with the other calls on the connection, so it may run while another thread is blocked in one of them,
+// e.g., SQLCancel(), and must take care of its own thread-safety. Diagnostics are not touched, since they may be in use by that thread.
+#define CALL_WITH_TYPED_HANDLE_UNSERIALIZED(handle_type, handle, callable) (Driver::getInstance().call(callable, handle, handle_type, true, false))
+
+// The callable may run while a function is being executed asynchronously on the statement, i.e., it starts, polls, completes, or cancels it.
+// Any other call on such statement fails with HY010, except the ones that skip diagnostics, e.g., SQLGetDiagRec(), or SQLFreeHandle().
+#define CALL_WITH_TYPED_HANDLE_ASYNC_CAPABLE(handle_type, handle, callable) (Driver::getInstance().call(callable, handle, handle_type, false, true, true))
+
 class Environment;
 class Connection;
 class Descriptor;
@@ -83,6 +95,7 @@ public:
     template <typename T> void unregisterDescendant(T & descendant) noexcept;
 
     bool isLoggingEnabled() const;
+    std::recursive_mutex & getLogMutex() const noexcept; // Must be held while writing to the log stream.
     std::ostream & getLogStream();
     void writeLogMessagePrefix(std::ostream & stream);
 
@@ -170,11 +183,12 @@ private:
 
 public:
     template <typename Callable>
-    inline SQLRETURN call(Callable && callable, SQLHANDLE handle = nullptr, SQLSMALLINT handle_type = 0, bool skip_diag = false) const noexcept;
+    inline SQLRETURN call(Callable && callable, SQLHANDLE handle = nullptr, SQLSMALLINT handle_type = 0, bool skip_diag = false, bool serialize = true, bool async_capable = false) const noexcept;
 
 private:
     std::string log_file_name;
     std::ofstream log_file_stream;
+    mutable std::recursive_mutex log_mutex;
 
     using DescendantVariantType = std::variant<
         std::reference_wrapper<Statement>,
@@ -183,7 +197,10 @@ private:
         std::reference_wrapper<Environment>
     >;
 
-    std::unordered_map<SQLHANDLE, DescendantVariantType> descendants;
+    // Resolves the handles of all the objects, may be accessed concurrently by any number of threads.
+    ShardedMap<SQLHANDLE, DescendantVariantType> descendants;
+
+    std::mutex environments_mutex;
     std::unordered_map<SQLHANDLE, std::shared_ptr<Environment>> environments;
 };
 
@@ -192,8 +209,7 @@ template <> void Driver::deallocateChild<Environment>(SQLHANDLE handle) noexcept
 
 template <typename T>
 void Driver::registerDescendant(T & descendant) {
-    descendants.erase(descendant.getHandle());
-    descendants.emplace(descendant.getHandle(), std::ref(descendant));
+    descendants.set(descendant.getHandle(), std::ref(descendant));
 }
 
 template <typename T>
@@ -201,8 +217,36 @@ void Driver::unregisterDescendant(T & descendant) noexcept {
     descendants.erase(descendant.getHandle());
 }
 
+// Notifies the object about a serialized call on it, for as long as the call lasts, unless the call deallocates the object.
+template <typename ObjectType>
+class CallScope {
+public:
+    CallScope(ObjectType & object, bool async_capable)
+        : object_ptr(&object)
+        , object_ref(object.weak_from_this())
+        , is_owned(!object_ref.expired()) // Objects, that are not owned by their parents, e.g. in the unit tests, are never deallocated by a call.
+    {
+        object.onCallEnter(async_capable);
+    }
+
+    ~CallScope() {
+        if (!is_owned)
+            object_ptr->onCallLeave();
+        else if (auto object = object_ref.lock())
+            object->onCallLeave();
+    }
+
+    CallScope(const CallScope &) = delete;
+    CallScope & operator= (const CallScope &) = delete;
+
+private:
+    ObjectType * const object_ptr;
+    const std::weak_ptr<ObjectType> object_ref;
+    const bool is_owned;
+};
+
 template <typename Callable>
-inline SQLRETURN Driver::call(Callable && callable, SQLHANDLE handle, SQLSMALLINT handle_type, bool skip_diag) const noexcept {
+inline SQLRETURN Driver::call(Callable && callable, SQLHANDLE handle, SQLSMALLINT handle_type, bool skip_diag, bool serialize, bool async_capable) const noexcept {
     try {
         if (handle == nullptr) {
             if (handle_type == 0) {
@@ -231,7 +275,19 @@ inline SQLRETURN Driver::call(Callable && callable, SQLHANDLE handle, SQLSMALLIN
             const auto func = [&] (auto & descendant_ref) noexcept -> SQLRETURN {
                 auto & descendant = descendant_ref.get();
 
+                // Calls on the same connection, or any of its statements and descriptors, are serialized.
+                // The mutex is shared, and outlives the object, since the call may deallocate it.
+                const auto call_mutex = descendant.getCallMutex();
+                std::unique_lock<std::recursive_mutex> lock;
+
                 try {
+                    std::optional<CallScope<std::decay_t<decltype(descendant)>>> call_scope;
+
+                    if (serialize) {
+                        lock = std::unique_lock(*call_mutex);
+                        call_scope.emplace(descendant, async_capable || skip_diag);
+                    }
+
                     return doCall(callable, descendant, skip_diag);
                 }
                 catch (const SqlException & ex) {
@@ -287,33 +343,32 @@ inline SQLRETURN Driver::call(Callable && callable, SQLHANDLE handle, SQLSMALLIN
             }
 #endif
 
-            const auto it = descendants.find(handle);
-            if (it != descendants.end()) {
+            if (auto descendant = descendants.find(handle)) {
                 switch (handle_type) {
                     case 0: {
-                        return std::visit(func, it->second);
+                        return std::visit(func, *descendant);
                     }
 
                     // Shortcut visitation using std::get_if<>() when 'handle_type' is not 0.
                     // This yields slightly better results with the current compilers optimization capabilities.
 
                     case getObjectHandleType<Statement>(): {
-                        if (auto * descendant_ref_ptr = std::get_if<std::reference_wrapper<Statement>>(&it->second))
+                        if (auto * descendant_ref_ptr = std::get_if<std::reference_wrapper<Statement>>(&*descendant))
                             return func(*descendant_ref_ptr);
                         break;
                     }
                     case getObjectHandleType<Descriptor>(): {
-                        if (auto * descendant_ref_ptr = std::get_if<std::reference_wrapper<Descriptor>>(&it->second))
+                        if (auto * descendant_ref_ptr = std::get_if<std::reference_wrapper<Descriptor>>(&*descendant))
                             return func(*descendant_ref_ptr);
                         break;
                     }
                     case getObjectHandleType<Connection>(): {
-                        if (auto * descendant_ref_ptr = std::get_if<std::reference_wrapper<Connection>>(&it->second))
+                        if (auto * descendant_ref_ptr = std::get_if<std::reference_wrapper<Connection>>(&*descendant))
                             return func(*descendant_ref_ptr);
                         break;
                     }
                     case getObjectHandleType<Environment>(): {
-                        if (auto * descendant_ref_ptr = std::get_if<std::reference_wrapper<Environment>>(&it->second))
+                        if (auto * descendant_ref_ptr = std::get_if<std::reference_wrapper<Environment>>(&*descendant))
                             return func(*descendant_ref_ptr);
                         break;
                     }
@@ -42,11 +42,27 @@ Connection& Environment::allocateChild<Connection>() {
     auto child_sptr = std::make_shared<Connection>(*this);
     auto& child = *child_sptr;
     auto handle = child.getHandle();
+    std::scoped_lock lock(connections_mutex);
     connections.emplace(handle, std::move(child_sptr));
     return child;
 }
 
 template <>
 void Environment::deallocateChild<Connection>(SQLHANDLE handle) noexcept {
-    connections.erase(handle);
+    std::shared_ptr<Connection> child_sptr;
+
+    {
+        std::scoped_lock lock(connections_mutex);
+        const auto it = connections.find(handle);
+        if (it != connections.end()) {
+            child_sptr = std::move(it->second);
+            connections.erase(it);
+        }
+    }
+
+    // The connection is destroyed, along with all its statements and descriptors, outside of the lock.
+}
+
+std::shared_ptr<std::recursive_mutex> Environment::getCallMutex() const noexcept {
+    return call_mutex;
 }
@@ -5,6 +5,8 @@
 #include "driver/utils/type_info.h"
 
 #include <map>
+#include <memory>
+#include <mutex>
 #include <stdexcept>
 
 class Environment
@@ -22,6 +24,9 @@ public:
 
     const TypeInfo & getTypeInfo(const std::string & type_name, const std::string & type_name_without_parameters) const;
 
+    // Calls on the environment are serialized by this mutex. Calls on its connections are serialized by their own mutexes.
+    std::shared_ptr<std::recursive_mutex> getCallMutex() const noexcept;
+
 public:
 #if defined(SQL_OV_ODBC3_80)
     int odbc_version = SQL_OV_ODBC3_80;
@@ -29,7 +34,14 @@ public:
     int odbc_version = SQL_OV_ODBC3;
 #endif
 
+    // The HTTP sessions of the connections are pooled by the driver, if this is not SQL_CP_OFF, or SessionPooling is on.
+    SQLUINTEGER connection_pooling = SQL_CP_OFF;
+
 private:
+    const std::shared_ptr<std::recursive_mutex> call_mutex = std::make_shared<std::recursive_mutex>();
+
+    // Connections are deallocated by the calls on themselves, so the map is guarded separately.
+    std::mutex connections_mutex;
     std::unordered_map<SQLHANDLE, std::shared_ptr<Connection>> connections;
 };
 
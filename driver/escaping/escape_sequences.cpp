@@ -8,14 +8,20 @@
 #include "driver/escaping/escape_sequences.h"
 #include "driver/escaping/lexer.h"
 
-#include <iostream>
-#include <map>
+#include <algorithm>
+#include <array>
+#include <string_view>
 
 using namespace std;
 
 namespace {
 
-const std::map<const std::string, const std::string> fn_convert_map {
+struct ConvertFunction {
+    string_view type_name;
+    string_view function;
+};
+
+constexpr ConvertFunction fn_convert_functions[] {
     {"SQL_TINYINT", "toUInt8"},
     {"SQL_SMALLINT", "toUInt16"},
     {"SQL_INTEGER", "toInt32"},
@@ -29,216 +35,254 @@ const std::map<const std::string, const std::string> fn_convert_map {
     {"SQL_TYPE_TIMESTAMP", "toDateTime"},
 };
 
+struct FunctionName {
+    Token::Type token;
+    const char * name;
+};
+
 #define DECLARE2(TOKEN, NAME) \
     { Token::TOKEN, NAME }
 
-const std::map<const Token::Type, const std::string> function_map {
+constexpr FunctionName function_list[] {
 #include "function_declare.h"
 };
 
 #undef DECLARE2
 
-const std::map<const Token::Type, const std::string> function_map_strip_params {
-    {Token::CURRENT_TIMESTAMP, "now()"},
-};
+// Indexed by token type: nullptr, if the token is not a recognized function, and an empty string, if the function needs special handling.
+constexpr auto function_names = [] {
+    array<const char *, Token::RCURLY + 1> names{};
 
-const std::map<const Token::Type, const std::string> literal_map {
-    // {Token::SQL_TSI_FRAC_SECOND, ""},
-    {Token::SQL_TSI_SECOND, "'second'"},
-    {Token::SQL_TSI_MINUTE, "'minute'"},
-    {Token::SQL_TSI_HOUR, "'hour'"},
-    {Token::SQL_TSI_DAY, "'day'"},
-    {Token::SQL_TSI_WEEK, "'week'"},
-    {Token::SQL_TSI_MONTH, "'month'"},
-    {Token::SQL_TSI_QUARTER, "'quarter'"},
-    {Token::SQL_TSI_YEAR, "'year'"},
-};
+    for (const auto & function : function_list) {
+        if (!names[function.token])
+            names[function.token] = function.name;
+    }
 
-const std::map<const Token::Type, const std::string> timeadd_func_map {
-    // {Token::SQL_TSI_FRAC_SECOND, ""},
-    {Token::SQL_TSI_SECOND, "addSeconds"},
-    {Token::SQL_TSI_MINUTE, "addMinutes"},
-    {Token::SQL_TSI_HOUR, "addHours"},
-    {Token::SQL_TSI_DAY, "addDays"},
-    {Token::SQL_TSI_WEEK, "addWeeks"},
-    {Token::SQL_TSI_MONTH, "addMonths"},
-    {Token::SQL_TSI_QUARTER, "addQuarters"},
-    {Token::SQL_TSI_YEAR, "addYears"},
-};
+    return names;
+}();
+
+inline const char * getFunctionName(const Token::Type type) {
+    return function_names[type];
+}
+
+// Functions, whose parameters are ignored.
+const char * getFunctionNameStripParams(const Token::Type type) {
+    switch (type) {
+        case Token::CURRENT_TIMESTAMP: return "now()";
+        default:                       return nullptr;
+    }
+}
+
+const char * getLiteral(const Token::Type type) {
+    switch (type) {
+        // case Token::SQL_TSI_FRAC_SECOND: return "";
+        case Token::SQL_TSI_SECOND:  return "'second'";
+        case Token::SQL_TSI_MINUTE:  return "'minute'";
+        case Token::SQL_TSI_HOUR:    return "'hour'";
+        case Token::SQL_TSI_DAY:     return "'day'";
+        case Token::SQL_TSI_WEEK:    return "'week'";
+        case Token::SQL_TSI_MONTH:   return "'month'";
+        case Token::SQL_TSI_QUARTER: return "'quarter'";
+        case Token::SQL_TSI_YEAR:    return "'year'";
+        default:                     return nullptr;
+    }
+}
+
+const char * getTimeAddFunction(const Token::Type type) {
+    switch (type) {
+        // case Token::SQL_TSI_FRAC_SECOND: return "";
+        case Token::SQL_TSI_SECOND:  return "addSeconds";
+        case Token::SQL_TSI_MINUTE:  return "addMinutes";
+        case Token::SQL_TSI_HOUR:    return "addHours";
+        case Token::SQL_TSI_DAY:     return "addDays";
+        case Token::SQL_TSI_WEEK:    return "addWeeks";
+        case Token::SQL_TSI_MONTH:   return "addMonths";
+        case Token::SQL_TSI_QUARTER: return "addQuarters";
+        case Token::SQL_TSI_YEAR:    return "addYears";
+        default:                     return nullptr;
+    }
+}
+
+// All the process*() functions below append the rewritten text to 'out'. If an escape sequence can't be rewritten,
+// whatever has been appended for it is discarded, and the whole original sequence is appended instead, as is.
 
+inline void append(string & out, const StringView & str) {
+    out.append(str.data(), str.size());
+}
+
+// Discards everything appended after 'mark', and appends the original escape sequence instead.
+inline void rollback(string & out, const size_t mark, const StringView & seq) {
+    out.resize(mark);
+    append(out, seq);
+}
+
+inline void skipSpaces(Lexer & lex) {
+    while (lex.Match(Token::SPACE)) {
+    }
+}
 
-string processEscapeSequencesImpl(const StringView seq, Lexer & lex);
+void processEscapeSequencesImpl(const StringView seq, Lexer & lex, string & out);
 
-string convertFunctionByType(const StringView & typeName) {
-    const auto type_name_string = typeName.to_string();
-    if (fn_convert_map.find(type_name_string) != fn_convert_map.end())
-        return fn_convert_map.at(type_name_string);
+string_view convertFunctionByType(const StringView & typeName) {
+    const string_view type_name(typeName.data(), typeName.size());
 
-    return string();
+    for (const auto & convert_function : fn_convert_functions) {
+        if (convert_function.type_name == type_name)
+            return convert_function.function;
+    }
+
+    return string_view();
 }
 
-string processParentheses(const StringView seq, Lexer & lex) {
-    string result;
+void processParentheses(const StringView seq, Lexer & lex, string & out) {
     lex.SetEmitSpaces(true);
-    result += lex.Consume().literal.to_string(); // (
+    append(out, lex.Consume().literal); // (
 
     while (true) {
         const Token token(lex.Peek());
 
-        // std::cerr << __FILE__ << ":" << __LINE__ << " : "<< token.literal.to_string() << " type=" << token.type << " go\n";
-
         if (token.type == Token::RPARENT) {
-            result += token.literal.to_string();
+            append(out, token.literal);
             lex.Consume();
             break;
         } else if (token.type == Token::LPARENT) {
-            result += processParentheses(seq, lex);
+            processParentheses(seq, lex, out);
         } else if (token.type == Token::LCURLY) {
             lex.SetEmitSpaces(false);
-            result += processEscapeSequencesImpl(seq, lex);
+            processEscapeSequencesImpl(seq, lex, out);
             lex.SetEmitSpaces(true);
         } else if (token.type == Token::EOS || token.type == Token::INVALID) {
             break;
         } else {
-            result += token.literal.to_string();
+            append(out, token.literal);
             lex.Consume();
         }
     }
-
-    return result;
 }
 
-string processIdentOrFunction(const StringView seq, Lexer & lex) {
-    while (lex.Match(Token::SPACE)) {
-    }
+// Returns false, if nothing has been appended.
+bool processIdentOrFunction(const StringView seq, Lexer & lex, string & out) {
+    skipSpaces(lex);
+
     const auto token = lex.Peek();
-    string result;
+    const auto mark = out.size();
 
     if (token.type == Token::LCURLY) {
         lex.SetEmitSpaces(false);
-        result += processEscapeSequencesImpl(seq, lex);
+        processEscapeSequencesImpl(seq, lex, out);
         lex.SetEmitSpaces(true);
     } else if (token.type == Token::LPARENT) {
-        result += processParentheses(seq, lex);
-    } else if (function_map_strip_params.find(token.type) != function_map_strip_params.end()) {
-        result += function_map_strip_params.at(token.type);
+        processParentheses(seq, lex, out);
+    } else if (const auto * name = getFunctionNameStripParams(token.type)) {
+        out += name;
     } else if ( // any of the remaining recognized FUNCTION( ... ), or any IDENT( ... ), including CAST( ... )
-        (token.type == Token::IDENT || function_map.find(token.type) != function_map.end()) &&
+        (token.type == Token::IDENT || getFunctionName(token.type)) &&
         lex.LookAhead(1).type == Token::LPARENT
     ) {
-        result += token.literal.to_string();                                            // func name
+        append(out, token.literal);                                                     // func name
         lex.Consume();
-        result += processParentheses(seq, lex);
+        processParentheses(seq, lex, out);
     } else if (token.type == Token::NUMBER || token.type == Token::IDENT || token.type == Token::STRING || token.type == Token::PARAM) {
-        result += token.literal.to_string();
+        append(out, token.literal);
         lex.Consume();
     } else {
-        return "";
-    }
-    while (lex.Match(Token::SPACE)) {
+        return false;
     }
 
-    return result;
+    skipSpaces(lex);
+
+    return (out.size() > mark);
 }
 
-string processFunction(const StringView seq, Lexer & lex) {
+void processFunction(const StringView seq, Lexer & lex, string & out) {
     const Token fn(lex.Consume());
+    const auto mark = out.size();
 
     if (fn.type == Token::CONVERT) {
-        string result;
         if (!lex.Match(Token::LPARENT))
-            return seq.to_string();
+            return rollback(out, mark, seq);
 
-        auto num = processIdentOrFunction(seq, lex);
-        if (num.empty())
-            return seq.to_string();
-        result += num;
+        if (!processIdentOrFunction(seq, lex, out))
+            return rollback(out, mark, seq);
 
-        while (lex.Match(Token::SPACE)) {
-        }
+        skipSpaces(lex);
 
-        if (!lex.Match(Token::COMMA)) {
-            return seq.to_string();
-        }
+        if (!lex.Match(Token::COMMA))
+            return rollback(out, mark, seq);
 
-        while (lex.Match(Token::SPACE)) {
-        }
+        skipSpaces(lex);
 
         Token type = lex.Consume();
-        if (type.type != Token::IDENT) {
-            return seq.to_string();
-        }
+        if (type.type != Token::IDENT)
+            return rollback(out, mark, seq);
 
-        string func = convertFunctionByType(type.literal.to_string());
+        const auto func = convertFunctionByType(type.literal);
 
         if (!func.empty()) {
-            while (lex.Match(Token::SPACE)) {
-            }
-            if (!lex.Match(Token::RPARENT)) {
-                return seq.to_string();
-            }
-            result = func + "(" + result + ")";
-        }
+            skipSpaces(lex);
 
-        return result;
+            if (!lex.Match(Token::RPARENT))
+                return rollback(out, mark, seq);
+
+            // Wrap the already written value: func(value).
+            out.insert(mark, func);
+            out.insert(mark + func.size(), 1, '(');
+            out += ')';
+        }
 
     } else if (fn.type == Token::TIMESTAMPADD) {
-        string result;
         if (!lex.Match(Token::LPARENT))
-            return seq.to_string();
+            return rollback(out, mark, seq);
+
+        const auto * func = getTimeAddFunction(lex.Consume().type);
+        if (!func)
+            return rollback(out, mark, seq);
 
-        Token type = lex.Consume();
-        if (timeadd_func_map.find(type.type) == timeadd_func_map.end())
-            return seq.to_string();
-        string func = timeadd_func_map.at(type.type);
         if (!lex.Match(Token::COMMA))
-            return seq.to_string();
-        auto ramount = processIdentOrFunction(seq, lex);
-        if (ramount.empty())
-            return seq.to_string();
+            return rollback(out, mark, seq);
 
-        while (lex.Match(Token::SPACE)) {
-        }
+        out += func;
+        out += '(';
+
+        const auto amount_pos = out.size();
+        if (!processIdentOrFunction(seq, lex, out))
+            return rollback(out, mark, seq);
+
+        skipSpaces(lex);
 
         if (!lex.Match(Token::COMMA))
-            return seq.to_string();
+            return rollback(out, mark, seq);
 
+        const auto date_pos = out.size();
+        if (!processIdentOrFunction(seq, lex, out))
+            return rollback(out, mark, seq);
 
-        auto rdate = processIdentOrFunction(seq, lex);
-        if (rdate.empty())
-            return seq.to_string();
+        skipSpaces(lex);
 
-        if (!func.empty()) {
-            while (lex.Match(Token::SPACE)) {
-            }
-            if (!lex.Match(Token::RPARENT)) {
-                return seq.to_string();
-            }
-            result = func + "(" + rdate + ", " + ramount + ")";
-        }
-        return result;
+        if (!lex.Match(Token::RPARENT))
+            return rollback(out, mark, seq);
+
+        // Swap the arguments in place: func(amount date -> func(date, amount).
+        const auto date_size = out.size() - date_pos;
+        rotate(out.begin() + amount_pos, out.begin() + date_pos, out.end());
+        out.insert(amount_pos + date_size, ", ");
+        out += ')';
 
     } else if (fn.type == Token::LOCATE) {
-        string result;
         if (!lex.Match(Token::LPARENT))
-            return seq.to_string();
+            return rollback(out, mark, seq);
 
-        auto needle = processIdentOrFunction(seq, lex /*, false */);
-        if (needle.empty())
-            return seq.to_string();
-        lex.Consume();
+        out += "locate(";
 
-        auto haystack = processIdentOrFunction(seq, lex /*, false*/);
-        if (haystack.empty())
-            return seq.to_string();
+        if (!processIdentOrFunction(seq, lex /*, false */, out)) // needle
+            return rollback(out, mark, seq);
         lex.Consume();
 
-        auto offset = processIdentOrFunction(seq, lex /*, false */);
-        if (offset.empty()) {
-            offset = "1";
-        } else {
-            lex.Consume();
-        }
+        out += ',';
+
+        if (!processIdentOrFunction(seq, lex /*, false*/, out)) // haystack
+            return rollback(out, mark, seq);
+        lex.Consume();
 
         // ClickHouse requires `start_pos` to be an unsigned integer,
         // whereas ODBC clients map it as a signed integer. This results in
@@ -246,51 +290,66 @@ string processFunction(const StringView seq, Lexer & lex) {
         // match the type required by `locate`. To avoid the illegal type argument
         // error, we cast the offset parameter to UInt64. The `accurateCast` function
         // ensures that the parameter value is never negative.
-        result = "locate(" + needle + "," + haystack + ",accurateCast(" + offset + ",'UInt64'))";
+        out += ",accurateCast(";
+
+        const auto offset_pos = out.size();
+        if (processIdentOrFunction(seq, lex /*, false */, out)) {
+            lex.Consume();
+        } else {
+            out.resize(offset_pos);
+            out += '1';
+        }
 
-        return result;
+        out += ",'UInt64'))";
 
     } else if (fn.type == Token::LTRIM) {
         if (!lex.Match(Token::LPARENT))
-            return seq.to_string();
+            return rollback(out, mark, seq);
+
+        out += "replaceRegexpOne(";
 
-        auto param = processIdentOrFunction(seq, lex /*, false*/);
-        if (param.empty())
-            return seq.to_string();
+        if (!processIdentOrFunction(seq, lex /*, false*/, out))
+            return rollback(out, mark, seq);
         lex.Consume();
-        return "replaceRegexpOne(" + param + ", '^\\\\s+', '')";
+
+        out += ", '^\\\\s+', '')";
 
     } else if (fn.type == Token::DAYOFWEEK) {
         if (!lex.Match(Token::LPARENT))
-            return seq.to_string();
+            return rollback(out, mark, seq);
+
+        out += "if(toDayOfWeek(";
 
-        auto param = processIdentOrFunction(seq, lex /*, false*/);
-        if (param.empty())
-            return seq.to_string();
+        const auto param_pos = out.size();
+        if (!processIdentOrFunction(seq, lex /*, false*/, out))
+            return rollback(out, mark, seq);
         lex.Consume();
-        return "if(toDayOfWeek(" + param + ") = 7, 1, toDayOfWeek(" + param + ") + 1)";
+
+        const auto param_size = out.size() - param_pos;
+        out += ") = 7, 1, toDayOfWeek(";
+        out.append(out, param_pos, param_size);
+        out += ") + 1)";
 /*
     } else if (fn.type == Token::DAYOFYEAR) { // Supported by ClickHouse since 18.13.0
         if (!lex.Match(Token::LPARENT))
-            return seq.to_string();
+            return rollback(out, mark, seq);
 
-        auto param = processIdentOrFunction(seq, lex);
-        if (param.empty())
-            return seq.to_string();
-        lex.Consume();
-        return "( toRelativeDayNum(" + param + ") - toRelativeDayNum(toStartOfYear(" + param + ")) + 1 )";
+        out += "( toRelativeDayNum(";
+        ...
+        out += ") - toRelativeDayNum(toStartOfYear(";
+        ...
+        out += ")) + 1 )";
 */
-    } else if (function_map_strip_params.find(fn.type) != function_map_strip_params.end()) {
-        string result = function_map_strip_params.at(fn.type);
-
+    } else if (const auto * name = getFunctionNameStripParams(fn.type)) {
         if (lex.Peek().type == Token::LPARENT) {
-            processParentheses(seq, lex); // ignore anything inside ( )
+            processParentheses(seq, lex, out); // ignore anything inside ( )
+            out.resize(mark);
         }
 
-        return result;
-    } else if (function_map.find(fn.type) != function_map.end()) {
-        string result = function_map.at(fn.type);
-        auto func = result;
+        out += name;
+
+    } else if (const auto * name = getFunctionName(fn.type)) {
+        out += name;
         lex.SetEmitSpaces(true);
         while (true) {
             const Token tok(lex.Peek());
@@ -299,40 +358,43 @@ string processFunction(const StringView seq, Lexer & lex) {
                 break;
             } else if (tok.type == Token::LCURLY) {
                 lex.SetEmitSpaces(false);
-                result += processEscapeSequencesImpl(seq, lex);
+                processEscapeSequencesImpl(seq, lex, out);
                 lex.SetEmitSpaces(true);
             } else if (tok.type == Token::EOS || tok.type == Token::INVALID) {
                 break;
             } else if (tok.type == Token::EXTRACT) {
-                result += processFunction(seq, lex);
+                processFunction(seq, lex, out);
             } else {
-                if (func != "EXTRACT" && literal_map.find(tok.type) != literal_map.end()) {
-                    result += literal_map.at(tok.type);
-                } else
-                    result += tok.literal.to_string();
+                const auto * literal = (fn.type != Token::EXTRACT ? getLiteral(tok.type) : nullptr);
+                if (literal)
+                    out += literal;
+                else
+                    append(out, tok.literal);
                 lex.Consume();
             }
         }
         lex.SetEmitSpaces(false);
 
-        return result;
+    } else {
+        rollback(out, mark, seq);
     }
-
-    return seq.to_string();
 }
 
-string processDate(const StringView seq, Lexer & lex) {
+void processDate(const StringView seq, Lexer & lex, string & out) {
     Token data = lex.Consume(Token::STRING);
     if (data.isInvalid()) {
-        return seq.to_string();
+        append(out, seq);
     } else {
-        return string("toDate(") + data.literal.to_string() + ")";
+        out += "toDate(";
+        append(out, data.literal);
+        out += ')';
     }
 }
 
-string removeMilliseconds(const StringView token) {
+// Appends the timestamp literal, with the fractional part of seconds removed.
+void appendWithoutMilliseconds(string & out, const StringView token) {
     if (token.empty()) {
-        return string();
+        return;
     }
 
     const char * begin = token.data();
@@ -348,86 +410,93 @@ string removeMilliseconds(const StringView token) {
         }
         if (*p == '.') {
             if (dot) {
-                return token.to_string();
+                return append(out, token);
             }
             dot = p;
         } else {
             if (dot) {
-                return string(begin, dot) + (quoted ? "'" : "");
+                out.append(begin, dot);
+                if (quoted)
+                    out += '\'';
+                return;
             }
-            return token.to_string();
+            return append(out, token);
         }
     }
 
-    return token.to_string();
+    append(out, token);
 }
 
-string processDateTime(const StringView seq, Lexer & lex) {
+void processDateTime(const StringView seq, Lexer & lex, string & out) {
     Token data = lex.Consume(Token::STRING);
     if (data.isInvalid()) {
-        return seq.to_string();
+        append(out, seq);
     } else {
-        return string("toDateTime(") + removeMilliseconds(data.literal) + ")";
+        out += "toDateTime(";
+        appendWithoutMilliseconds(out, data.literal);
+        out += ')';
     }
 }
 
-string processEscapeSequencesImpl(const StringView seq, Lexer & lex) {
-    string result;
+void processEscapeSequencesImpl(const StringView seq, Lexer & lex, string & out) {
+    const auto mark = out.size();
 
     if (!lex.Match(Token::LCURLY)) {
-        return seq.to_string();
+        return append(out, seq);
     }
 
     while (true) {
-        while (lex.Match(Token::SPACE)) {
-        }
+        skipSpaces(lex);
         const Token tok(lex.Consume());
 
         switch (tok.type) {
             case Token::FN:
-                result += processFunction(seq, lex);
+                processFunction(seq, lex, out);
                 break;
 
             case Token::D:
-                result += processDate(seq, lex);
+                processDate(seq, lex, out);
                 break;
             case Token::TS:
-                result += processDateTime(seq, lex);
+                processDateTime(seq, lex, out);
                 break;
 
             // End of escape sequence
             case Token::RCURLY:
-                return result;
+                return;
 
             // Unimplemented
             case Token::T:
             default:
-                return seq.to_string();
+                return rollback(out, mark, seq);
         }
     };
 }
 
-string processEscapeSequences(const StringView seq) {
+void processEscapeSequences(const StringView seq, string & out) {
     Lexer lex(seq);
-    return processEscapeSequencesImpl(seq, lex);
+    processEscapeSequencesImpl(seq, lex, out);
 }
 
 } // namespace
 
 std::string replaceEscapeSequences(const std::string & query) {
+    // Most queries have no escape sequences at all.
+    if (query.find('{') == std::string::npos)
+        return query;
+
     const char * p = query.c_str();
     const char * end = p + query.size();
     const char * st = p;
     int level = 0;
     std::string ret;
+    ret.reserve(query.size());
 
     while (p != end) {
         switch (*p) {
             case '{':
                 if (level == 0) {
-                    if (st < p) {
-                        ret += std::string(st, p);
-                    }
+                    ret.append(st, p);
                     st = p;
                 }
                 level++;
@@ -439,7 +508,7 @@ std::string replaceEscapeSequences(const std::string & query) {
                     return query;
                 }
                 if (--level == 0) {
-                    ret += processEscapeSequences(StringView(st, p + 1));
+                    processEscapeSequences(StringView(st, p + 1), ret);
                     st = p + 1;
                 }
                 break;
@@ -448,9 +517,7 @@ std::string replaceEscapeSequences(const std::string & query) {
         ++p;
     }
 
-    if (st < p) {
-        ret += std::string(st, p);
-    }
+    ret.append(st, p);
 
     return ret;
 }
@@ -1,12 +1,19 @@
 #include "driver/escaping/lexer.h"
 
-#include <algorithm>
-#include <unordered_map>
+#include <array>
+#include <stdexcept>
+#include <string_view>
 
 #include <cctype>
+#include <cstdint>
 
 namespace {
 
+struct Keyword {
+    std::string_view name;
+    Token::Type type;
+};
+
 #define DECLARE(NAME) \
     { #NAME, Token::NAME }
 #define DECLARE2(NAME, IGNORE) \
@@ -14,7 +21,8 @@ namespace {
 #define DECLARE_SQL_TSI(NAME) \
     { #NAME, Token::SQL_TSI_##NAME }
 
-static const std::unordered_map<std::string, Token::Type> KEYWORDS = {
+// If a name is declared more than once, the first declaration wins.
+constexpr Keyword KEYWORDS[] = {
     DECLARE(FN),
     DECLARE(D),
     DECLARE(T),
@@ -38,18 +46,96 @@ static const std::unordered_map<std::string, Token::Type> KEYWORDS = {
 #undef DECLARE2
 #undef DECLARE_SQL_TSI
 
-static Token::Type LookupIdent(const std::string & ident) {
-    auto ki = KEYWORDS.find(ident);
-    if (ki != KEYWORDS.end()) {
-        return ki->second;
+constexpr std::size_t KEYWORD_COUNT = std::size(KEYWORDS);
+constexpr std::size_t KEYWORD_TABLE_SIZE = 2048; // A power of 2, sparse enough for a collision-free seed to be found quickly.
+
+static_assert(KEYWORD_COUNT < 255, "keyword indices must fit into the slots of the keyword table");
+
+constexpr char toUpperASCII(char ch) {
+    return (ch >= 'a' && ch <= 'z' ? static_cast<char>(ch - 'a' + 'A') : ch);
+}
+
+// Case-insensitive FNV-1a, with the final avalanche of MurmurHash3.
+constexpr std::uint32_t hashKeyword(const char * data, std::size_t size, std::uint32_t seed) {
+    std::uint32_t hash = 2166136261u ^ (seed * 0x9E3779B9u);
+
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<unsigned char>(toUpperASCII(data[i]));
+        hash *= 16777619u;
+    }
+
+    hash ^= hash >> 16;
+    hash *= 0x85EBCA6Bu;
+    hash ^= hash >> 13;
+
+    return hash;
+}
+
+constexpr auto IS_DUPLICATE_KEYWORD = [] {
+    std::array<bool, KEYWORD_COUNT> is_duplicate{};
+
+    for (std::size_t i = 0; i < KEYWORD_COUNT; ++i) {
+        for (std::size_t j = 0; j < i && !is_duplicate[i]; ++j) {
+            is_duplicate[i] = (KEYWORDS[i].name == KEYWORDS[j].name);
+        }
+    }
+
+    return is_duplicate;
+}();
+
+// Perfect hash table of the keywords: the seed is chosen at compile time so that every keyword gets a slot of its own,
+// and a lookup is a single hash calculation and at most one comparison.
+struct KeywordTable {
+    bool found = false;
+    std::uint32_t seed = 0;
+    std::array<std::uint8_t, KEYWORD_TABLE_SIZE> slots{}; // 1 + index of the keyword in KEYWORDS, or 0 for an empty slot.
+};
+
+constexpr KeywordTable makeKeywordTable() {
+    for (std::uint32_t seed = 0; seed < 1000; ++seed) {
+        KeywordTable table;
+        table.seed = seed;
+        table.found = true;
+
+        for (std::size_t i = 0; i < KEYWORD_COUNT && table.found; ++i) {
+            if (IS_DUPLICATE_KEYWORD[i])
+                continue;
+
+            const auto & name = KEYWORDS[i].name;
+            auto & slot = table.slots[hashKeyword(name.data(), name.size(), seed) % KEYWORD_TABLE_SIZE];
+
+            if (slot == 0)
+                slot = static_cast<std::uint8_t>(i + 1);
+            else
+                table.found = false;
+        }
+
+        if (table.found)
+            return table;
     }
-    return Token::IDENT;
+
+    return KeywordTable{};
 }
 
-std::string to_upper(const StringView & str) {
-    std::string ret(str.data(), str.size());
-    std::transform(ret.begin(), ret.end(), ret.begin(), ::toupper);
-    return ret;
+constexpr KeywordTable KEYWORD_TABLE = makeKeywordTable();
+
+static_assert(KEYWORD_TABLE.found, "no collision-free seed for the keyword table");
+
+Token::Type LookupIdent(const StringView & ident) {
+    const auto slot = KEYWORD_TABLE.slots[hashKeyword(ident.data(), ident.size(), KEYWORD_TABLE.seed) % KEYWORD_TABLE_SIZE];
+    if (slot == 0)
+        return Token::IDENT;
+
+    const auto & keyword = KEYWORDS[slot - 1];
+    if (keyword.name.size() != ident.size())
+        return Token::IDENT;
+
+    for (std::size_t i = 0; i < ident.size(); ++i) {
+        if (toUpperASCII(ident.data()[i]) != keyword.name[i])
+            return Token::IDENT;
+    }
+
+    return keyword.type;
 }
 
 } // namespace
@@ -57,9 +143,10 @@ std::string to_upper(const StringView & str) {
 Lexer::Lexer(const StringView text) : text_(text), cur_(text.data()), end_(text.data() + text.size()), emit_space_(false) {}
 
 Token Lexer::Consume() {
-    if (!readed_.empty()) {
-        const Token token(readed_.front());
-        readed_.pop_front();
+    if (readed_count_ > 0) {
+        const Token token(readed_[readed_begin_]);
+        readed_begin_ = (readed_begin_ + 1) % max_look_ahead;
+        --readed_count_;
         return token;
     }
 
@@ -67,33 +154,27 @@ Token Lexer::Consume() {
 }
 
 Token Lexer::Consume(Token::Type expected) {
-    if (readed_.empty()) {
-        readed_.push_back(NextToken());
-    }
-
-    if (readed_.front().type == expected) {
-        const Token token(readed_.front());
-        readed_.pop_front();
-        return token;
+    if (Peek().type == expected) {
+        return Consume();
     }
 
     return Token {Token::INVALID, StringView()};
 }
 
 Token Lexer::LookAhead(size_t n) {
-    while (readed_.size() < n + 1) {
-        readed_.push_back(NextToken());
+    if (n >= max_look_ahead)
+        throw std::out_of_range("n must be less than max_look_ahead");
+
+    while (readed_count_ < n + 1) {
+        readed_[(readed_begin_ + readed_count_) % max_look_ahead] = NextToken();
+        ++readed_count_;
     }
 
-    return readed_[n];
+    return readed_[(readed_begin_ + n) % max_look_ahead];
 }
 
 bool Lexer::Match(Token::Type expected) {
-    if (readed_.empty()) {
-        readed_.push_back(NextToken());
-    }
-
-    if (readed_.front().type != expected) {
+    if (Peek().type != expected) {
         return false;
     }
 
@@ -217,7 +298,7 @@ Token Lexer::NextToken() {
                         return Token {Token::IDENT, StringView(st, cur_)};
                     }
                     else {
-                        return Token {LookupIdent(to_upper(StringView(st, cur_))), StringView(st, cur_)};
+                        return Token {LookupIdent(StringView(st, cur_)), StringView(st, cur_)};
                     }
                 }
 
@@ -2,8 +2,7 @@
 
 #include "driver/utils/string_view.h"
 
-#include <deque>
-#include <vector>
+#include <array>
 
 // Allow same declaration as in lexer.cpp
 #define DECLARE(NAME) NAME
@@ -58,6 +57,8 @@ struct Token {
 
 class Lexer {
 public:
+    static constexpr size_t max_look_ahead = 4;
+
     explicit Lexer(const StringView text);
 
     /// Returns next token from input stream.
@@ -66,7 +67,7 @@ public:
     /// Returns next token if its type is equal to expected or error otherwise.
     Token Consume(Token::Type expected);
 
-    /// Look at type of token at position n.
+    /// Look at type of token at position n, which must be less than max_look_ahead.
     Token LookAhead(size_t n);
 
     /// Checks whether type of next token is equal to expected.
@@ -91,7 +92,9 @@ private:
     /// Pointer to current char in the input string.
     const char * cur_;
     const char * end_;
-    /// Recognized tokens.
-    std::deque<Token> readed_;
+    /// Recognized tokens, a ring buffer of readed_count_ tokens starting at readed_begin_.
+    std::array<Token, max_look_ahead> readed_;
+    size_t readed_begin_ = 0;
+    size_t readed_count_ = 0;
     bool emit_space_;
 };
@@ -0,0 +1,484 @@
+#include "driver/format/Native.h"
+
+NativeResultSet::NativeResultSet(const std::string & timezone_, AmortizedIStreamReader & stream, std::unique_ptr<ResultMutator> && mutator)
+    : ResultSet(stream, std::move(mutator))
+    , timezone(timezone_)
+{
+    // The structure of the result set is deduced from the first block, which is read right away.
+    readNextBlock(result_mutator ? block : rows);
+    finished = columns_info.empty();
+}
+
+NativeResultSet::~NativeResultSet() {
+    stopBackgroundReading();
+}
+
+bool NativeResultSet::readNextRows(RowBlock & dest) {
+    // Mutators work with individual rows, so the default row by row processing is done in that case.
+    if (result_mutator)
+        return ResultSet::readNextRows(dest);
+
+    return readNextBlock(dest);
+}
+
+bool NativeResultSet::readNextRow(Row & row) {
+    while (block.size() == 0) {
+        if (!readNextBlock(block))
+            return false;
+    }
+
+    block.moveFirstRowTo(row);
+
+    return true;
+}
+
+bool NativeResultSet::readNextBlock(RowBlock & dest) {
+    if (stream.eof())
+        return false;
+
+    std::uint64_t num_columns = 0;
+    readSize(num_columns);
+
+    std::uint64_t num_rows = 0;
+    readSize(num_rows);
+
+    const bool is_first_block = columns_info.empty();
+
+    if (is_first_block)
+        columns_info.resize(num_columns);
+    else if (num_columns != columns_info.size())
+        throw std::runtime_error("Unexpected number of columns in a block of Native format");
+
+    if (dest.getColumnCount() != num_columns)
+        dest.reset(num_columns);
+
+    std::string name;
+    std::string type;
+
+    for (std::size_t i = 0; i < num_columns; ++i) {
+        auto & column_info = columns_info[i];
+
+        readValue(name);
+        readValue(type);
+
+        if (is_first_block) {
+            TypeParser parser{type};
+            TypeAst ast;
+
+            if (!parser.parse(&ast))
+                throw std::runtime_error("Unable to read values of an unknown type '" + type + "'");
+
+            const auto * value_ast = &ast;
+
+            if (value_ast->meta == TypeAst::LowCardinality)
+                value_ast = &value_ast->elements.front();
+
+            if (value_ast->meta == TypeAst::Nullable)
+                value_ast = &value_ast->elements.front();
+
+            if (value_ast->meta != TypeAst::Terminal)
+                throw std::runtime_error("Unable to decode values of type '" + type + "'");
+
+            column_info.name = name;
+            column_info.type = type;
+            column_info.assignTypeInfo(ast, timezone);
+            column_info.updateTypeInfo();
+        }
+        else if (name != column_info.name || type != column_info.type) {
+            throw std::runtime_error("Unexpected structure of a block of Native format");
+        }
+
+        readColumn(column_info, dest.getColumn(i), num_rows);
+    }
+
+    return true;
+}
+
+void NativeResultSet::readSize(std::uint64_t & res) {
+
+    // Read an ULEB128 encoded integer from the stream.
+
+    std::uint64_t tmp_res = 0;
+    std::uint8_t shift = 0;
+
+    while (true) {
+        const int byte = stream.get();
+
+        const std::uint64_t chunk = (byte & 0b01111111);
+        const std::uint64_t segment = (chunk << shift);
+
+        if (
+            (segment >> shift) != chunk ||
+            (std::numeric_limits<decltype(shift)>::max() - 7) < shift
+        ) {
+            throw std::runtime_error("ULEB128 value too big");
+        }
+
+        tmp_res |= segment;
+
+        if ((byte & 0b10000000) == 0)
+            break;
+
+        shift += 7;
+    }
+
+    res = tmp_res;
+}
+
+void NativeResultSet::readValue(std::string & dest) {
+    std::uint64_t size = 0;
+    readSize(size);
+
+    resize_without_initialization(dest, size);
+
+    try {
+        stream.read(dest.data(), dest.size());
+    }
+    catch (...) {
+        dest.clear();
+        throw;
+    }
+}
+
+template <typename T>
+T NativeResultSet::readPOD() {
+    T value;
+    stream.read(reinterpret_cast<char *>(&value), sizeof(T));
+    return value;
+}
+
+void NativeResultSet::readNullMap(std::size_t num_rows) {
+    resize_without_initialization(null_map, num_rows);
+    stream.read(null_map.data(), null_map.size());
+}
+
+template <typename T>
+void NativeResultSet::readFixedColumnAs(ColumnInfo & column_info, ColumnData & column, std::size_t num_rows) {
+    using ValueType = decltype(T::value);
+
+    readRawColumn<ValueType>(num_rows);
+
+    for (std::size_t i = 0; i < num_rows; ++i) {
+        if (isNull(column_info, i))
+            column.pushNull();
+        else
+            column.push_back(T(getRawValue<ValueType>(i)));
+    }
+}
+
+template <typename T>
+void NativeResultSet::readWireColumnUsing(const T & proto, ColumnInfo & column_info, ColumnData & column, std::size_t num_rows) {
+    using ValueType = typename T::ContainerIntType;
+
+    readRawColumn<ValueType>(num_rows);
+
+    for (std::size_t i = 0; i < num_rows; ++i) {
+        if (isNull(column_info, i)) {
+            column.pushNull();
+        }
+        else {
+            T value = proto;
+            value.value = getRawValue<ValueType>(i);
+            column.push_back(std::move(value));
+        }
+    }
+}
+
+template <typename T>
+void NativeResultSet::readDecimalColumnAs(ColumnInfo & column_info, ColumnData & column, std::size_t num_rows) {
+    if (column_info.precision < 10)
+        return readDecimalColumnUsing<T, std::int32_t>(column_info, column, num_rows);
+    else if (column_info.precision < 19)
+        return readDecimalColumnUsing<T, std::int64_t>(column_info, column, num_rows);
+    else if (column_info.precision < 39)
+        return readWideIntegerColumnUsing<T, 128>(true, column_info, column, num_rows);
+    else if (column_info.precision < 77)
+        return readWideIntegerColumnUsing<T, 256>(true, column_info, column, num_rows);
+
+    throw std::runtime_error("Unable to decode value of type 'Decimal' with precision " + std::to_string(column_info.precision));
+}
+
+template <typename T, typename IntType>
+void NativeResultSet::readDecimalColumnUsing(ColumnInfo & column_info, ColumnData & column, std::size_t num_rows) {
+    readRawColumn<IntType>(num_rows);
+
+    for (std::size_t i = 0; i < num_rows; ++i) {
+        if (isNull(column_info, i)) {
+            column.pushNull();
+            continue;
+        }
+
+        const std::int64_t value = getRawValue<IntType>(i);
+
+        T dest;
+        dest.precision = column_info.precision;
+        dest.scale = column_info.scale;
+
+        if (value < 0) {
+            dest.sign = 0;
+            dest.value = -value;
+        }
+        else {
+            dest.sign = 1;
+            dest.value = value;
+        }
+
+        column.push_back(std::move(dest));
+    }
+}
+
+template <typename T, std::size_t Bits>
+void NativeResultSet::readWideIntegerColumnUsing(bool is_signed, ColumnInfo & column_info, ColumnData & column, std::size_t num_rows) {
+    constexpr std::size_t size = Bits / 8;
+    column_data = stream.readView(num_rows * size);
+
+    for (std::size_t i = 0; i < num_rows; ++i) {
+        if (isNull(column_info, i)) {
+            column.pushNull();
+            continue;
+        }
+
+        T dest;
+        dest.precision = column_info.precision;
+        dest.scale = column_info.scale;
+        dest.sign = (dest.value.assignLittleEndian(column_data.data() + i * size, size, is_signed) ? 0 : 1);
+
+        column.push_back(std::move(dest));
+    }
+}
+
+void NativeResultSet::readFixedStringColumn(ColumnInfo & column_info, ColumnData & column, std::size_t num_rows) {
+    const auto size = column_info.fixed_size;
+
+    for (std::size_t i = 0; i < num_rows; ++i) {
+        if (isNull(column_info, i)) {
+            stream.read(nullptr, size);
+            column.pushNull();
+            continue;
+        }
+
+        stream.read(column.pushString<DataSourceType<DataSourceTypeId::FixedString>>(size), size);
+    }
+
+    if (num_rows > 0 && column_info.display_size_so_far < size)
+        column_info.display_size_so_far = size;
+}
+
+void NativeResultSet::readStringColumn(ColumnInfo & column_info, ColumnData & column, std::size_t num_rows) {
+    for (std::size_t i = 0; i < num_rows; ++i) {
+        std::uint64_t size = 0;
+        readSize(size);
+
+        if (isNull(column_info, i)) {
+            stream.read(nullptr, size);
+            column.pushNull();
+            continue;
+        }
+
+        stream.read(column.pushString<DataSourceType<DataSourceTypeId::String>>(size), size);
+
+        if (column_info.display_size_so_far < size)
+            column_info.display_size_so_far = size;
+    }
+}
+
+void NativeResultSet::readUUIDColumn(ColumnInfo & column_info, ColumnData & column, std::size_t num_rows) {
+    constexpr std::size_t uuid_size = 16;
+
+    readRawColumn<char[uuid_size]>(num_rows);
+
+    for (std::size_t i = 0; i < num_rows; ++i) {
+        if (isNull(column_info, i)) {
+            column.pushNull();
+            continue;
+        }
+
+        DataSourceType<DataSourceTypeId::UUID> dest;
+
+        static_assert(sizeof(dest.value) == uuid_size);
+        const char * ptr = column_data.data() + i * uuid_size;
+
+        std::memcpy(&dest.value.Data3, ptr, sizeof(dest.value.Data3)); ptr += sizeof(dest.value.Data3);
+        std::memcpy(&dest.value.Data2, ptr, sizeof(dest.value.Data2)); ptr += sizeof(dest.value.Data2);
+        std::memcpy(&dest.value.Data1, ptr, sizeof(dest.value.Data1)); ptr += sizeof(dest.value.Data1);
+
+        std::copy(ptr, ptr + lengthof(dest.value.Data4), std::make_reverse_iterator(dest.value.Data4 + lengthof(dest.value.Data4)));
+
+        column.push_back(std::move(dest));
+    }
+}
+
+void NativeResultSet::readNothingColumn(ColumnInfo & column_info, ColumnData & column, std::size_t num_rows) {
+    // Each value of Nothing type is still represented by a single (meaningless) byte on wire.
+    stream.read(nullptr, num_rows);
+
+    for (std::size_t i = 0; i < num_rows; ++i) {
+        column.pushNull();
+    }
+}
+
+template <typename T>
+void NativeResultSet::readLowCardinalityKeys(ColumnInfo & column_info, LowCardinalityColumnValues<T> & keys, std::size_t num_keys) {
+    for (std::size_t i = 0; i < num_keys; ++i) {
+        std::uint64_t size = column_info.fixed_size;
+
+        if constexpr (std::is_same_v<T, DataSourceType<DataSourceTypeId::String>>)
+            readSize(size);
+
+        stream.read(keys.appendKey(size), size);
+
+        if (column_info.display_size_so_far < size)
+            column_info.display_size_so_far = size;
+    }
+}
+
+void NativeResultSet::readLowCardinalityKeys(ColumnInfo & column_info, std::vector<Field> & keys, std::size_t num_keys) {
+    // Keys are serialized as a column of the non-nullable nested type.
+    ColumnInfo key_column_info = column_info;
+    key_column_info.is_nullable = false;
+    key_column_info.is_low_cardinality = false;
+
+    ColumnData key_column;
+    readColumn(key_column_info, key_column, num_keys);
+
+    const auto offset = keys.size();
+    keys.resize(offset + num_keys);
+
+    for (std::size_t i = 0; i < num_keys; ++i) {
+        key_column.moveTo(i, keys[offset + i]);
+    }
+
+    column_info.display_size_so_far = key_column_info.display_size_so_far;
+}
+
+template <typename T>
+void NativeResultSet::readLowCardinalityColumnAs(ColumnInfo & column_info, ColumnData & column, std::size_t num_rows) {
+    // No bytes at all, not even the serialization version, are sent for an empty column.
+    if (num_rows == 0)
+        return;
+
+    constexpr std::uint64_t index_type_mask = 0xFF;
+    constexpr std::uint64_t need_global_dictionary_bit = 1ull << 8;
+    constexpr std::uint64_t has_additional_keys_bit = 1ull << 9;
+
+    if (readPOD<std::uint64_t>() != 1)
+        throw std::runtime_error("Unexpected serialization version of LowCardinality column");
+
+    const auto flags = readPOD<std::uint64_t>();
+
+    // Values refer to the keys of the dictionary, which is made of the global keys, followed by the additional ones.
+    // The keys of string types are stored directly in the column, so they are converted at most once when the values are extracted.
+    // Keys of all other types are expanded into the individual values right away.
+    using KeyType = std::conditional_t<std::is_void_v<T>, DataSourceType<DataSourceTypeId::String>, T>;
+
+    LowCardinalityColumnValues<KeyType> * string_keys = nullptr;
+    if constexpr (!std::is_void_v<T>)
+        string_keys = column.getLowCardinalityValues<T>();
+
+    const auto first_key = (string_keys ? string_keys->getKeyCount() : 0);
+    low_cardinality_keys.clear();
+
+    for (const auto bit : {need_global_dictionary_bit, has_additional_keys_bit}) {
+        if ((flags & bit) == 0)
+            continue;
+
+        const auto num_keys = readPOD<std::uint64_t>();
+
+        if (string_keys)
+            readLowCardinalityKeys(column_info, *string_keys, num_keys);
+        else
+            readLowCardinalityKeys(column_info, low_cardinality_keys, num_keys);
+    }
+
+    if (readPOD<std::uint64_t>() != num_rows)
+        throw std::runtime_error("Unexpected number of indexes in LowCardinality column");
+
+    const auto push_values = [&] (auto index_proto) {
+        using IndexType = decltype(index_proto);
+
+        readRawColumn<IndexType>(num_rows);
+
+        for (std::size_t i = 0; i < num_rows; ++i) {
+            const std::size_t key_pos = getRawValue<IndexType>(i);
+
+            // The first key of a nullable column represents Null.
+            if (column_info.is_nullable && key_pos == 0)
+                column.pushNull();
+            else if (string_keys)
+                column.pushKey<KeyType>(first_key + key_pos);
+            else
+                column.push_back(Field{low_cardinality_keys.at(key_pos)});
+        }
+    };
+
+    switch (flags & index_type_mask) {
+        case 0: return push_values(std::uint8_t{});
+        case 1: return push_values(std::uint16_t{});
+        case 2: return push_values(std::uint32_t{});
+        case 3: return push_values(std::uint64_t{});
+        default: throw std::runtime_error("Unexpected index type of LowCardinality column");
+    }
+}
+
+void NativeResultSet::readColumn(ColumnInfo & column_info, ColumnData & column, std::size_t num_rows) {
+    if (column_info.is_low_cardinality) {
+        switch (column_info.type_without_parameters_id) {
+            case DataSourceTypeId::FixedString: return readLowCardinalityColumnAs<DataSourceType< DataSourceTypeId::FixedString >>(column_info, column, num_rows);
+            case DataSourceTypeId::String:      return readLowCardinalityColumnAs<DataSourceType< DataSourceTypeId::String      >>(column_info, column, num_rows);
+            default:                            return readLowCardinalityColumnAs<void>(column_info, column, num_rows);
+        }
+    }
+
+    if (column_info.is_nullable)
+        readNullMap(num_rows);
+
+    switch (column_info.type_without_parameters_id) {
+        case DataSourceTypeId::Date:        return readWireColumnUsing(WireTypeDateAsInt       (),                                              column_info, column, num_rows);
+        case DataSourceTypeId::DateTime:    return readWireColumnUsing(WireTypeDateTimeAsInt   (*column_info.time_zone),                        column_info, column, num_rows);
+        case DataSourceTypeId::DateTime64:  return readWireColumnUsing(WireTypeDateTime64AsInt (column_info.precision, *column_info.time_zone), column_info, column, num_rows);
+        case DataSourceTypeId::Decimal:     return readDecimalColumnAs<DataSourceType< DataSourceTypeId::Decimal    >>(column_info, column, num_rows);
+        case DataSourceTypeId::Decimal32:   return readDecimalColumnAs<DataSourceType< DataSourceTypeId::Decimal32  >>(column_info, column, num_rows);
+        case DataSourceTypeId::Decimal64:   return readDecimalColumnAs<DataSourceType< DataSourceTypeId::Decimal64  >>(column_info, column, num_rows);
+        case DataSourceTypeId::Decimal128:  return readDecimalColumnAs<DataSourceType< DataSourceTypeId::Decimal128 >>(column_info, column, num_rows);
+        case DataSourceTypeId::FixedString: return readFixedStringColumn(column_info, column, num_rows);
+        case DataSourceTypeId::Float32:     return readFixedColumnAs<DataSourceType< DataSourceTypeId::Float32 >>(column_info, column, num_rows);
+        case DataSourceTypeId::Float64:     return readFixedColumnAs<DataSourceType< DataSourceTypeId::Float64 >>(column_info, column, num_rows);
+        case DataSourceTypeId::Int8:        return readFixedColumnAs<DataSourceType< DataSourceTypeId::Int8    >>(column_info, column, num_rows);
+        case DataSourceTypeId::Int16:       return readFixedColumnAs<DataSourceType< DataSourceTypeId::Int16   >>(column_info, column, num_rows);
+        case DataSourceTypeId::Int32:       return readFixedColumnAs<DataSourceType< DataSourceTypeId::Int32   >>(column_info, column, num_rows);
+        case DataSourceTypeId::Int64:       return readFixedColumnAs<DataSourceType< DataSourceTypeId::Int64   >>(column_info, column, num_rows);
+        case DataSourceTypeId::Int128:      return readWideIntegerColumnUsing<DataSourceType< DataSourceTypeId::Int128  >, 128>(true,  column_info, column, num_rows);
+        case DataSourceTypeId::Int256:      return readWideIntegerColumnUsing<DataSourceType< DataSourceTypeId::Int256  >, 256>(true,  column_info, column, num_rows);
+        case DataSourceTypeId::Nothing:     return readNothingColumn(column_info, column, num_rows);
+        case DataSourceTypeId::String:      return readStringColumn(column_info, column, num_rows);
+        case DataSourceTypeId::UInt8:       return readFixedColumnAs<DataSourceType< DataSourceTypeId::UInt8   >>(column_info, column, num_rows);
+        case DataSourceTypeId::UInt16:      return readFixedColumnAs<DataSourceType< DataSourceTypeId::UInt16  >>(column_info, column, num_rows);
+        case DataSourceTypeId::UInt32:      return readFixedColumnAs<DataSourceType< DataSourceTypeId::UInt32  >>(column_info, column, num_rows);
+        case DataSourceTypeId::UInt64:      return readFixedColumnAs<DataSourceType< DataSourceTypeId::UInt64  >>(column_info, column, num_rows);
+        case DataSourceTypeId::UInt128:     return readWideIntegerColumnUsing<DataSourceType< DataSourceTypeId::UInt128 >, 128>(false, column_info, column, num_rows);
+        case DataSourceTypeId::UInt256:     return readWideIntegerColumnUsing<DataSourceType< DataSourceTypeId::UInt256 >, 256>(false, column_info, column, num_rows);
+        case DataSourceTypeId::UUID:        return readUUIDColumn(column_info, column, num_rows);
+        default:                            throw std::runtime_error("Unable to decode value of type '" + column_info.type + "'");
+    }
+}
+
+NativeResultReader::NativeResultReader(const std::string & timezone_, std::istream & raw_stream, std::unique_ptr<ResultMutator> && mutator, std::size_t read_buffer_size)
+    : ResultReader(timezone_, raw_stream, std::move(mutator), read_buffer_size)
+{
+    if (stream.eof())
+        return;
+
+    result_set = std::make_unique<NativeResultSet>(timezone, stream, releaseMutator());
+}
+
+bool NativeResultReader::advanceToNextResultSet() {
+    // Native format doesn't support multiple result sets in the response,
+    // so only a basic cleanup is done here.
+
+    if (result_set) {
+        result_mutator = result_set->releaseMutator();
+        result_set.reset();
+    }
+
+    return hasResultSet();
+}
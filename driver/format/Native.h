@@ -0,0 +1,99 @@
+#pragma once
+
+#include "driver/platform/platform.h"
+#include "driver/result_set.h"
+#include "driver/utils/resize_without_initialization.h"
+
+#include <string>
+#include <string_view>
+
+#include <cstring>
+
+// Implementation of ResultSet for Native wire format of ClickHouse.
+// The data comes in blocks, where each block carries all its values column by column,
+// so values are decoded one column per block at a time, with a single type dispatch per column.
+class NativeResultSet
+    : public ResultSet
+{
+public:
+    explicit NativeResultSet(const std::string & timezone, AmortizedIStreamReader & stream, std::unique_ptr<ResultMutator> && mutator);
+    virtual ~NativeResultSet() override;
+
+protected:
+    virtual bool readNextRows(RowBlock & dest) override;
+    virtual bool readNextRow(Row & row) override;
+
+private:
+    bool readNextBlock(RowBlock & dest);
+
+    template <typename T>
+    T readPOD();
+
+    void readSize(std::uint64_t & dest);
+    void readValue(std::string & dest);
+
+    void readColumn(ColumnInfo & column_info, ColumnData & column, std::size_t num_rows);
+    void readNullMap(std::size_t num_rows);
+
+    // The raw values are accessed in place, in the buffer of the stream, so the stream must not be touched until they are decoded.
+    template <typename T>
+    void readRawColumn(std::size_t num_rows) {
+        column_data = stream.readView(num_rows * sizeof(T));
+    }
+
+    template <typename T>
+    T getRawValue(std::size_t row_idx) const {
+        T value;
+        std::memcpy(&value, column_data.data() + row_idx * sizeof(T), sizeof(T));
+        return value;
+    }
+
+    template <typename T>
+    void readFixedColumnAs(ColumnInfo & column_info, ColumnData & column, std::size_t num_rows);
+
+    template <typename T>
+    void readWireColumnUsing(const T & proto, ColumnInfo & column_info, ColumnData & column, std::size_t num_rows);
+
+    template <typename T>
+    void readDecimalColumnAs(ColumnInfo & column_info, ColumnData & column, std::size_t num_rows);
+
+    template <typename T, typename IntType>
+    void readDecimalColumnUsing(ColumnInfo & column_info, ColumnData & column, std::size_t num_rows);
+
+    template <typename T, std::size_t Bits>
+    void readWideIntegerColumnUsing(bool is_signed, ColumnInfo & column_info, ColumnData & column, std::size_t num_rows);
+
+    void readFixedStringColumn(ColumnInfo & column_info, ColumnData & column, std::size_t num_rows);
+    void readStringColumn(ColumnInfo & column_info, ColumnData & column, std::size_t num_rows);
+    void readUUIDColumn(ColumnInfo & column_info, ColumnData & column, std::size_t num_rows);
+    void readNothingColumn(ColumnInfo & column_info, ColumnData & column, std::size_t num_rows);
+
+    // T is the string type, whose values are kept dictionary-encoded, or void, if the values must be expanded.
+    template <typename T>
+    void readLowCardinalityColumnAs(ColumnInfo & column_info, ColumnData & column, std::size_t num_rows);
+
+    template <typename T>
+    void readLowCardinalityKeys(ColumnInfo & column_info, LowCardinalityColumnValues<T> & keys, std::size_t num_keys);
+    void readLowCardinalityKeys(ColumnInfo & column_info, std::vector<Field> & keys, std::size_t num_keys);
+
+    bool isNull(const ColumnInfo & column_info, std::size_t row_idx) const {
+        return (column_info.is_nullable && null_map[row_idx] != 0);
+    }
+
+private:
+    const std::string timezone;
+    RowBlock block;               // Decoded rows of the current block that are not consumed yet, used only when the rows have to be mutated.
+    std::string_view column_data; // Raw values of the fixed-width column being decoded.
+    std::string null_map;         // Null map of the nullable column being decoded.
+    std::vector<Field> low_cardinality_keys; // Dictionary of the LowCardinality column being decoded, if its values are expanded.
+};
+
+class NativeResultReader
+    : public ResultReader
+{
+public:
+    explicit NativeResultReader(const std::string & timezone, std::istream & raw_stream, std::unique_ptr<ResultMutator> && mutator, std::size_t read_buffer_size);
+    virtual ~NativeResultReader() override = default;
+
+    virtual bool advanceToNextResultSet() override;
+};
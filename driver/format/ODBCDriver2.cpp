@@ -62,6 +62,10 @@ ODBCDriver2ResultSet::ODBCDriver2ResultSet(const std::string & timezone, Amortiz
     finished = columns_info.empty();
 }
 
+ODBCDriver2ResultSet::~ODBCDriver2ResultSet() {
+    stopBackgroundReading();
+}
+
 bool ODBCDriver2ResultSet::readNextRow(Row & row) {
     if (stream.eof())
         return false;
@@ -106,15 +110,19 @@ void ODBCDriver2ResultSet::readValue(std::string & dest, bool * is_null) {
 }
 
 void ODBCDriver2ResultSet::readValue(Field & dest, ColumnInfo & column_info) {
-    auto value = string_pool.get();
-    value_manip::to_null(value);
+    std::string value;
+
+    // Reuse the buffer of the string value that was previously read into dest, if any.
+    std::visit([&value] (auto & prev_value) {
+        if constexpr (is_string_data_source_type_v<std::decay_t<decltype(prev_value)>>)
+            value = std::move(prev_value.value);
+    }, dest.data);
 
     bool is_null = false;
     readValue(value, &is_null);
 
     if (is_null/* && column_info.is_nullable*/) {
         dest.data = DataSourceType<DataSourceTypeId::Nothing>{};
-        string_pool.put(std::move(value));
         return;
     }
 
@@ -143,18 +151,19 @@ void ODBCDriver2ResultSet::readValue(Field & dest, ColumnInfo & column_info) {
         case DataSourceTypeId::Int16:       readValueAs<DataSourceType< DataSourceTypeId::Int16       >>(value, dest, column_info); break;
         case DataSourceTypeId::Int32:       readValueAs<DataSourceType< DataSourceTypeId::Int32       >>(value, dest, column_info); break;
         case DataSourceTypeId::Int64:       readValueAs<DataSourceType< DataSourceTypeId::Int64       >>(value, dest, column_info); break;
+        case DataSourceTypeId::Int128:      readValueAs<DataSourceType< DataSourceTypeId::Int128      >>(value, dest, column_info); break;
+        case DataSourceTypeId::Int256:      readValueAs<DataSourceType< DataSourceTypeId::Int256      >>(value, dest, column_info); break;
         case DataSourceTypeId::Nothing:     readValueAs<DataSourceType< DataSourceTypeId::Nothing     >>(value, dest, column_info); break;
         case DataSourceTypeId::String:      readValueAs<DataSourceType< DataSourceTypeId::String      >>(value, dest, column_info); break;
         case DataSourceTypeId::UInt8:       readValueAs<DataSourceType< DataSourceTypeId::UInt8       >>(value, dest, column_info); break;
         case DataSourceTypeId::UInt16:      readValueAs<DataSourceType< DataSourceTypeId::UInt16      >>(value, dest, column_info); break;
         case DataSourceTypeId::UInt32:      readValueAs<DataSourceType< DataSourceTypeId::UInt32      >>(value, dest, column_info); break;
         case DataSourceTypeId::UInt64:      readValueAs<DataSourceType< DataSourceTypeId::UInt64      >>(value, dest, column_info); break;
+        case DataSourceTypeId::UInt128:     readValueAs<DataSourceType< DataSourceTypeId::UInt128     >>(value, dest, column_info); break;
+        case DataSourceTypeId::UInt256:     readValueAs<DataSourceType< DataSourceTypeId::UInt256     >>(value, dest, column_info); break;
         case DataSourceTypeId::UUID:        readValueAs<DataSourceType< DataSourceTypeId::UUID        >>(value, dest, column_info); break;
         default:                            throw std::runtime_error("Unable to decode value of type '" + column_info.type + "'");
     }
-
-    if (value.capacity() > initial_string_capacity_g)
-        string_pool.put(std::move(value));
 }
 
 void ODBCDriver2ResultSet::readValue(std::string & src, WireTypeAnyAsString & dest, ColumnInfo & column_info) {
@@ -217,6 +226,14 @@ void ODBCDriver2ResultSet::readValue(std::string & src, DataSourceType<DataSourc
     return value_manip::from_value<std::string>::template to_value<DataSourceType<DataSourceTypeId::Int64>>::convert(src, dest);
 }
 
+void ODBCDriver2ResultSet::readValue(std::string & src, DataSourceType<DataSourceTypeId::Int128> & dest, ColumnInfo & column_info) {
+    return value_manip::from_value<std::string>::template to_value<DataSourceType<DataSourceTypeId::Int128>>::convert(src, dest);
+}
+
+void ODBCDriver2ResultSet::readValue(std::string & src, DataSourceType<DataSourceTypeId::Int256> & dest, ColumnInfo & column_info) {
+    return value_manip::from_value<std::string>::template to_value<DataSourceType<DataSourceTypeId::Int256>>::convert(src, dest);
+}
+
 void ODBCDriver2ResultSet::readValue(std::string & src, DataSourceType<DataSourceTypeId::Nothing> & dest, ColumnInfo & column_info) {
     // Do nothing.
 }
@@ -241,12 +258,20 @@ void ODBCDriver2ResultSet::readValue(std::string & src, DataSourceType<DataSourc
     return value_manip::from_value<std::string>::template to_value<DataSourceType<DataSourceTypeId::UInt64>>::convert(src, dest);
 }
 
+void ODBCDriver2ResultSet::readValue(std::string & src, DataSourceType<DataSourceTypeId::UInt128> & dest, ColumnInfo & column_info) {
+    return value_manip::from_value<std::string>::template to_value<DataSourceType<DataSourceTypeId::UInt128>>::convert(src, dest);
+}
+
+void ODBCDriver2ResultSet::readValue(std::string & src, DataSourceType<DataSourceTypeId::UInt256> & dest, ColumnInfo & column_info) {
+    return value_manip::from_value<std::string>::template to_value<DataSourceType<DataSourceTypeId::UInt256>>::convert(src, dest);
+}
+
 void ODBCDriver2ResultSet::readValue(std::string & src, DataSourceType<DataSourceTypeId::UUID> & dest, ColumnInfo & column_info) {
     return value_manip::from_value<std::string>::template to_value<DataSourceType<DataSourceTypeId::UUID>>::convert(src, dest);
 }
 
-ODBCDriver2ResultReader::ODBCDriver2ResultReader(const std::string & timezone_, std::istream & raw_stream, std::unique_ptr<ResultMutator> && mutator)
-    : ResultReader(timezone_, raw_stream, std::move(mutator))
+ODBCDriver2ResultReader::ODBCDriver2ResultReader(const std::string & timezone_, std::istream & raw_stream, std::unique_ptr<ResultMutator> && mutator, std::size_t read_buffer_size)
+    : ResultReader(timezone_, raw_stream, std::move(mutator), read_buffer_size)
 {
     if (stream.eof())
         return;
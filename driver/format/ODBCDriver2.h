@@ -9,7 +9,7 @@ class ODBCDriver2ResultSet
 {
 public:
     explicit ODBCDriver2ResultSet(const std::string & timezone, AmortizedIStreamReader & stream, std::unique_ptr<ResultMutator> && mutator);
-    virtual ~ODBCDriver2ResultSet() override = default;
+    virtual ~ODBCDriver2ResultSet() override;
 
 protected:
     virtual bool readNextRow(Row & row) override;
@@ -44,12 +44,16 @@ private:
     void readValue(std::string & src, DataSourceType< DataSourceTypeId::Int16       > & dest, ColumnInfo & column_info);
     void readValue(std::string & src, DataSourceType< DataSourceTypeId::Int32       > & dest, ColumnInfo & column_info);
     void readValue(std::string & src, DataSourceType< DataSourceTypeId::Int64       > & dest, ColumnInfo & column_info);
+    void readValue(std::string & src, DataSourceType< DataSourceTypeId::Int128      > & dest, ColumnInfo & column_info);
+    void readValue(std::string & src, DataSourceType< DataSourceTypeId::Int256      > & dest, ColumnInfo & column_info);
     void readValue(std::string & src, DataSourceType< DataSourceTypeId::Nothing     > & dest, ColumnInfo & column_info);
     void readValue(std::string & src, DataSourceType< DataSourceTypeId::String      > & dest, ColumnInfo & column_info);
     void readValue(std::string & src, DataSourceType< DataSourceTypeId::UInt8       > & dest, ColumnInfo & column_info);
     void readValue(std::string & src, DataSourceType< DataSourceTypeId::UInt16      > & dest, ColumnInfo & column_info);
     void readValue(std::string & src, DataSourceType< DataSourceTypeId::UInt32      > & dest, ColumnInfo & column_info);
     void readValue(std::string & src, DataSourceType< DataSourceTypeId::UInt64      > & dest, ColumnInfo & column_info);
+    void readValue(std::string & src, DataSourceType< DataSourceTypeId::UInt128     > & dest, ColumnInfo & column_info);
+    void readValue(std::string & src, DataSourceType< DataSourceTypeId::UInt256     > & dest, ColumnInfo & column_info);
     void readValue(std::string & src, DataSourceType< DataSourceTypeId::UUID        > & dest, ColumnInfo & column_info);
 
     template <typename T>
@@ -62,7 +66,7 @@ class ODBCDriver2ResultReader
     : public ResultReader
 {
 public:
-    explicit ODBCDriver2ResultReader(const std::string & timezone_, std::istream & raw_stream, std::unique_ptr<ResultMutator> && mutator);
+    explicit ODBCDriver2ResultReader(const std::string & timezone_, std::istream & raw_stream, std::unique_ptr<ResultMutator> && mutator, std::size_t read_buffer_size);
     virtual ~ODBCDriver2ResultReader() override = default;
 
     virtual bool advanceToNextResultSet() override;
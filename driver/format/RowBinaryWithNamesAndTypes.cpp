@@ -29,17 +29,37 @@ RowBinaryWithNamesAndTypesResultSet::RowBinaryWithNamesAndTypesResultSet(const s
         }
 
         columns_info[i].updateTypeInfo();
+        decoders.push_back(makeColumnDecoder(columns_info[i]));
     }
 
     finished = columns_info.empty();
 }
 
+RowBinaryWithNamesAndTypesResultSet::~RowBinaryWithNamesAndTypesResultSet() {
+    stopBackgroundReading();
+}
+
+bool RowBinaryWithNamesAndTypesResultSet::readNextRows(RowBlock & dest) {
+    // Mutators work with individual rows, so the default row by row processing is done in that case.
+    if (result_mutator)
+        return ResultSet::readNextRows(dest);
+
+    if (stream.eof())
+        return false;
+
+    for (std::size_t i = 0; i < decoders.size(); ++i) {
+        (this->*decoders[i].read_column)(dest.getColumn(i), columns_info[i]);
+    }
+
+    return true;
+}
+
 bool RowBinaryWithNamesAndTypesResultSet::readNextRow(Row & row) {
     if (stream.eof())
         return false;
 
-    for (std::size_t i = 0; i < row.fields.size(); ++i) {
-        readValue(row.fields[i], columns_info[i]);
+    for (std::size_t i = 0; i < decoders.size(); ++i) {
+        (this->*decoders[i].read_field)(row.fields[i], columns_info[i]);
     }
 
     return true;
@@ -99,52 +119,97 @@ void RowBinaryWithNamesAndTypesResultSet::readValue(std::string & dest, const st
     }
 }
 
-void RowBinaryWithNamesAndTypesResultSet::readValue(Field & dest, ColumnInfo & column_info) {
-    if (column_info.is_nullable) {
+template <typename T, bool is_nullable, typename Dest>
+void RowBinaryWithNamesAndTypesResultSet::decodeValue(Dest & dest, ColumnInfo & column_info) {
+    if constexpr (is_nullable) {
         bool is_null = false;
         readValue(is_null);
 
-        if (is_null) {
-            dest.data = DataSourceType<DataSourceTypeId::Nothing>{};
-            return;
-        }
+        if (is_null)
+            return readValueAs<DataSourceType<DataSourceTypeId::Nothing>>(dest, column_info);
     }
 
+    return readValueAs<T>(dest, column_info);
+}
+
+template <typename Dest>
+void RowBinaryWithNamesAndTypesResultSet::decodeUnsupportedValue(Dest & dest, ColumnInfo & column_info) {
+    throw std::runtime_error("Unable to decode value of type '" + column_info.type + "'");
+}
+
+template <typename T>
+RowBinaryWithNamesAndTypesResultSet::ColumnDecoder RowBinaryWithNamesAndTypesResultSet::makeColumnDecoderFor(const ColumnInfo & column_info) {
+    ColumnDecoder decoder;
+
+    if (column_info.is_nullable) {
+        decoder.read_field = &RowBinaryWithNamesAndTypesResultSet::decodeValue<T, true, Field>;
+        decoder.read_column = &RowBinaryWithNamesAndTypesResultSet::decodeValue<T, true, ColumnData>;
+    }
+    else {
+        decoder.read_field = &RowBinaryWithNamesAndTypesResultSet::decodeValue<T, false, Field>;
+        decoder.read_column = &RowBinaryWithNamesAndTypesResultSet::decodeValue<T, false, ColumnData>;
+    }
+
+    return decoder;
+}
+
+RowBinaryWithNamesAndTypesResultSet::ColumnDecoder RowBinaryWithNamesAndTypesResultSet::makeColumnDecoder(const ColumnInfo & column_info) {
     constexpr bool convert_on_fetch_conservatively = true;
 
     if (convert_on_fetch_conservatively) switch (column_info.type_without_parameters_id) {
-        case DataSourceTypeId::Date:        return readValueUsing( WireTypeDateAsInt       (column_info.timezone),                        dest, column_info);
-        case DataSourceTypeId::DateTime:    return readValueUsing( WireTypeDateTimeAsInt   (column_info.timezone),                        dest, column_info);
-        case DataSourceTypeId::DateTime64:  return readValueUsing( WireTypeDateTime64AsInt (column_info.precision, column_info.timezone), dest, column_info);
+        case DataSourceTypeId::Date:        return makeColumnDecoderFor<WireTypeDateAsInt                              >(column_info);
+        case DataSourceTypeId::DateTime:    return makeColumnDecoderFor<WireTypeDateTimeAsInt                          >(column_info);
+        case DataSourceTypeId::DateTime64:  return makeColumnDecoderFor<WireTypeDateTime64AsInt                        >(column_info);
         default:                            break; // Continue with the next complete switch...
     }
 
     switch (column_info.type_without_parameters_id) {
-        case DataSourceTypeId::Date:        return readValueAs<DataSourceType< DataSourceTypeId::Date        >>(dest, column_info);
-        case DataSourceTypeId::DateTime:    return readValueAs<DataSourceType< DataSourceTypeId::DateTime    >>(dest, column_info);
-        case DataSourceTypeId::DateTime64:  return readValueAs<DataSourceType< DataSourceTypeId::DateTime64  >>(dest, column_info);
-        case DataSourceTypeId::Decimal:     return readValueAs<DataSourceType< DataSourceTypeId::Decimal     >>(dest, column_info);
-        case DataSourceTypeId::Decimal32:   return readValueAs<DataSourceType< DataSourceTypeId::Decimal32   >>(dest, column_info);
-        case DataSourceTypeId::Decimal64:   return readValueAs<DataSourceType< DataSourceTypeId::Decimal64   >>(dest, column_info);
-        case DataSourceTypeId::Decimal128:  return readValueAs<DataSourceType< DataSourceTypeId::Decimal128  >>(dest, column_info);
-        case DataSourceTypeId::FixedString: return readValueAs<DataSourceType< DataSourceTypeId::FixedString >>(dest, column_info);
-        case DataSourceTypeId::Float32:     return readValueAs<DataSourceType< DataSourceTypeId::Float32     >>(dest, column_info);
-        case DataSourceTypeId::Float64:     return readValueAs<DataSourceType< DataSourceTypeId::Float64     >>(dest, column_info);
-        case DataSourceTypeId::Int8:        return readValueAs<DataSourceType< DataSourceTypeId::Int8        >>(dest, column_info);
-        case DataSourceTypeId::Int16:       return readValueAs<DataSourceType< DataSourceTypeId::Int16       >>(dest, column_info);
-        case DataSourceTypeId::Int32:       return readValueAs<DataSourceType< DataSourceTypeId::Int32       >>(dest, column_info);
-        case DataSourceTypeId::Int64:       return readValueAs<DataSourceType< DataSourceTypeId::Int64       >>(dest, column_info);
-        case DataSourceTypeId::Nothing:     return readValueAs<DataSourceType< DataSourceTypeId::Nothing     >>(dest, column_info);
-        case DataSourceTypeId::String:      return readValueAs<DataSourceType< DataSourceTypeId::String      >>(dest, column_info);
-        case DataSourceTypeId::UInt8:       return readValueAs<DataSourceType< DataSourceTypeId::UInt8       >>(dest, column_info);
-        case DataSourceTypeId::UInt16:      return readValueAs<DataSourceType< DataSourceTypeId::UInt16      >>(dest, column_info);
-        case DataSourceTypeId::UInt32:      return readValueAs<DataSourceType< DataSourceTypeId::UInt32      >>(dest, column_info);
-        case DataSourceTypeId::UInt64:      return readValueAs<DataSourceType< DataSourceTypeId::UInt64      >>(dest, column_info);
-        case DataSourceTypeId::UUID:        return readValueAs<DataSourceType< DataSourceTypeId::UUID        >>(dest, column_info);
-        default:                            throw std::runtime_error("Unable to decode value of type '" + column_info.type + "'");
+        case DataSourceTypeId::Date:        return makeColumnDecoderFor<DataSourceType< DataSourceTypeId::Date        >>(column_info);
+        case DataSourceTypeId::DateTime:    return makeColumnDecoderFor<DataSourceType< DataSourceTypeId::DateTime    >>(column_info);
+        case DataSourceTypeId::DateTime64:  return makeColumnDecoderFor<DataSourceType< DataSourceTypeId::DateTime64  >>(column_info);
+        case DataSourceTypeId::Decimal:     return makeColumnDecoderFor<DataSourceType< DataSourceTypeId::Decimal     >>(column_info);
+        case DataSourceTypeId::Decimal32:   return makeColumnDecoderFor<DataSourceType< DataSourceTypeId::Decimal32   >>(column_info);
+        case DataSourceTypeId::Decimal64:   return makeColumnDecoderFor<DataSourceType< DataSourceTypeId::Decimal64   >>(column_info);
+        case DataSourceTypeId::Decimal128:  return makeColumnDecoderFor<DataSourceType< DataSourceTypeId::Decimal128  >>(column_info);
+        case DataSourceTypeId::FixedString: return makeColumnDecoderFor<DataSourceType< DataSourceTypeId::FixedString >>(column_info);
+        case DataSourceTypeId::Float32:     return makeColumnDecoderFor<DataSourceType< DataSourceTypeId::Float32     >>(column_info);
+        case DataSourceTypeId::Float64:     return makeColumnDecoderFor<DataSourceType< DataSourceTypeId::Float64     >>(column_info);
+        case DataSourceTypeId::Int8:        return makeColumnDecoderFor<DataSourceType< DataSourceTypeId::Int8        >>(column_info);
+        case DataSourceTypeId::Int16:       return makeColumnDecoderFor<DataSourceType< DataSourceTypeId::Int16       >>(column_info);
+        case DataSourceTypeId::Int32:       return makeColumnDecoderFor<DataSourceType< DataSourceTypeId::Int32       >>(column_info);
+        case DataSourceTypeId::Int64:       return makeColumnDecoderFor<DataSourceType< DataSourceTypeId::Int64       >>(column_info);
+        case DataSourceTypeId::Int128:      return makeColumnDecoderFor<DataSourceType< DataSourceTypeId::Int128      >>(column_info);
+        case DataSourceTypeId::Int256:      return makeColumnDecoderFor<DataSourceType< DataSourceTypeId::Int256      >>(column_info);
+        case DataSourceTypeId::Nothing:     return makeColumnDecoderFor<DataSourceType< DataSourceTypeId::Nothing     >>(column_info);
+        case DataSourceTypeId::String:      return makeColumnDecoderFor<DataSourceType< DataSourceTypeId::String      >>(column_info);
+        case DataSourceTypeId::UInt8:       return makeColumnDecoderFor<DataSourceType< DataSourceTypeId::UInt8       >>(column_info);
+        case DataSourceTypeId::UInt16:      return makeColumnDecoderFor<DataSourceType< DataSourceTypeId::UInt16      >>(column_info);
+        case DataSourceTypeId::UInt32:      return makeColumnDecoderFor<DataSourceType< DataSourceTypeId::UInt32      >>(column_info);
+        case DataSourceTypeId::UInt64:      return makeColumnDecoderFor<DataSourceType< DataSourceTypeId::UInt64      >>(column_info);
+        case DataSourceTypeId::UInt128:     return makeColumnDecoderFor<DataSourceType< DataSourceTypeId::UInt128     >>(column_info);
+        case DataSourceTypeId::UInt256:     return makeColumnDecoderFor<DataSourceType< DataSourceTypeId::UInt256     >>(column_info);
+        case DataSourceTypeId::UUID:        return makeColumnDecoderFor<DataSourceType< DataSourceTypeId::UUID        >>(column_info);
+        default:                            return {&RowBinaryWithNamesAndTypesResultSet::decodeUnsupportedValue<Field>, &RowBinaryWithNamesAndTypesResultSet::decodeUnsupportedValue<ColumnData>};
     }
 }
 
+void RowBinaryWithNamesAndTypesResultSet::readValueUsing(DataSourceType<DataSourceTypeId::FixedString> && value, ColumnData & dest, ColumnInfo & column_info) {
+    const auto size = column_info.fixed_size;
+    stream.read(dest.pushString<DataSourceType<DataSourceTypeId::FixedString>>(size), size);
+
+    if (column_info.display_size_so_far < size)
+        column_info.display_size_so_far = size;
+}
+
+void RowBinaryWithNamesAndTypesResultSet::readValueUsing(DataSourceType<DataSourceTypeId::String> && value, ColumnData & dest, ColumnInfo & column_info) {
+    std::uint64_t size = 0;
+    readSize(size);
+    stream.read(dest.pushString<DataSourceType<DataSourceTypeId::String>>(size), size);
+
+    if (column_info.display_size_so_far < size)
+        column_info.display_size_so_far = size;
+}
+
 void RowBinaryWithNamesAndTypesResultSet::readValue(WireTypeDateAsInt & dest, ColumnInfo & column_info) {
     readPOD(dest.value);
 }
@@ -158,23 +223,32 @@ void RowBinaryWithNamesAndTypesResultSet::readValue(WireTypeDateTime64AsInt & de
 }
 
 void RowBinaryWithNamesAndTypesResultSet::readValue(DataSourceType<DataSourceTypeId::Date> & dest, ColumnInfo & column_info) {
-    WireTypeDateAsInt dest_raw(column_info.timezone);
+    WireTypeDateAsInt dest_raw;
     readValue(dest_raw, column_info);
     value_manip::from_value<decltype(dest_raw)>::template to_value<decltype(dest)>::convert(dest_raw, dest);
 }
 
 void RowBinaryWithNamesAndTypesResultSet::readValue(DataSourceType<DataSourceTypeId::DateTime> & dest, ColumnInfo & column_info) {
-    WireTypeDateTimeAsInt dest_raw(column_info.timezone);
+    WireTypeDateTimeAsInt dest_raw(*column_info.time_zone);
     readValue(dest_raw, column_info);
     value_manip::from_value<decltype(dest_raw)>::template to_value<decltype(dest)>::convert(dest_raw, dest);
 }
 
 void RowBinaryWithNamesAndTypesResultSet::readValue(DataSourceType<DataSourceTypeId::DateTime64> & dest, ColumnInfo & column_info) {
-    WireTypeDateTime64AsInt dest_raw(column_info.precision, column_info.timezone);
+    WireTypeDateTime64AsInt dest_raw(column_info.precision, *column_info.time_zone);
     readValue(dest_raw, column_info);
     value_manip::from_value<decltype(dest_raw)>::template to_value<decltype(dest)>::convert(dest_raw, dest);
 }
 
+void RowBinaryWithNamesAndTypesResultSet::readWideInteger(DataSourceType<DataSourceTypeId::Decimal> & dest, std::size_t size, bool is_signed, const ColumnInfo & column_info) {
+    char buffer[DataSourceType<DataSourceTypeId::Decimal>::ContainerIntType::byte_count];
+    stream.read(buffer, size);
+
+    dest.precision = column_info.precision;
+    dest.scale = column_info.scale;
+    dest.sign = (dest.value.assignLittleEndian(buffer, size, is_signed) ? 0 : 1);
+}
+
 void RowBinaryWithNamesAndTypesResultSet::readValue(DataSourceType<DataSourceTypeId::Decimal> & dest, ColumnInfo & column_info) {
     dest.precision = column_info.precision;
     dest.scale = column_info.scale;
@@ -205,8 +279,14 @@ void RowBinaryWithNamesAndTypesResultSet::readValue(DataSourceType<DataSourceTyp
             dest.value = value;
         }
     }
+    else if (dest.precision < 39) {
+        readWideInteger(dest, 16, true, column_info);
+    }
+    else if (dest.precision < 77) {
+        readWideInteger(dest, 32, true, column_info);
+    }
     else {
-        throw std::runtime_error("Unable to decode value of type 'Decimal' that is represented by 128-bit integer");
+        throw std::runtime_error("Unable to decode value of type 'Decimal' with precision " + std::to_string(dest.precision));
     }
 }
 
@@ -222,12 +302,23 @@ void RowBinaryWithNamesAndTypesResultSet::readValue(DataSourceType<DataSourceTyp
     return readValue(static_cast<DataSourceType<DataSourceTypeId::Decimal> &>(dest), column_info);
 }
 
-void RowBinaryWithNamesAndTypesResultSet::readValue(DataSourceType<DataSourceTypeId::FixedString> & dest, ColumnInfo & column_info) {
-    if (dest.value.capacity() <= initial_string_capacity_g) {
-        dest.value = string_pool.get();
-        value_manip::to_null(dest.value);
-    }
+void RowBinaryWithNamesAndTypesResultSet::readValue(DataSourceType<DataSourceTypeId::Int128> & dest, ColumnInfo & column_info) {
+    return readWideInteger(dest, 16, true, column_info);
+}
 
+void RowBinaryWithNamesAndTypesResultSet::readValue(DataSourceType<DataSourceTypeId::UInt128> & dest, ColumnInfo & column_info) {
+    return readWideInteger(dest, 16, false, column_info);
+}
+
+void RowBinaryWithNamesAndTypesResultSet::readValue(DataSourceType<DataSourceTypeId::Int256> & dest, ColumnInfo & column_info) {
+    return readWideInteger(dest, 32, true, column_info);
+}
+
+void RowBinaryWithNamesAndTypesResultSet::readValue(DataSourceType<DataSourceTypeId::UInt256> & dest, ColumnInfo & column_info) {
+    return readWideInteger(dest, 32, false, column_info);
+}
+
+void RowBinaryWithNamesAndTypesResultSet::readValue(DataSourceType<DataSourceTypeId::FixedString> & dest, ColumnInfo & column_info) {
     readValue(dest.value, column_info.fixed_size);
 
     if (column_info.display_size_so_far < dest.value.size())
@@ -263,11 +354,6 @@ void RowBinaryWithNamesAndTypesResultSet::readValue(DataSourceType<DataSourceTyp
 }
 
 void RowBinaryWithNamesAndTypesResultSet::readValue(DataSourceType<DataSourceTypeId::String> & dest, ColumnInfo & column_info) {
-    if (dest.value.capacity() <= initial_string_capacity_g) {
-        dest.value = string_pool.get();
-        value_manip::to_null(dest.value);
-    }
-
     readValue(dest.value);
 
     if (column_info.display_size_so_far < dest.value.size())
@@ -305,8 +391,8 @@ void RowBinaryWithNamesAndTypesResultSet::readValue(DataSourceType<DataSourceTyp
     std::copy(ptr, ptr + lengthof(dest.value.Data4), std::make_reverse_iterator(dest.value.Data4 + lengthof(dest.value.Data4)));
 }
 
-RowBinaryWithNamesAndTypesResultReader::RowBinaryWithNamesAndTypesResultReader(const std::string & timezone_, std::istream & raw_stream, std::unique_ptr<ResultMutator> && mutator)
-    : ResultReader(timezone_, raw_stream, std::move(mutator))
+RowBinaryWithNamesAndTypesResultReader::RowBinaryWithNamesAndTypesResultReader(const std::string & timezone_, std::istream & raw_stream, std::unique_ptr<ResultMutator> && mutator, std::size_t read_buffer_size)
+    : ResultReader(timezone_, raw_stream, std::move(mutator), read_buffer_size)
 {
     if (stream.eof())
         return;
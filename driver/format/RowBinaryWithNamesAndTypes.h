@@ -9,9 +9,10 @@ class RowBinaryWithNamesAndTypesResultSet
 {
 public:
     explicit RowBinaryWithNamesAndTypesResultSet(const std::string & timezone, AmortizedIStreamReader & stream, std::unique_ptr<ResultMutator> && mutator);
-    virtual ~RowBinaryWithNamesAndTypesResultSet() override = default;
+    virtual ~RowBinaryWithNamesAndTypesResultSet() override;
 
 protected:
+    virtual bool readNextRows(RowBlock & dest) override;
     virtual bool readNextRow(Row & row) override;
 
 private:
@@ -26,7 +27,36 @@ private:
         stream.read(reinterpret_cast<char *>(&dest), sizeof(T));
     }
 
-    void readValue(Field & dest, ColumnInfo & column_info);
+    // Reads a little-endian integer of size bytes into the Decimal representation, with the precision and scale of the column.
+    void readWideInteger(DataSourceType<DataSourceTypeId::Decimal> & dest, std::size_t size, bool is_signed, const ColumnInfo & column_info);
+
+    // Specialized functions that decode a value of a particular column, chosen once, when the header of the result set is parsed.
+    struct ColumnDecoder {
+        void (RowBinaryWithNamesAndTypesResultSet::*read_field)(Field & dest, ColumnInfo & column_info) = nullptr;
+        void (RowBinaryWithNamesAndTypesResultSet::*read_column)(ColumnData & dest, ColumnInfo & column_info) = nullptr;
+    };
+
+    static ColumnDecoder makeColumnDecoder(const ColumnInfo & column_info);
+
+    template <typename T>
+    static ColumnDecoder makeColumnDecoderFor(const ColumnInfo & column_info);
+
+    // Dest is either Field or ColumnData.
+    template <typename T, bool is_nullable, typename Dest>
+    void decodeValue(Dest & dest, ColumnInfo & column_info);
+
+    template <typename Dest>
+    void decodeUnsupportedValue(Dest & dest, ColumnInfo & column_info);
+
+    template <typename T>
+    static T makeValue(const ColumnInfo & column_info) {
+        if constexpr (std::is_same_v<T, WireTypeDateTimeAsInt>)
+            return T(*column_info.time_zone);
+        else if constexpr (std::is_same_v<T, WireTypeDateTime64AsInt>)
+            return T(column_info.precision, *column_info.time_zone);
+        else
+            return T();
+    }
 
     template <typename T>
     void readValueUsing(T && value, Field & dest, ColumnInfo & column_info) {
@@ -35,8 +65,18 @@ private:
     }
 
     template <typename T>
-    void readValueAs(Field & dest, ColumnInfo & column_info) {
-        return readValueUsing(T(), dest, column_info);
+    void readValueUsing(T && value, ColumnData & dest, ColumnInfo & column_info) {
+        readValue(value, column_info);
+        dest.push_back(std::forward<T>(value));
+    }
+
+    // String values are read directly into the storage of the column.
+    void readValueUsing(DataSourceType<DataSourceTypeId::FixedString> && value, ColumnData & dest, ColumnInfo & column_info);
+    void readValueUsing(DataSourceType<DataSourceTypeId::String> && value, ColumnData & dest, ColumnInfo & column_info);
+
+    template <typename T, typename Dest>
+    void readValueAs(Dest & dest, ColumnInfo & column_info) {
+        return readValueUsing(makeValue<T>(column_info), dest, column_info);
     }
 
     void readValue(WireTypeDateAsInt & dest, ColumnInfo & column_info);
@@ -57,25 +97,32 @@ private:
     void readValue(DataSourceType< DataSourceTypeId::Int16       > & dest, ColumnInfo & column_info);
     void readValue(DataSourceType< DataSourceTypeId::Int32       > & dest, ColumnInfo & column_info);
     void readValue(DataSourceType< DataSourceTypeId::Int64       > & dest, ColumnInfo & column_info);
+    void readValue(DataSourceType< DataSourceTypeId::Int128      > & dest, ColumnInfo & column_info);
+    void readValue(DataSourceType< DataSourceTypeId::Int256      > & dest, ColumnInfo & column_info);
     void readValue(DataSourceType< DataSourceTypeId::Nothing     > & dest, ColumnInfo & column_info);
     void readValue(DataSourceType< DataSourceTypeId::String      > & dest, ColumnInfo & column_info);
     void readValue(DataSourceType< DataSourceTypeId::UInt8       > & dest, ColumnInfo & column_info);
     void readValue(DataSourceType< DataSourceTypeId::UInt16      > & dest, ColumnInfo & column_info);
     void readValue(DataSourceType< DataSourceTypeId::UInt32      > & dest, ColumnInfo & column_info);
     void readValue(DataSourceType< DataSourceTypeId::UInt64      > & dest, ColumnInfo & column_info);
+    void readValue(DataSourceType< DataSourceTypeId::UInt128     > & dest, ColumnInfo & column_info);
+    void readValue(DataSourceType< DataSourceTypeId::UInt256     > & dest, ColumnInfo & column_info);
     void readValue(DataSourceType< DataSourceTypeId::UUID        > & dest, ColumnInfo & column_info);
 
     template <typename T>
     void readValue(T & dest, ColumnInfo & column_info) {
         throw std::runtime_error("Unable to decode value of type '" + column_info.type + "'");
     }
+
+private:
+    std::vector<ColumnDecoder> decoders;
 };
 
 class RowBinaryWithNamesAndTypesResultReader
     : public ResultReader
 {
 public:
-    explicit RowBinaryWithNamesAndTypesResultReader(const std::string & timezone, std::istream & raw_stream, std::unique_ptr<ResultMutator> && mutator);
+    explicit RowBinaryWithNamesAndTypesResultReader(const std::string & timezone, std::istream & raw_stream, std::unique_ptr<ResultMutator> && mutator, std::size_t read_buffer_size);
     virtual ~RowBinaryWithNamesAndTypesResultReader() override = default;
 
     virtual bool advanceToNextResultSet() override;
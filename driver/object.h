@@ -7,6 +7,7 @@
 
 #include <fstream>
 #include <memory>
+#include <mutex>
 
 class Object
     : public AttributeContainer
@@ -75,6 +76,19 @@ public:
         return *static_cast<Self *>(this);
     }
 
+    // The mutex that serializes the calls on this object, the one of the parent by default.
+    std::shared_ptr<std::recursive_mutex> getCallMutex() const noexcept {
+        return parent.getCallMutex();
+    }
+
+    // Called by Driver::call() around each serialized call on this object. Hidden by the objects that keep track of their calls,
+    // or refuse some of them, by throwing from onCallEnter().
+    void onCallEnter(bool async_capable) {
+    }
+
+    void onCallLeave() noexcept {
+    }
+
     void deallocateSelf() noexcept {
         parent.template deallocateChild<Self>(getHandle());
     }
@@ -102,6 +102,13 @@
 // Possible values for SQL_ASYNC_NOTIFICATION
 #    define SQL_ASYNC_NOTIFICATION_NOT_CAPABLE 0x00000000L
 #    define SQL_ASYNC_NOTIFICATION_CAPABLE 0x00000001L
+
+// Driver-only statement attributes, that are set by the driver manager for the notification mode of the asynchronous execution.
+#    if !defined(SQL_ATTR_ASYNC_STMT_NOTIFICATION_CALLBACK)
+#        define SQL_ATTR_ASYNC_STMT_NOTIFICATION_CALLBACK 30
+#        define SQL_ATTR_ASYNC_STMT_NOTIFICATION_CONTEXT 31
+typedef SQLRETURN (SQL_API * SQL_ASYNC_NOTIFICATION_CALLBACK)(SQLPOINTER pContext, int fLast);
+#    endif
 #endif // ODBCVER >= 0x0380
 
 #if defined(UNICODE)
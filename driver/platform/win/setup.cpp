@@ -80,6 +80,11 @@ void readDSNinfo(ConnInfo * ci, bool overwrite) {
     GET_CONFIG(driverlog,       INI_DRIVERLOG,       INI_DRIVERLOG_DEFAULT);
     GET_CONFIG(driverlogfile,   INI_DRIVERLOGFILE,   INI_DRIVERLOGFILE_DEFAULT);
     GET_CONFIG(auto_session_id, INI_AUTO_SESSION_ID, INI_AUTO_SESSION_ID_DEFAULT);
+    GET_CONFIG(compression, INI_COMPRESSION, INI_COMPRESSION_DEFAULT);
+    GET_CONFIG(request_compression, INI_REQUEST_COMPRESSION, INI_REQUEST_COMPRESSION_DEFAULT);
+    GET_CONFIG(background_fetch, INI_BACKGROUND_FETCH, INI_BACKGROUND_FETCH_DEFAULT);
+    GET_CONFIG(read_buffer_size, INI_READ_BUFFER_SIZE, INI_READ_BUFFER_SIZE_DEFAULT);
+    GET_CONFIG(session_pooling, INI_SESSION_POOLING, INI_SESSION_POOLING_DEFAULT);
 
 #undef GET_CONFIG
 }
@@ -122,6 +127,11 @@ void writeDSNinfo(const ConnInfo * ci) {
     WRITE_CONFIG(driverlog,       INI_DRIVERLOG);
     WRITE_CONFIG(driverlogfile,   INI_DRIVERLOGFILE);
     WRITE_CONFIG(auto_session_id, INI_AUTO_SESSION_ID);
+    WRITE_CONFIG(compression, INI_COMPRESSION);
+    WRITE_CONFIG(request_compression, INI_REQUEST_COMPRESSION);
+    WRITE_CONFIG(background_fetch, INI_BACKGROUND_FETCH);
+    WRITE_CONFIG(read_buffer_size, INI_READ_BUFFER_SIZE);
+    WRITE_CONFIG(session_pooling, INI_SESSION_POOLING);
 
 #undef WRITE_CONFIG
 }
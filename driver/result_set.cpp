@@ -1,9 +1,8 @@
 #include "driver/result_set.h"
+#include "driver/format/Native.h"
 #include "driver/format/ODBCDriver2.h"
 #include "driver/format/RowBinaryWithNamesAndTypes.h"
 
-const std::string::size_type initial_string_capacity_g = std::string{}.capacity();
-
 void ColumnInfo::assignTypeInfo(const TypeAst & ast, const std::string & default_timezone) {
     if (ast.meta == TypeAst::Terminal) {
         type_without_parameters = ast.name;
@@ -15,6 +14,7 @@ void ColumnInfo::assignTypeInfo(const TypeAst & ast, const std::string & default
 
                 precision = 0;
                 timezone = (ast.elements.size() == 1 ? ast.elements.front().name : default_timezone);
+                time_zone = &TimeZone::get(timezone);
 
                 break;
             }
@@ -25,6 +25,7 @@ void ColumnInfo::assignTypeInfo(const TypeAst & ast, const std::string & default
 
                 precision = ast.elements.front().size;
                 timezone = (ast.elements.size() == 2 ? ast.elements.back().name : default_timezone);
+                time_zone = &TimeZone::get(timezone);
 
                 if (precision < 0 || precision > 9)
                     throw std::runtime_error("Unexpected DateTime64 type specification syntax");
@@ -72,6 +73,25 @@ void ColumnInfo::assignTypeInfo(const TypeAst & ast, const std::string & default
                 break;
             }
 
+            case DataSourceTypeId::Int128:
+            case DataSourceTypeId::UInt128: {
+                precision = 39;
+                scale = 0;
+                break;
+            }
+
+            case DataSourceTypeId::Int256: {
+                precision = 77;
+                scale = 0;
+                break;
+            }
+
+            case DataSourceTypeId::UInt256: {
+                precision = 78;
+                scale = 0;
+                break;
+            }
+
             default: {
                 if (ast.elements.size() == 1)
                     fixed_size = ast.elements.front().size;
@@ -84,6 +104,10 @@ void ColumnInfo::assignTypeInfo(const TypeAst & ast, const std::string & default
         is_nullable = true;
         assignTypeInfo(ast.elements.front(), default_timezone);
     }
+    else if (ast.meta == TypeAst::LowCardinality) {
+        is_low_cardinality = true;
+        assignTypeInfo(ast.elements.front(), default_timezone);
+    }
     else {
         // Interpret all types with unrecognized ASTs as String.
         type_without_parameters = "String";
@@ -122,27 +146,451 @@ void ColumnInfo::updateTypeInfo() {
     }
 }
 
-ResultSet::ResultSet(AmortizedIStreamReader & str, std::unique_ptr<ResultMutator> && mutator)
-    : stream(str)
-    , result_mutator(std::move(mutator))
-    , string_pool(1000000)
-    , row_pool(1000000)
-{
+namespace {
+
+    template <typename T>
+    inline auto takeValue(std::vector<T> & typed_values, std::size_t pos) {
+        return std::move(typed_values[pos]);
+    }
+
+    template <typename T>
+    inline auto takeValue(StringColumnValues<T> & typed_values, std::size_t pos) {
+        return typed_values.materialize(pos);
+    }
+
+    template <typename T>
+    inline auto takeValue(LowCardinalityColumnValues<T> & typed_values, std::size_t pos) {
+        return typed_values.materialize(pos);
+    }
+
+    template <typename T>
+    inline void eraseFront(std::vector<T> & typed_values, std::size_t count) {
+        typed_values.erase(typed_values.begin(), typed_values.begin() + count);
+    }
+
+    template <typename T>
+    inline void eraseFront(StringColumnValues<T> & typed_values, std::size_t count) {
+        typed_values.eraseFront(count);
+    }
+
+    template <typename T>
+    inline void eraseFront(LowCardinalityColumnValues<T> & typed_values, std::size_t count) {
+        typed_values.eraseFront(count);
+    }
+
+    template <typename T>
+    inline void appendFrom(std::vector<T> & typed_values, std::vector<T> & other_values, std::size_t pos) {
+        typed_values.insert(typed_values.end(), std::make_move_iterator(other_values.begin() + pos), std::make_move_iterator(other_values.end()));
+    }
+
+    template <typename T>
+    inline void appendFrom(StringColumnValues<T> & typed_values, StringColumnValues<T> & other_values, std::size_t pos) {
+        typed_values.append(other_values, pos);
+    }
+
+    template <typename T>
+    inline void appendFrom(LowCardinalityColumnValues<T> & typed_values, LowCardinalityColumnValues<T> & other_values, std::size_t pos) {
+        typed_values.append(other_values, pos);
+    }
+
+} // namespace
+
+std::size_t ColumnData::size() const {
+    return total - first;
+}
+
+bool ColumnData::isNull(std::size_t idx) const {
+    return isNullAt(first + idx);
+}
+
+void ColumnData::push_back(Field && field) {
+    std::visit([&] (auto && value) {
+        push_back(std::move(value));
+    }, field.data);
+}
+
+void ColumnData::pushNull() {
+    if (nulls.empty())
+        nulls.resize(total, false);
+
+    nulls.push_back(true);
+
+    std::visit([&] (auto & typed_values) {
+        using ValuesVectorType = std::decay_t<decltype(typed_values)>;
+
+        if constexpr (!std::is_same_v<ValuesVectorType, std::monostate>) {
+            using ValueType = typename ValuesVectorType::value_type;
+
+            if constexpr (std::is_default_constructible_v<ValueType>)
+                typed_values.emplace_back();
+            else
+                typed_values.push_back(std::get<ValueType>(null_filler.data));
+        }
+    }, values);
+
+    ++total;
+}
+
+void ColumnData::moveTo(std::size_t idx, Field & dest) {
+    const auto pos = first + idx;
+
+    if (isNullAt(pos)) {
+        dest.data = DataSourceType<DataSourceTypeId::Nothing>{};
+        return;
+    }
+
+    std::visit([&] (auto & typed_values) {
+        using ValuesVectorType = std::decay_t<decltype(typed_values)>;
+
+        if constexpr (std::is_same_v<ValuesVectorType, std::monostate>)
+            dest.data = DataSourceType<DataSourceTypeId::Nothing>{};
+        else if constexpr (std::is_same_v<ValuesVectorType, std::vector<Field>>)
+            dest.data = std::move(typed_values[pos].data);
+        else
+            dest.data = takeValue(typed_values, pos);
+    }, values);
+}
+
+void ColumnData::retire(std::size_t count) {
+    const auto new_first = std::min(first + count, total);
+
+    std::visit([&] (auto & typed_values) {
+        using ValuesVectorType = std::decay_t<decltype(typed_values)>;
+
+        if constexpr (!std::is_same_v<ValuesVectorType, std::monostate>) {
+            // Physically remove the retired values only when they make up at least half of the storage,
+            // which keeps the cost of retiring amortized constant per value. The capacity is kept for the upcoming values.
+            if (new_first == total) {
+                typed_values.clear();
+            }
+            else if (new_first * 2 >= total) {
+                eraseFront(typed_values, new_first);
+            }
+        }
+    }, values);
+
+    if (new_first == total) {
+        nulls.clear();
+        total = 0;
+        first = 0;
+    }
+    else if (new_first * 2 >= total) {
+        if (!nulls.empty())
+            nulls.erase(nulls.begin(), nulls.begin() + new_first);
+
+        total -= new_first;
+        first = 0;
+    }
+    else {
+        first = new_first;
+    }
 }
 
-ResultSet::~ResultSet() {
-    while (!row_set.empty()) {
-        retireRow(std::move(row_set.front()));
-        row_set.pop_front();
+void ColumnData::append(ColumnData & other) {
+    const auto count = other.size();
+
+    if (count == 0)
+        return;
+
+    if (size() == 0) {
+        retire(0); // Make sure the retired values, if any, are physically removed, so that other receives an empty storage.
+        std::swap(*this, other);
+        return;
     }
 
-    while (!prefetched_rows.empty()) {
-        retireRow(std::move(prefetched_rows.front()));
-        prefetched_rows.pop_front();
+    // Values of the same type are appended in bulk, everything else goes value by value.
+    const bool appended = std::visit([&] (auto & typed_values) {
+        using ValuesVectorType = std::decay_t<decltype(typed_values)>;
+
+        if constexpr (
+            !std::is_same_v<ValuesVectorType, std::monostate> &&
+            !std::is_same_v<ValuesVectorType, std::vector<Field>>
+        ) {
+            if (auto * other_values = std::get_if<ValuesVectorType>(&other.values)) {
+                appendFrom(typed_values, *other_values, other.first);
+                return true;
+            }
+        }
+
+        return false;
+    }, values);
+
+    if (appended) {
+        if (!nulls.empty() || !other.nulls.empty()) {
+            if (nulls.empty())
+                nulls.resize(total, false);
+
+            if (other.nulls.empty())
+                nulls.resize(total + count, false);
+            else
+                nulls.insert(nulls.end(), other.nulls.begin() + other.first, other.nulls.end());
+        }
+
+        total += count;
     }
+    else {
+        Field field;
+        for (std::size_t i = 0; i < count; ++i) {
+            other.moveTo(i, field);
+            push_back(std::move(field));
+        }
+    }
+
+    other.retire(count);
+}
+
+void ColumnData::fallBackToFields() {
+    std::vector<Field> fields(total);
+
+    std::visit([&] (auto & typed_values) {
+        using ValuesVectorType = std::decay_t<decltype(typed_values)>;
+
+        if constexpr (
+            !std::is_same_v<ValuesVectorType, std::monostate> &&
+            !std::is_same_v<ValuesVectorType, std::vector<Field>>
+        ) {
+            for (std::size_t pos = first; pos < total; ++pos) {
+                if (!isNullAt(pos))
+                    fields[pos].data = takeValue(typed_values, pos);
+            }
+        }
+    }, values);
+
+    values = std::move(fields);
+}
+
+template <std::size_t ValuesIdx, typename BufferType>
+SQLRETURN ColumnData::extractAs(const ColumnData & column, std::size_t pos, BindingInfo & binding_info, DefaultConversionContext & context) {
+    using ValuesVectorType = std::variant_alternative_t<ValuesIdx, ValuesType>;
+
+    if constexpr (std::is_same_v<ValuesVectorType, std::monostate>) {
+        return fillOutputNULL(binding_info.value, binding_info.value_max_size, binding_info.indicator);
+    }
+    else {
+        const auto & typed_values = *std::get_if<ValuesIdx>(&column.values);
+
+        if constexpr (std::is_same_v<ValuesVectorType, std::vector<Field>>) {
+            // The values are of different types, so they have to be dispatched one by one.
+            return typed_values[pos].extract(binding_info, context);
+        }
+        else if constexpr (std::is_same_v<typename ValuesVectorType::value_type, DataSourceType<DataSourceTypeId::Nothing>>) {
+            return fillOutputNULL(binding_info.value, binding_info.value_max_size, binding_info.indicator);
+        }
+        else if constexpr (std::is_void_v<BufferType>) {
+            throw std::runtime_error("Unable to write data into bound buffer: destination type representation not supported");
+        }
+        else if constexpr (std::is_same_v<ValuesVectorType, LowCardinalityColumnValues<typename ValuesVectorType::value_type>>) {
+            if constexpr (std::is_same_v<BufferType, char *>)
+                return writeConvertedStringTo(typed_values.template getConverted<char>(pos, context), binding_info);
+            else if constexpr (std::is_same_v<BufferType, char16_t *>)
+                return writeConvertedStringTo(typed_values.template getConverted<char16_t>(pos, context), binding_info);
+            else
+                return writeDataAs<BufferType>(typed_values.materialize(pos), binding_info, context);
+        }
+        else if constexpr (std::is_same_v<ValuesVectorType, StringColumnValues<typename ValuesVectorType::value_type>>) {
+            if constexpr (std::is_same_v<BufferType, char *> || std::is_same_v<BufferType, char16_t *>)
+                return writeDataAs<BufferType>(typed_values[pos], binding_info, context);
+            else
+                return writeDataAs<BufferType>(typed_values.materialize(pos), binding_info, context);
+        }
+        else {
+            return writeDataAs<BufferType>(typed_values[pos], binding_info, context);
+        }
+    }
+}
+
+template <std::size_t ValuesIdx, std::size_t... BufferTypeIdxs>
+constexpr std::array<ColumnData::Extractor, writable_buffer_type_count + 1> ColumnData::makeExtractorRow(std::index_sequence<BufferTypeIdxs...>) {
+    return {
+        &extractAs<ValuesIdx, std::tuple_element_t<BufferTypeIdxs, WritableBufferTypes>>...,
+        &extractAs<ValuesIdx, void>
+    };
+}
+
+template <std::size_t... ValuesIdxs>
+constexpr std::array<std::array<ColumnData::Extractor, writable_buffer_type_count + 1>, sizeof...(ValuesIdxs)> ColumnData::makeExtractorTable(std::index_sequence<ValuesIdxs...>) {
+    return {
+        makeExtractorRow<ValuesIdxs>(std::make_index_sequence<writable_buffer_type_count>{})...
+    };
+}
+
+ColumnData::Extractor ColumnData::getExtractor(SQLSMALLINT c_type) const {
+    // Indexed by the representation of the stored values, and by the representation of the C type.
+    static constexpr auto extractors = makeExtractorTable(std::make_index_sequence<std::variant_size_v<ValuesType>>{});
+
+    return extractors[values.index()][getWritableBufferTypeIndex(c_type)];
+}
+
+SQLRETURN ColumnData::extract(std::size_t idx, Extractor extractor, BindingInfo & binding_info, DefaultConversionContext & context) const {
+    const auto pos = first + idx;
+
+    if (isNullAt(pos))
+        return fillOutputNULL(binding_info.value, binding_info.value_max_size, binding_info.indicator);
+
+    return extractor(*this, pos, binding_info, context);
+}
+
+SQLRETURN ColumnData::extract(std::size_t idx, BindingInfo & binding_info, DefaultConversionContext & context) const {
+    return extract(idx, getExtractor(binding_info.c_type), binding_info, context);
+}
+
+bool ColumnData::copyValuesTo(std::size_t idx, std::size_t count, SQLSMALLINT c_type, void * dest, std::size_t stride) const {
+    if (c_type == SQL_C_BIT) // Shares the representation with SQL_C_UTINYINT, but only 0 and 1 are valid values.
+        return false;
+
+    return std::visit([&] (auto & typed_values) {
+        using ValuesVectorType = std::decay_t<decltype(typed_values)>;
+
+        if constexpr (!std::is_same_v<ValuesVectorType, std::monostate>) {
+            using ValueType = typename ValuesVectorType::value_type;
+
+            if constexpr (
+                std::is_same_v<ValuesVectorType, std::vector<ValueType>> &&
+                requires { requires std::is_arithmetic_v<decltype(ValueType::value)>; }
+            ) {
+                using RawType = decltype(ValueType::value);
+
+                // Only the plain numbers, not the wire types, whose values have to be interpreted.
+                if constexpr (
+                    std::is_base_of_v<SimpleTypeWrapper<RawType>, ValueType> &&
+                    sizeof(ValueType) == sizeof(RawType)
+                ) {
+                    if (
+                        stride == sizeof(RawType) &&
+                        getWritableBufferTypeIndex(c_type) == getWritableBufferTypeIndex<RawType>()
+                    ) {
+                        if (count > 0)
+                            std::memcpy(dest, typed_values.data() + first + idx, count * sizeof(RawType));
+
+                        return true;
+                    }
+                }
+            }
+        }
+
+        return false;
+    }, values);
+}
+
+template <typename CharType>
+bool ColumnData::extractString(std::size_t idx, std::basic_string<CharType> & dest, DefaultConversionContext & context) const {
+    const auto pos = first + idx;
+
+    if (isNullAt(pos))
+        return false;
+
+    const auto assign = [&] (std::basic_string<CharType> && converted) {
+        context.string_pool.retireString(std::move(dest));
+        dest = std::move(converted);
+        return true;
+    };
+
+    return std::visit([&] (auto & typed_values) {
+        using ValuesVectorType = std::decay_t<decltype(typed_values)>;
+
+        if constexpr (std::is_same_v<ValuesVectorType, std::monostate>) {
+            return false;
+        }
+        else if constexpr (std::is_same_v<ValuesVectorType, std::vector<Field>>) {
+            return std::visit([&] (auto & value) {
+                if constexpr (std::is_same_v<std::decay_t<decltype(value)>, DataSourceType<DataSourceTypeId::Nothing>>)
+                    return false;
+                else
+                    return assign(convertDataToString<CharType>(value, context));
+            }, typed_values[pos].data);
+        }
+        else if constexpr (std::is_same_v<typename ValuesVectorType::value_type, DataSourceType<DataSourceTypeId::Nothing>>) {
+            return false;
+        }
+        else if constexpr (std::is_same_v<ValuesVectorType, LowCardinalityColumnValues<typename ValuesVectorType::value_type>>) {
+            dest.assign(typed_values.template getConverted<CharType>(pos, context));
+            return true;
+        }
+        else {
+            return assign(convertDataToString<CharType>(typed_values[pos], context));
+        }
+    }, values);
 }
 
+void RowBlock::reset(std::size_t num_columns) {
+    columns.clear();
+    columns.resize(num_columns);
+}
+
+std::size_t RowBlock::size() const {
+    return (columns.empty() ? 0 : columns.front().size());
+}
+
+std::size_t RowBlock::getColumnCount() const {
+    return columns.size();
+}
+
+ColumnData & RowBlock::getColumn(std::size_t column_idx) {
+    return columns.at(column_idx);
+}
+
+void RowBlock::appendRow(Row & row) {
+    if (row.fields.size() != columns.size())
+        throw std::runtime_error("Unexpected number of values in a row");
+
+    for (std::size_t i = 0; i < columns.size(); ++i) {
+        columns[i].push_back(std::move(row.fields[i]));
+    }
+}
+
+void RowBlock::moveFirstRowTo(Row & row) {
+    row.fields.resize(columns.size());
+
+    for (std::size_t i = 0; i < columns.size(); ++i) {
+        columns[i].moveTo(0, row.fields[i]);
+    }
+
+    retire(1);
+}
+
+void RowBlock::retire(std::size_t count) {
+    for (auto & column : columns) {
+        column.retire(count);
+    }
+}
+
+void RowBlock::append(RowBlock & other) {
+    if (other.columns.size() != columns.size())
+        throw std::runtime_error("Unexpected number of columns in a block of rows");
+
+    for (std::size_t i = 0; i < columns.size(); ++i) {
+        columns[i].append(other.columns[i]);
+    }
+}
+
+ColumnData::Extractor RowBlock::getExtractor(std::size_t column_idx, SQLSMALLINT c_type) const {
+    if (column_idx >= columns.size())
+        throw SqlException("Invalid descriptor index", "07009");
+
+    return columns[column_idx].getExtractor(c_type);
+}
+
+SQLRETURN RowBlock::extractField(std::size_t row_idx, std::size_t column_idx, ColumnData::Extractor extractor, BindingInfo & binding_info, DefaultConversionContext & context) const {
+    return columns[column_idx].extract(row_idx, extractor, binding_info, context);
+}
+
+SQLRETURN RowBlock::extractField(std::size_t row_idx, std::size_t column_idx, BindingInfo & binding_info, DefaultConversionContext & context) const {
+    if (column_idx >= columns.size())
+        throw SqlException("Invalid descriptor index", "07009");
+
+    return columns[column_idx].extract(row_idx, binding_info, context);
+}
+
+ResultSet::ResultSet(AmortizedIStreamReader & str, std::unique_ptr<ResultMutator> && mutator)
+    : stream(str)
+    , result_mutator(std::move(mutator))
+{
+}
+
+ResultSet::~ResultSet() = default;
+
 std::unique_ptr<ResultMutator> ResultSet::releaseMutator() {
+    stopBackgroundReading();
     return std::move(result_mutator);
 }
 
@@ -157,31 +605,30 @@ std::size_t ResultSet::fetchRowSet(SQLSMALLINT orientation, SQLLEN offset, std::
     if (orientation != SQL_FETCH_NEXT)
         throw SqlException("Fetch type out of range", "HY106");
 
-    while (!row_set.empty()) {
-        retireRow(std::move(row_set.front()));
-        row_set.pop_front();
-        ++row_set_position;
+    partial_read.active = false;
+
+    if (row_set_size > 0) {
+        rows.retire(row_set_size);
+        row_set_position += row_set_size;
+        row_set_size = 0;
     }
 
-    if (prefetched_rows.size() < size) {
+    if (rows.size() < size) {
         constexpr std::size_t prefetch_at_least = 100;
         tryPrefetchRows(std::max(size, prefetch_at_least));
     }
 
-    for (std::size_t i = 0; i < size && !prefetched_rows.empty(); ++i) {
-        row_set.emplace_back(std::move(prefetched_rows.front()));
-        prefetched_rows.pop_front();
-        ++affected_row_count;
-    }
+    row_set_size = std::min(size, rows.size());
+    affected_row_count += row_set_size;
 
-    if (row_set.empty())
+    if (row_set_size == 0)
         row_set_position = 0;
     else if (row_set_position == 0)
         row_set_position = 1;
 
     row_position = row_set_position;
 
-    return row_set.size();
+    return row_set_size;
 }
 
 std::size_t ResultSet::getColumnCount() const {
@@ -189,7 +636,7 @@ std::size_t ResultSet::getColumnCount() const {
 }
 
 std::size_t ResultSet::getCurrentRowSetSize() const {
-    return row_set.size();
+    return row_set_size;
 }
 
 std::size_t ResultSet::getCurrentRowSetPosition() const {
@@ -197,7 +644,7 @@ std::size_t ResultSet::getCurrentRowSetPosition() const {
 }
 
 std::size_t ResultSet::getCurrentRowPosition() const {
-    if (row_position < row_set_position || row_position >= (row_set_position + row_set.size()))
+    if (row_position < row_set_position || row_position >= (row_set_position + row_set_size))
         return 0;
 
     return row_position;
@@ -208,24 +655,142 @@ std::size_t ResultSet::getAffectedRowCount() const {
 }
 
 SQLRETURN ResultSet::extractField(std::size_t row_idx, std::size_t column_idx, BindingInfo & binding_info) {
-    if (row_idx >= row_set.size())
+    if (row_idx >= row_set_size)
         throw SqlException("Invalid cursor position", "HY109");
 
-    return row_set[row_idx].extractField(column_idx, binding_info, conversion_context);
+    return rows.extractField(row_idx, column_idx, binding_info, conversion_context);
 }
 
-void ResultSet::tryPrefetchRows(std::size_t size) {
-    while (!finished && prefetched_rows.size() < size) {
-        prefetched_rows.emplace_back(row_pool.get());
+ColumnData::Extractor ResultSet::getExtractor(std::size_t column_idx, SQLSMALLINT c_type) const {
+    return rows.getExtractor(column_idx, c_type);
+}
+
+SQLRETURN ResultSet::extractField(std::size_t row_idx, std::size_t column_idx, ColumnData::Extractor extractor, BindingInfo & binding_info) {
+    if (row_idx >= row_set_size)
+        throw SqlException("Invalid cursor position", "HY109");
+
+    return rows.extractField(row_idx, column_idx, extractor, binding_info, conversion_context);
+}
+
+SQLRETURN ResultSet::getData(std::size_t row_idx, std::size_t column_idx, BindingInfo & binding_info) {
+    if (row_idx >= row_set_size)
+        throw SqlException("Invalid cursor position", "HY109");
+
+    if (column_idx >= rows.getColumnCount())
+        throw SqlException("Invalid descriptor index", "07009");
+
+    auto & state = partial_read;
+
+    if (
+        !state.active ||
+        state.row_idx != row_idx ||
+        state.column_idx != column_idx ||
+        state.c_type != binding_info.c_type
+    ) {
+        state.active = true;
+        state.done = false;
+        state.row_idx = row_idx;
+        state.column_idx = column_idx;
+        state.c_type = binding_info.c_type;
+        state.offset = 0;
+
+        const auto & column = rows.getColumn(column_idx);
+        bool is_null = false;
+
+        switch (binding_info.c_type) {
+            case SQL_C_CHAR:
+            case SQL_C_BINARY:
+                is_null = !column.extractString(row_idx, state.value, conversion_context);
+                break;
+
+            case SQL_C_WCHAR:
+                is_null = !column.extractString(row_idx, state.value_wide, conversion_context);
+                break;
+
+            default:
+                // Values of the other types are always returned entirely, by the first call.
+                state.done = true;
+                return rows.extractField(row_idx, column_idx, binding_info, conversion_context);
+        }
+
+        if (is_null) {
+            state.done = true;
+            return fillOutputNULL(binding_info.value, binding_info.value_max_size, binding_info.indicator);
+        }
+    }
+    else if (state.done) {
+        return SQL_NO_DATA;
+    }
+
+    if (binding_info.c_type == SQL_C_WCHAR)
+        return writeNextPiece(state.value_wide, true, binding_info);
+    else
+        return writeNextPiece(state.value, (binding_info.c_type == SQL_C_CHAR), binding_info);
+}
+
+template <typename CharType>
+SQLRETURN ResultSet::writeNextPiece(const std::basic_string<CharType> & value, bool ensure_nts, BindingInfo & binding_info) {
+    auto & state = partial_read;
+
+    validateOutputStringBuffer<CharType>(binding_info.value, binding_info.value_max_size, true);
 
-        auto & row = prefetched_rows.back();
-        row.fields.resize(columns_info.size());
+    if (binding_info.indicator && binding_info.indicator != binding_info.value_size)
+        *binding_info.indicator = 0; // (Null) indicator pointer of the binding. Value is not null here so we store 0 in it.
 
-        const auto result_set_not_finished = readNextRow(row);
+    const auto rest = std::basic_string_view<CharType>(value).substr(state.offset);
+    fillOutputConvertedStringInternal<CharType>(rest, binding_info.value, binding_info.value_max_size, binding_info.value_size, true, ensure_nts);
 
-        if (!result_set_not_finished) {
-            retireRow(std::move(row));
-            prefetched_rows.pop_back();
+    const std::size_t max_symbols = ((binding_info.value && binding_info.value_max_size > 0) ? binding_info.value_max_size / sizeof(CharType) : 0);
+    const std::size_t capacity = ((ensure_nts && max_symbols > 0) ? max_symbols - 1 : max_symbols); // ...leaving room for null terminating character.
+
+    if (rest.size() <= capacity) {
+        state.done = true;
+        return SQL_SUCCESS;
+    }
+
+    state.offset += capacity;
+    throw SqlException("String data, right truncated", "01004", SQL_SUCCESS_WITH_INFO);
+}
+
+bool ResultSet::extractColumn(std::size_t column_idx, BindingInfo & binding_info) {
+    if (column_idx >= rows.getColumnCount())
+        throw SqlException("Invalid descriptor index", "07009");
+
+    if (!binding_info.value || binding_info.value_max_size < 0)
+        return false;
+
+    const auto & column = rows.getColumn(column_idx);
+
+    if (!column.copyValuesTo(0, row_set_size, binding_info.c_type, binding_info.value, binding_info.value_max_size))
+        return false;
+
+    const SQLLEN value_size = binding_info.value_max_size;
+
+    for (std::size_t row_idx = 0; row_idx < row_set_size; ++row_idx) {
+        auto * indicator = (binding_info.indicator ? binding_info.indicator + row_idx : nullptr);
+        auto * size = (binding_info.value_size ? binding_info.value_size + row_idx : nullptr);
+
+        if (column.isNull(row_idx)) {
+            fillOutputNULL(nullptr, 0, indicator);
+        }
+        else {
+            if (indicator && indicator != size)
+                *indicator = 0; // (Null) indicator pointer of the binding. Value is not null here so we store 0 in it.
+
+            if (size)
+                *size = value_size;
+        }
+    }
+
+    return true;
+}
+
+void ResultSet::tryPrefetchRows(std::size_t size) {
+    if (rows.getColumnCount() != columns_info.size())
+        rows.reset(columns_info.size());
+
+    while (!finished && rows.size() < size) {
+        if (!(background ? readNextRowsFromBackground(rows) : readNextRows(rows))) {
 
             // Adjust display_size of columns, if not set already, according to display_size_so_far.
             for (std::size_t i = 0; i < columns_info.size(); ++i) {
@@ -248,62 +813,153 @@ void ResultSet::tryPrefetchRows(std::size_t size) {
             finished = true;
             break;
         }
-
-        if (result_mutator)
-            result_mutator->transformRow(columns_info, row);
     }
 }
 
-namespace {
+bool ResultSet::readNextRows(RowBlock & dest) {
+    row_buffer.fields.resize(columns_info.size());
 
-    // Using these instead of simple "if constexpr" to workaround VS2017 behavior.
+    if (!readNextRow(row_buffer))
+        return false;
 
-    template <typename T>
-    inline void maybe_recycle(ObjectPool<std::string> & string_pool, T & obj,
-        std::enable_if_t<
-            std::is_same_v<std::string, T>
-        >* = 0
-    ) {
-        if (obj.capacity() > initial_string_capacity_g)
-            string_pool.put(std::move(obj));
+    if (result_mutator)
+        result_mutator->transformRow(columns_info, row_buffer);
+
+    dest.appendRow(row_buffer);
+
+    return true;
+}
+
+void ResultSet::startBackgroundReading(std::size_t max_queued_blocks) {
+    if (background || finished || max_queued_blocks == 0)
+        return;
+
+    background = std::make_unique<BackgroundReading>();
+    background->max_queued_blocks = max_queued_blocks;
+    background->thread = std::thread([this] { readInBackground(); });
+}
+
+bool ResultSet::isReadingInBackground() const {
+    if (!background)
+        return false;
+
+    std::lock_guard<std::mutex> lock(background->mutex);
+    return !background->finished;
+}
+
+void ResultSet::stopBackgroundReading() {
+    if (!background)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(background->mutex);
+        background->stop = true;
     }
 
-    template <typename T>
-    inline void maybe_recycle(ObjectPool<std::string> & string_pool, T & obj,
-        std::enable_if_t<
-            is_string_data_source_type_v<T>
-        >* = 0
-    ) {
-        if (obj.value.capacity() > initial_string_capacity_g)
-            string_pool.put(std::move(obj.value));
+    background->cv.notify_all();
+
+    // The row that is being read at the moment, if any, is read completely before the thread notices the request.
+    if (background->thread.joinable())
+        background->thread.join();
+
+    background.reset();
+}
+
+void ResultSet::readInBackground() {
+    // Rows are handed over to the consumer in blocks of at least this size (unless the result set ends earlier),
+    // to keep the synchronization cost low for the formats that decode rows one by one.
+    constexpr std::size_t min_block_size = 1000;
+
+    try {
+        bool has_more = true;
+
+        while (has_more) {
+            RowBlock block;
+
+            {
+                std::unique_lock<std::mutex> lock(background->mutex);
+                background->cv.wait(lock, [this] {
+                    return (background->stop || background->ready_blocks.size() < background->max_queued_blocks);
+                });
+
+                if (background->stop)
+                    return;
+
+                if (!background->free_blocks.empty()) {
+                    block = std::move(background->free_blocks.back());
+                    background->free_blocks.pop_back();
+                }
+            }
+
+            if (block.getColumnCount() != columns_info.size())
+                block.reset(columns_info.size());
+
+            while (block.size() < min_block_size && !background->stop) {
+                if (!readNextRows(block)) {
+                    has_more = false;
+                    break;
+                }
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(background->mutex);
+
+                if (block.size() > 0)
+                    background->ready_blocks.push_back(std::move(block));
+
+                background->finished = !has_more;
+            }
+
+            background->cv.notify_all();
+        }
     }
+    catch (...) {
+        {
+            std::lock_guard<std::mutex> lock(background->mutex);
+            background->exception = std::current_exception();
+            background->finished = true;
+        }
 
-    template <typename T>
-    inline void maybe_recycle(ObjectPool<std::string> & string_pool, T & obj,
-        std::enable_if_t<
-            !std::is_same_v<std::string, T> &&
-            !is_string_data_source_type_v<T>
-        >* = 0
-    ) {
-        // Do nothing;
+        background->cv.notify_all();
     }
+}
 
-} // namespace
+bool ResultSet::readNextRowsFromBackground(RowBlock & dest) {
+    RowBlock block;
+
+    {
+        std::unique_lock<std::mutex> lock(background->mutex);
+        background->cv.wait(lock, [this] {
+            return (!background->ready_blocks.empty() || background->finished);
+        });
 
-void ResultSet::retireRow(Row && row) {
-    for (auto & field : row.fields) {
-        if (!field.data.valueless_by_exception()) {
-            std::visit([&] (auto & value) {
-                maybe_recycle(string_pool, value);
-            }, field.data);
+        if (background->ready_blocks.empty()) {
+            if (background->exception)
+                std::rethrow_exception(std::exchange(background->exception, nullptr));
+
+            return false;
         }
+
+        block = std::move(background->ready_blocks.front());
+        background->ready_blocks.pop_front();
     }
-    row_pool.put(std::move(row));
+
+    background->cv.notify_all();
+
+    // When dest is empty, this just swaps the storage of the blocks, otherwise the rows are moved.
+    dest.append(block);
+
+    {
+        std::lock_guard<std::mutex> lock(background->mutex);
+        background->free_blocks.push_back(std::move(block));
+    }
+
+    return true;
 }
 
-ResultReader::ResultReader(const std::string & timezone_, std::istream & raw_stream, std::unique_ptr<ResultMutator> && mutator)
+ResultReader::ResultReader(const std::string & timezone_, std::istream & raw_stream, std::unique_ptr<ResultMutator> && mutator, std::size_t read_buffer_size)
     : timezone(timezone_)
-    , stream(raw_stream)
+    , stream(raw_stream, read_buffer_size)
     , result_mutator(std::move(mutator))
 {
 }
@@ -323,15 +979,21 @@ std::unique_ptr<ResultMutator> ResultReader::releaseMutator() {
     return std::move(result_mutator);
 }
 
-std::unique_ptr<ResultReader> make_result_reader(const std::string & format, const std::string & timezone, std::istream & raw_stream, std::unique_ptr<ResultMutator> && mutator) {
+std::unique_ptr<ResultReader> make_result_reader(const std::string & format, const std::string & timezone, std::istream & raw_stream, std::unique_ptr<ResultMutator> && mutator, std::size_t read_buffer_size) {
     if (format == "ODBCDriver2") {
-        return std::make_unique<ODBCDriver2ResultReader>(timezone, raw_stream, std::move(mutator));
+        return std::make_unique<ODBCDriver2ResultReader>(timezone, raw_stream, std::move(mutator), read_buffer_size);
     }
     else if (format == "RowBinaryWithNamesAndTypes") {
         if (!isLittleEndian())
             throw std::runtime_error("'" + format + "' format is supported only on little-endian platforms");
 
-        return std::make_unique<RowBinaryWithNamesAndTypesResultReader>(timezone, raw_stream, std::move(mutator));
+        return std::make_unique<RowBinaryWithNamesAndTypesResultReader>(timezone, raw_stream, std::move(mutator), read_buffer_size);
+    }
+    else if (format == "Native") {
+        if (!isLittleEndian())
+            throw std::runtime_error("'" + format + "' format is supported only on little-endian platforms");
+
+        return std::make_unique<NativeResultReader>(timezone, raw_stream, std::move(mutator), read_buffer_size);
     }
 
     throw std::runtime_error("'" + format + "' format is not supported");
@@ -2,19 +2,30 @@
 
 #include "driver/platform/platform.h"
 #include "driver/utils/utils.h"
-#include "driver/utils/object_pool.h"
+#include "driver/utils/resize_without_initialization.h"
 #include "driver/utils/amortized_istream_reader.h"
 #include "driver/utils/type_parser.h"
 #include "driver/utils/type_info.h"
 
+#include <array>
+#include <atomic>
+#include <condition_variable>
 #include <deque>
+#include <exception>
 #include <iostream>
+#include <limits>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
 #include <variant>
 #include <vector>
 
-extern const std::string::size_type initial_string_capacity_g;
+#include <cstring>
+
 
 class ColumnInfo {
 public:
@@ -32,7 +43,9 @@ public:
     std::size_t precision = 0;
     std::size_t scale = 0;
     bool is_nullable = false;
+    bool is_low_cardinality = false;
     std::string timezone;
+    const TimeZone * time_zone = nullptr; // Resolved timezone, for DateTime and DateTime64 types.
 };
 
 class Field {
@@ -52,12 +65,16 @@ public:
         DataSourceType< DataSourceTypeId::Int16       >,
         DataSourceType< DataSourceTypeId::Int32       >,
         DataSourceType< DataSourceTypeId::Int64       >,
+        DataSourceType< DataSourceTypeId::Int128      >,
+        DataSourceType< DataSourceTypeId::Int256      >,
         DataSourceType< DataSourceTypeId::Nothing     >, // ...used for storing Null.
         DataSourceType< DataSourceTypeId::String      >,
         DataSourceType< DataSourceTypeId::UInt8       >,
         DataSourceType< DataSourceTypeId::UInt16      >,
         DataSourceType< DataSourceTypeId::UInt32      >,
         DataSourceType< DataSourceTypeId::UInt64      >,
+        DataSourceType< DataSourceTypeId::UInt128     >,
+        DataSourceType< DataSourceTypeId::UInt256     >,
         DataSourceType< DataSourceTypeId::UUID        >,
 
         // In case we approach value conversion conservatively...
@@ -76,11 +93,416 @@ public:
 
 class Row {
 public:
-    template <typename ConversionContext>
-    SQLRETURN extractField(std::size_t column_idx, BindingInfo & binding_info, ConversionContext && context) const;
+    std::vector<Field> fields;
+};
 
+// Values of string types of a single column, stored back to back in a contiguous arena, that is owned by the column,
+// so that storing a value doesn't require an allocation of its own. Mimics the relevant subset of std::vector interface.
+template <typename T>
+class StringColumnValues {
 public:
-    std::vector<Field> fields;
+    using value_type = T;
+
+    std::size_t size() const {
+        return ends.size();
+    }
+
+    std::string_view operator[] (std::size_t pos) const {
+        const auto begin = (pos == 0 ? 0 : ends[pos - 1]);
+        return std::string_view{arena.data() + begin, ends[pos] - begin};
+    }
+
+    // Append a value of the given size, that must be written to the returned buffer.
+    char * append(std::size_t size) {
+        const auto begin = arena.size();
+        resize_without_initialization(arena, begin + size);
+        ends.push_back(arena.size());
+        return arena.data() + begin;
+    }
+
+    void push_back(const std::string_view & value) {
+        std::memcpy(append(value.size()), value.data(), value.size());
+    }
+
+    void push_back(const T & value) {
+        push_back(make_string_view(value.value));
+    }
+
+    void emplace_back() {
+        ends.push_back(arena.size());
+    }
+
+    void resize(std::size_t count) {
+        ends.resize(count, arena.size());
+    }
+
+    void clear() {
+        arena.clear();
+        ends.clear();
+    }
+
+    // Remove the first count values.
+    void eraseFront(std::size_t count) {
+        if (count == 0)
+            return;
+
+        const auto erased_size = ends[count - 1];
+        arena.erase(0, erased_size);
+        ends.erase(ends.begin(), ends.begin() + count);
+
+        for (auto & end : ends) {
+            end -= erased_size;
+        }
+    }
+
+    // Append the values of other, starting from the value at pos.
+    void append(const StringColumnValues & other, std::size_t pos) {
+        const auto begin = (pos == 0 ? 0 : other.ends[pos - 1]);
+        const auto shift = arena.size();
+
+        arena.append(other.arena, begin);
+
+        for (auto it = other.ends.begin() + pos; it != other.ends.end(); ++it) {
+            ends.push_back(*it - begin + shift);
+        }
+    }
+
+    T materialize(std::size_t pos) const {
+        return T{std::string{(*this)[pos]}};
+    }
+
+private:
+    std::string arena;
+    std::vector<std::size_t> ends; // End offset of each value in the arena, the value starts where the previous one ends.
+};
+
+// Values of LowCardinality string types of a single column. Each value is stored as an index of a key in the dictionary,
+// that is received along with the values. Conversions of the keys to the encodings of the application are cached,
+// so that the value that is repeated in many rows is converted only once. Mimics the relevant subset of std::vector interface.
+template <typename T>
+class LowCardinalityColumnValues {
+public:
+    using value_type = T;
+
+    std::size_t size() const {
+        return indexes.size();
+    }
+
+    std::string_view operator[] (std::size_t pos) const {
+        return keys[indexes[pos]];
+    }
+
+    std::size_t getKeyCount() const {
+        return keys.size();
+    }
+
+    // Append a key of the given size, that must be written to the returned buffer.
+    char * appendKey(std::size_t size) {
+        return keys.append(size);
+    }
+
+    // Append a value, that refers to the key at key_pos.
+    void pushIndex(std::size_t key_pos) {
+        if (key_pos >= keys.size())
+            throw std::runtime_error("LowCardinality index is out of range of the dictionary");
+
+        indexes.push_back(key_pos);
+    }
+
+    void push_back(const std::string_view & value) {
+        indexes.push_back(keys.size());
+        keys.push_back(value);
+    }
+
+    void push_back(const T & value) {
+        push_back(make_string_view(value.value));
+    }
+
+    void emplace_back() {
+        indexes.push_back(getEmptyKey());
+    }
+
+    void resize(std::size_t count) {
+        indexes.resize(count, (count > indexes.size() ? getEmptyKey() : 0));
+    }
+
+    void clear() {
+        keys.clear();
+        indexes.clear();
+        converted_keys.clear();
+        converted_keys_wide.clear();
+        empty_key.reset();
+    }
+
+    // Remove the first count values. The keys that are no longer referenced are dropped once they dominate the dictionary.
+    void eraseFront(std::size_t count) {
+        indexes.erase(indexes.begin(), indexes.begin() + count);
+
+        if (keys.size() > indexes.size() * 2 + 16)
+            compact();
+    }
+
+    // Append the values of other, starting from the value at pos, along with the whole dictionary of other.
+    void append(LowCardinalityColumnValues & other, std::size_t pos) {
+        const auto shift = keys.size();
+
+        appendCache(converted_keys, other.converted_keys, other.keys.size());
+        appendCache(converted_keys_wide, other.converted_keys_wide, other.keys.size());
+        keys.append(other.keys, 0);
+
+        for (auto it = other.indexes.begin() + pos; it != other.indexes.end(); ++it) {
+            indexes.push_back(*it + shift);
+        }
+
+        if (!empty_key && other.empty_key)
+            empty_key = *other.empty_key + shift;
+    }
+
+    T materialize(std::size_t pos) const {
+        return keys.materialize(indexes[pos]);
+    }
+
+    // The value at pos, converted to the encoding of the application, that is used for CharType.
+    template <typename CharType, typename ConversionContext>
+    std::basic_string_view<CharType> getConverted(std::size_t pos, ConversionContext && context) const {
+        auto & cache = getCache<CharType>();
+        const auto key_pos = indexes[pos];
+
+        if (cache.size() <= key_pos)
+            cache.resize(keys.size());
+
+        auto & converted = cache[key_pos];
+        if (!converted)
+            converted = fromUTF8<CharType>(keys[key_pos], context);
+
+        return *converted;
+    }
+
+private:
+    template <typename CharType>
+    using CacheType = std::vector<std::optional<std::basic_string<CharType>>>;
+
+    template <typename CharType>
+    CacheType<CharType> & getCache() const {
+        if constexpr (std::is_same_v<CharType, char>)
+            return converted_keys;
+        else
+            return converted_keys_wide;
+    }
+
+    template <typename CharType>
+    void appendCache(CacheType<CharType> & cache, CacheType<CharType> & other_cache, std::size_t other_key_count) {
+        if (cache.empty() && other_cache.empty())
+            return;
+
+        cache.resize(keys.size());
+        cache.insert(cache.end(), std::make_move_iterator(other_cache.begin()), std::make_move_iterator(other_cache.end()));
+        cache.resize(keys.size() + other_key_count);
+    }
+
+    std::size_t getEmptyKey() {
+        if (!empty_key) {
+            empty_key = keys.size();
+            keys.emplace_back();
+        }
+
+        return *empty_key;
+    }
+
+    // Rebuild the dictionary so that it contains only the keys that are referenced by the values.
+    void compact() {
+        constexpr auto unused = std::numeric_limits<std::size_t>::max();
+        std::vector<std::size_t> new_positions(keys.size(), unused);
+
+        StringColumnValues<T> new_keys;
+        CacheType<char> new_converted_keys;
+        CacheType<char16_t> new_converted_keys_wide;
+
+        for (auto & index : indexes) {
+            auto & new_pos = new_positions[index];
+
+            if (new_pos == unused) {
+                new_pos = new_keys.size();
+                new_keys.push_back(keys[index]);
+
+                if (index < converted_keys.size()) {
+                    new_converted_keys.resize(new_pos);
+                    new_converted_keys.push_back(std::move(converted_keys[index]));
+                }
+
+                if (index < converted_keys_wide.size()) {
+                    new_converted_keys_wide.resize(new_pos);
+                    new_converted_keys_wide.push_back(std::move(converted_keys_wide[index]));
+                }
+            }
+
+            index = new_pos;
+        }
+
+        if (empty_key)
+            empty_key = (new_positions[*empty_key] == unused ? std::nullopt : std::optional<std::size_t>{new_positions[*empty_key]});
+
+        keys = std::move(new_keys);
+        converted_keys = std::move(new_converted_keys);
+        converted_keys_wide = std::move(new_converted_keys_wide);
+    }
+
+private:
+    StringColumnValues<T> keys;                   // The dictionary.
+    std::vector<std::size_t> indexes;             // Position of the key of each value in the dictionary.
+    std::optional<std::size_t> empty_key;         // Position of the empty key, used for filling null slots, if it has been stored.
+    mutable CacheType<char> converted_keys;       // Lazily converted keys, for SQL_C_CHAR and SQL_C_BINARY.
+    mutable CacheType<char16_t> converted_keys_wide; // Lazily converted keys, for SQL_C_WCHAR.
+};
+
+template <typename T>
+struct ColumnValuesFor {
+    using type = std::vector<T>;
+};
+
+template <>
+struct ColumnValuesFor<DataSourceType<DataSourceTypeId::FixedString>> {
+    using type = StringColumnValues<DataSourceType<DataSourceTypeId::FixedString>>;
+};
+
+template <>
+struct ColumnValuesFor<DataSourceType<DataSourceTypeId::String>> {
+    using type = StringColumnValues<DataSourceType<DataSourceTypeId::String>>;
+};
+
+template <>
+struct ColumnValuesFor<WireTypeAnyAsString> {
+    using type = StringColumnValues<WireTypeAnyAsString>;
+};
+
+template <typename T>
+using ColumnValuesType = typename ColumnValuesFor<T>::type;
+
+template <typename DataType> struct TypedColumnValues; // Leave unimplemented for general case.
+
+template <typename... Types>
+struct TypedColumnValues<std::variant<Types...>> {
+    // std::monostate - no non-null values stored yet,
+    // std::vector<Field> - values of different types have been stored, so the column has fallen back to the generic representation.
+    // LowCardinalityColumnValues<...> - values of a LowCardinality string column, that are kept dictionary-encoded.
+    using type = std::variant<
+        std::monostate,
+        ColumnValuesType<Types>...,
+        LowCardinalityColumnValues<DataSourceType<DataSourceTypeId::FixedString>>,
+        LowCardinalityColumnValues<DataSourceType<DataSourceTypeId::String>>,
+        std::vector<Field>
+    >;
+};
+
+// Values of a single column of consecutive rows, stored in a typed array, that is chosen by the type of the first non-null value.
+// Nulls are tracked separately, in a bitmap. Values of a column that come in more than one type fall back to generic Fields.
+class ColumnData {
+public:
+    using ValuesType = typename TypedColumnValues<Field::DataType>::type;
+
+    std::size_t size() const;
+    bool isNull(std::size_t idx) const;
+
+    template <typename T>
+    void push_back(T && value);
+
+    void push_back(Field && field);
+    void pushNull();
+
+    // Append a value of string type T of the given size, that must be written to the returned buffer.
+    template <typename T>
+    char * pushString(std::size_t size);
+
+    // Prepare for storing the values of LowCardinality string type T, whose keys are then appended to the returned dictionary
+    // directly. Returns nullptr if the values stored so far can't be extended this way.
+    template <typename T>
+    LowCardinalityColumnValues<T> * getLowCardinalityValues();
+
+    // Append a value of LowCardinality string type T, that refers to the key at key_pos of the dictionary.
+    template <typename T>
+    void pushKey(std::size_t key_pos);
+
+    // Move the value out into a field. idx is relative to the first live value.
+    void moveTo(std::size_t idx, Field & dest);
+
+    // Discard the first count live values.
+    void retire(std::size_t count);
+
+    // Move all the live values of other to the end. other is left empty, but keeps its storage for reuse.
+    void append(ColumnData & other);
+
+    // Writes the value at the given position (counting the retired ones too) into the binding. Each extractor is specialized for
+    // a particular representation of the stored values, and a particular C type of the binding, so that no dispatching is done per value.
+    using Extractor = SQLRETURN (*)(const ColumnData & column, std::size_t pos, BindingInfo & binding_info, DefaultConversionContext & context);
+
+    // Resolve the extractor for bindings of the given C type. Since it depends on the representation of the values stored so far,
+    // it stays valid only until more values are added.
+    Extractor getExtractor(SQLSMALLINT c_type) const;
+
+    SQLRETURN extract(std::size_t idx, Extractor extractor, BindingInfo & binding_info, DefaultConversionContext & context) const;
+    SQLRETURN extract(std::size_t idx, BindingInfo & binding_info, DefaultConversionContext & context) const;
+
+    // If the values are stored in the same binary layout as the C type, copy count of them, starting at idx, into the array at dest,
+    // whose elements are stride bytes apart, and return true. The slots of the nulls get unspecified values.
+    // Otherwise, return false without copying anything.
+    bool copyValuesTo(std::size_t idx, std::size_t count, SQLSMALLINT c_type, void * dest, std::size_t stride) const;
+
+    // Convert the value to the string, that would be written into a binding of SQL_C_CHAR/SQL_C_BINARY (for CharType == char)
+    // or SQL_C_WCHAR (for CharType == char16_t). Returns false, and leaves dest intact, for nulls.
+    template <typename CharType>
+    bool extractString(std::size_t idx, std::basic_string<CharType> & dest, DefaultConversionContext & context) const;
+
+private:
+    // BufferType is one of WritableBufferTypes, or void for the C types that values can't be written to.
+    template <std::size_t ValuesIdx, typename BufferType>
+    static SQLRETURN extractAs(const ColumnData & column, std::size_t pos, BindingInfo & binding_info, DefaultConversionContext & context);
+
+    template <std::size_t ValuesIdx, std::size_t... BufferTypeIdxs>
+    static constexpr std::array<Extractor, writable_buffer_type_count + 1> makeExtractorRow(std::index_sequence<BufferTypeIdxs...>);
+
+    template <std::size_t... ValuesIdxs>
+    static constexpr std::array<std::array<Extractor, writable_buffer_type_count + 1>, sizeof...(ValuesIdxs)> makeExtractorTable(std::index_sequence<ValuesIdxs...>);
+
+    bool isNullAt(std::size_t pos) const {
+        return (!nulls.empty() && nulls[pos]);
+    }
+
+    template <typename T>
+    void pushFirstOrMismatched(T && value);
+
+    void fallBackToFields();
+
+private:
+    ValuesType values;
+    std::vector<bool> nulls;   // Stays empty until the first null is stored.
+    Field null_filler;         // A copy of the first value, for filling null slots of types that are not default-constructible.
+    std::size_t first = 0;     // Position of the first live value, all the values before it are retired.
+    std::size_t total = 0;     // Number of stored values, including the retired ones.
+};
+
+// A block of rows stored column-wise.
+class RowBlock {
+public:
+    void reset(std::size_t num_columns);
+
+    std::size_t size() const;
+    std::size_t getColumnCount() const;
+    ColumnData & getColumn(std::size_t column_idx);
+
+    void appendRow(Row & row); // Values are moved out of the row.
+    void moveFirstRowTo(Row & row);
+    void retire(std::size_t count);
+
+    // Move all the rows of other to the end. other is left empty, but keeps its storage for reuse.
+    void append(RowBlock & other);
+
+    ColumnData::Extractor getExtractor(std::size_t column_idx, SQLSMALLINT c_type) const;
+
+    SQLRETURN extractField(std::size_t row_idx, std::size_t column_idx, ColumnData::Extractor extractor, BindingInfo & binding_info, DefaultConversionContext & context) const;
+    SQLRETURN extractField(std::size_t row_idx, std::size_t column_idx, BindingInfo & binding_info, DefaultConversionContext & context) const;
+
+private:
+    std::vector<ColumnData> columns;
 };
 
 class ResultMutator {
@@ -111,30 +533,91 @@ public:
     // row_idx - row index within the row set.
     SQLRETURN extractField(std::size_t row_idx, std::size_t column_idx, BindingInfo & binding_info);
 
+    // Resolve the extractor of the values of the column into bindings of the given C type, for fetching many values of it
+    // without resolving the conversion each time. Stays valid until the next fetchRowSet() call.
+    ColumnData::Extractor getExtractor(std::size_t column_idx, SQLSMALLINT c_type) const;
+
+    SQLRETURN extractField(std::size_t row_idx, std::size_t column_idx, ColumnData::Extractor extractor, BindingInfo & binding_info);
+
+    // Write the values of the column of the entire row set into the arrays of the column-wise binding in one go, bypassing the conversion,
+    // if they are stored in the same binary layout as the C type of the binding. Returns false and writes nothing, if this is not possible.
+    bool extractColumn(std::size_t column_idx, BindingInfo & binding_info);
+
+    // Same as extractField(), but with the semantics of SQLGetData: character and binary values are returned in pieces,
+    // that fit into the buffer, by consecutive calls for the same field, and SQL_NO_DATA is returned once the value is returned entirely.
+    SQLRETURN getData(std::size_t row_idx, std::size_t column_idx, BindingInfo & binding_info);
+
+    // Start reading and decoding the upcoming rows in a background thread, keeping at most max_queued_blocks blocks of them ready.
+    void startBackgroundReading(std::size_t max_queued_blocks);
+
+    // Whether the background thread may still read from the stream, i.e., whether it has been started and hasn't reached the end yet.
+    bool isReadingInBackground() const;
+
 protected:
+    // Must be called by the destructors of the derived classes, since the background thread uses their readNextRows().
+    void stopBackgroundReading();
+
     void tryPrefetchRows(std::size_t size);
-    void retireRow(Row && row);
+
+    // Read at least one more row and append it to dest. Returns false if there are no more rows.
+    // The default implementation reads rows one by one using readNextRow() and applies the result mutator to them.
+    virtual bool readNextRows(RowBlock & dest);
 
     virtual bool readNextRow(Row & row) = 0;
 
+private:
+    void readInBackground();
+    bool readNextRowsFromBackground(RowBlock & dest);
+
+    template <typename CharType>
+    SQLRETURN writeNextPiece(const std::basic_string<CharType> & value, bool ensure_nts, BindingInfo & binding_info);
+
 protected:
     AmortizedIStreamReader & stream;
     std::unique_ptr<ResultMutator> result_mutator;
     DefaultConversionContext conversion_context;
     std::vector<ColumnInfo> columns_info;
-    std::deque<Row> row_set;
+    RowBlock rows;                    // The current row set, followed by the prefetched rows.
+    std::size_t row_set_size = 0;     // Number of rows at the beginning of rows, that form the current row set.
     std::size_t row_set_position = 0; // 1-based. 1 means the first row of the row set is the first row of the entire result set.
     std::size_t row_position = 0;     // 1-based. 1 means positioned at the first row of the entire result set.
     std::size_t affected_row_count = 0;
-    std::deque<Row> prefetched_rows;
     bool finished = false;
-    ObjectPool<std::string> string_pool;
-    ObjectPool<Row> row_pool;
+    Row row_buffer;                   // Reused for reading rows one by one.
+
+private:
+    // Field, that is being returned by getData() in pieces. Its value is converted only once, by the first call.
+    struct PartialRead {
+        bool active = false;
+        bool done = false;
+        std::size_t row_idx = 0;
+        std::size_t column_idx = 0;
+        SQLSMALLINT c_type = SQL_C_DEFAULT;
+        std::size_t offset = 0; // In symbols of the converted value.
+        std::string value;
+        std::basic_string<char16_t> value_wide;
+    };
+
+    PartialRead partial_read;
+
+    struct BackgroundReading {
+        std::thread thread;
+        mutable std::mutex mutex;
+        std::condition_variable cv;
+        std::deque<RowBlock> ready_blocks; // Decoded by the background thread, not consumed yet.
+        std::vector<RowBlock> free_blocks; // Consumed, returned to the background thread for reuse.
+        std::size_t max_queued_blocks = 0;
+        std::atomic<bool> stop = false;
+        bool finished = false;
+        std::exception_ptr exception;
+    };
+
+    std::unique_ptr<BackgroundReading> background;
 };
 
 class ResultReader {
 protected:
-    explicit ResultReader(const std::string & timezone_, std::istream & stream, std::unique_ptr<ResultMutator> && mutator);
+    explicit ResultReader(const std::string & timezone_, std::istream & stream, std::unique_ptr<ResultMutator> && mutator, std::size_t read_buffer_size);
 
 public:
     virtual ~ResultReader() = default;
@@ -153,7 +636,8 @@ protected:
     std::unique_ptr<ResultSet> result_set;
 };
 
-std::unique_ptr<ResultReader> make_result_reader(const std::string & format, const std::string & timezone, std::istream & raw_stream, std::unique_ptr<ResultMutator> && mutator);
+// read_buffer_size - min number of bytes requested from raw_stream at once, also the size starting from which the values are read bypassing the buffer.
+std::unique_ptr<ResultReader> make_result_reader(const std::string & format, const std::string & timezone, std::istream & raw_stream, std::unique_ptr<ResultMutator> && mutator, std::size_t read_buffer_size);
 
 template <typename ConversionContext>
 SQLRETURN Field::extract(BindingInfo & binding_info, ConversionContext && context) const {
@@ -167,10 +651,100 @@ SQLRETURN Field::extract(BindingInfo & binding_info, ConversionContext && contex
     }, data);
 }
 
-template <typename ConversionContext>
-SQLRETURN Row::extractField(std::size_t column_idx, BindingInfo & binding_info, ConversionContext && context) const {
-    if (column_idx >= fields.size())
-        throw SqlException("Invalid descriptor index", "07009");
+template <typename T>
+void ColumnData::push_back(T && value) {
+    using ValueType = std::decay_t<T>;
+
+    if constexpr (std::is_same_v<ValueType, DataSourceType<DataSourceTypeId::Nothing>>) {
+        return pushNull();
+    }
+    else {
+        if (auto * typed_values = std::get_if<ColumnValuesType<ValueType>>(&values)) {
+            typed_values->push_back(std::forward<T>(value));
+        }
+        else {
+            pushFirstOrMismatched(std::forward<T>(value));
+        }
+
+        if (!nulls.empty())
+            nulls.push_back(false);
+
+        ++total;
+    }
+}
+
+template <typename T>
+void ColumnData::pushFirstOrMismatched(T && value) {
+    using ValueType = std::decay_t<T>;
+
+    if (std::holds_alternative<std::monostate>(values)) {
+        auto & typed_values = values.template emplace<ColumnValuesType<ValueType>>();
+
+        // Fill the slots of the nulls stored so far.
+        if constexpr (std::is_default_constructible_v<ValueType>) {
+            typed_values.resize(total);
+        }
+        else {
+            null_filler.data = value;
+            typed_values.resize(total, value);
+        }
+
+        typed_values.push_back(std::forward<T>(value));
+    }
+    else {
+        if (!std::holds_alternative<std::vector<Field>>(values))
+            fallBackToFields();
+
+        auto & fields = std::get<std::vector<Field>>(values);
+        fields.emplace_back();
+        fields.back().data = std::forward<T>(value);
+    }
+}
+
+template <typename T>
+char * ColumnData::pushString(std::size_t size) {
+    if (std::holds_alternative<std::monostate>(values))
+        values.template emplace<ColumnValuesType<T>>().resize(total);
+
+    char * buffer = nullptr;
+
+    if (auto * typed_values = std::get_if<ColumnValuesType<T>>(&values)) {
+        buffer = typed_values->append(size);
+    }
+    else {
+        if (!std::holds_alternative<std::vector<Field>>(values))
+            fallBackToFields();
+
+        auto & fields = std::get<std::vector<Field>>(values);
+        fields.emplace_back();
+
+        auto & value = fields.back().data.template emplace<T>();
+        resize_without_initialization(value.value, size);
+        buffer = value.value.data();
+    }
+
+    if (!nulls.empty())
+        nulls.push_back(false);
+
+    ++total;
+
+    return buffer;
+}
+
+template <typename T>
+LowCardinalityColumnValues<T> * ColumnData::getLowCardinalityValues() {
+    if (std::holds_alternative<std::monostate>(values))
+        values.template emplace<LowCardinalityColumnValues<T>>().resize(total);
+
+    return std::get_if<LowCardinalityColumnValues<T>>(&values);
+}
+
+template <typename T>
+void ColumnData::pushKey(std::size_t key_pos) {
+    std::get<LowCardinalityColumnValues<T>>(values).pushIndex(key_pos);
+
+    if (!nulls.empty())
+        nulls.push_back(false);
 
-    return fields[column_idx].extract(binding_info, std::forward<ConversionContext>(context));
+    ++total;
 }
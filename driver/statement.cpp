@@ -1,19 +1,273 @@
 #include "driver/platform/platform.h"
 #include "driver/utils/utils.h"
+#include "driver/utils/compression.h"
+#include "driver/utils/socket_watcher.h"
 #include "driver/escaping/lexer.h"
 #include "driver/escaping/escape_sequences.h"
 #include "driver/statement.h"
 
 #include <Poco/Exception.h>
 #include <Poco/Net/HTTPClientSession.h>
-#include <Poco/Net/HTTPRequest.h>
-#include <Poco/Timezone.h>
-#include <Poco/URI.h>
-#include <Poco/UUID.h>
+#include <Poco/Net/MessageHeader.h>
+#include <Poco/Net/SocketDefs.h>
 #include <Poco/UUIDGenerator.h>
 
+#include <algorithm>
 #include <cctype>
 #include <cstdio>
+#include <cstring>
+#include <initializer_list>
+#include <limits>
+
+namespace {
+
+bool isDataAtExecParam(const ParamBindingInfo & binding_info) {
+    const auto * ind_ptr = (binding_info.indicator ? binding_info.indicator : binding_info.value_size);
+    return (ind_ptr && (*ind_ptr == SQL_DATA_AT_EXEC || *ind_ptr <= SQL_LEN_DATA_AT_EXEC_OFFSET));
+}
+
+bool hasDataAtExecParams(const std::vector<ParamBindingInfo> & param_bindings) {
+    return std::any_of(param_bindings.begin(), param_bindings.end(), isDataAtExecParam);
+}
+
+// Returns the ClickHouse type, as which the value of the bound parameter is parsed by the server.
+std::string getParamDataSourceType(const ParamBindingInfo & binding_info, bool force_nullable) {
+    BoundTypeInfo type_info;
+    type_info.c_type = binding_info.c_type;
+    type_info.sql_type = binding_info.sql_type;
+    type_info.value_max_size = binding_info.value_max_size;
+    type_info.precision = binding_info.precision;
+    type_info.scale = binding_info.scale;
+    type_info.is_nullable = (force_nullable || binding_info.is_nullable || binding_info.value == nullptr);
+
+    return convertSQLOrCTypeToDataSourceType(type_info);
+}
+
+// Length of the longest prefix of the UTF-8 string, that doesn't end in the middle of a character.
+std::size_t getCompleteUTF8Length(const std::string & str) {
+    for (std::size_t i = 1; i <= std::min<std::size_t>(str.size(), 4); ++i) {
+        const auto ch = static_cast<unsigned char>(str[str.size() - i]);
+
+        if ((ch & 0b11000000) == 0b10000000) // ...a continuation byte [10xxxxxx], keep looking for the leading one.
+            continue;
+
+        std::size_t char_size = 1;
+        if ((ch & 0b11100000) == 0b11000000)
+            char_size = 2;
+        else if ((ch & 0b11110000) == 0b11100000)
+            char_size = 3;
+        else if ((ch & 0b11111000) == 0b11110000)
+            char_size = 4;
+
+        return (char_size > i ? str.size() - i : str.size());
+    }
+
+    return str.size();
+}
+
+bool startsWithKeyword(const std::string & str, std::size_t pos, const std::string & keyword) {
+    if (str.size() < pos + keyword.size())
+        return false;
+
+    for (std::size_t i = 0; i < keyword.size(); ++i) {
+        if (std::toupper(static_cast<unsigned char>(str[pos + i])) != keyword[i])
+            return false;
+    }
+
+    const auto end = pos + keyword.size();
+    return (end == str.size() || !(std::isalnum(static_cast<unsigned char>(str[end])) || str[end] == '_'));
+}
+
+// Appends the value as a field of TabSeparated format, escaping it so that it is read back exactly as is.
+void appendTSVField(std::string & dest, const std::string & value) {
+    for (const auto ch : value) {
+        switch (ch) {
+            case '\\': dest += "\\\\"; break;
+            case '\t': dest += "\\t";  break;
+            case '\n': dest += "\\n";  break;
+            case '\r': dest += "\\r";  break;
+            case '\0': dest += "\\0";  break;
+            default:   dest += ch;     break;
+        }
+    }
+}
+
+// Returns the position of the first of the keywords, that is neither quoted, nor nested in parentheses, at or after pos,
+// query.size(), if there is none, or npos, if the parentheses are unbalanced.
+std::size_t findTopLevelKeyword(const std::string & query, std::size_t pos, std::initializer_list<const char *> keywords) {
+    const auto is_word = [] (char ch) { return (std::isalnum(static_cast<unsigned char>(ch)) || ch == '_'); };
+
+    std::size_t depth = 0;
+    char quoted_by = '\0';
+    for (; pos < query.size(); ++pos) {
+        const char curr = query[pos];
+
+        if (quoted_by != '\0') {
+            if (curr == '\\')
+                ++pos;
+            else if (curr == quoted_by)
+                quoted_by = '\0';
+        }
+        else if (curr == '\'' || curr == '"' || curr == '`') {
+            quoted_by = curr;
+        }
+        else if (curr == '(') {
+            ++depth;
+        }
+        else if (curr == ')') {
+            if (depth == 0)
+                return std::string::npos;
+            --depth;
+        }
+        else if (depth == 0 && (pos == 0 || !(is_word(query[pos - 1]) || query[pos - 1] == '.'))) {
+            for (const auto * keyword : keywords) {
+                if (startsWithKeyword(query, pos, keyword))
+                    return pos;
+            }
+        }
+    }
+
+    return (depth == 0 ? query.size() : std::string::npos);
+}
+
+// Returns the INSERT INTO table [(columns)] part of the query, if all the parameter sets of the query can be inserted by one request.
+// Only the simplest form is recognized: INSERT ... VALUES (?, ..., ?), where each parameter is used once, in order, as a bare value.
+std::string makeBatchInsertQuery(const std::string & query, const std::vector<ParamInfo> & parameters) {
+    if (parameters.empty())
+        return std::string{};
+
+    const auto begin = query.find_first_not_of(" \t\r\n");
+    if (begin == std::string::npos || !startsWithKeyword(query, begin, "INSERT"))
+        return std::string{};
+
+    auto pos = query.find_last_not_of(" \t\r\n;");
+    if (pos == std::string::npos || query[pos] != ')')
+        return std::string{};
+
+    // Walk the tuple backwards, matching the (already cut out) placeholders of the parameters.
+    for (std::size_t i = parameters.size(); i > 0; --i) {
+        const auto offset = parameters[i - 1].offset;
+        if (query.find_first_not_of(" \t\r\n", offset) != pos)
+            return std::string{};
+
+        pos = (offset == 0 ? std::string::npos : query.find_last_not_of(" \t\r\n", offset - 1));
+        if (pos == std::string::npos || query[pos] != (i == 1 ? '(' : ','))
+            return std::string{};
+    }
+
+    pos = (pos == 0 ? std::string::npos : query.find_last_not_of(" \t\r\n", pos - 1));
+    if (pos == std::string::npos || pos < 5 || !startsWithKeyword(query, pos - 5, "VALUES"))
+        return std::string{};
+
+    const auto values_pos = pos - 5;
+    if (values_pos == 0 || !(std::isspace(static_cast<unsigned char>(query[values_pos - 1])) || query[values_pos - 1] == ')'))
+        return std::string{};
+
+    auto batch_query = query.substr(begin, values_pos - begin);
+    if (!std::isspace(static_cast<unsigned char>(batch_query.back())))
+        batch_query += ' ';
+
+    return batch_query;
+}
+
+// Processes the escape sequences of the query, if requested, and cuts out all unquoted ? and @name parameter placeholders,
+// remembering their positions, so that the final query can be assembled by a single concatenation for every execution.
+std::shared_ptr<const QueryTemplate> parseQueryTemplate(const std::string & text, bool process_escapes) {
+    auto query_template = std::make_shared<QueryTemplate>();
+    const auto source = (process_escapes ? replaceEscapeSequences(text) : text);
+
+    auto & query = query_template->query;
+    auto & parameters = query_template->parameters;
+    query.reserve(source.size());
+
+    std::size_t copied = 0;
+    auto cut_placeholder = [&] (std::size_t pos, std::size_t size, ParamInfo && param_info) {
+        query.append(source, copied, pos - copied);
+        param_info.offset = query.size();
+        parameters.emplace_back(std::move(param_info));
+        copied = pos + size;
+    };
+
+    // TODO: implement this all in an upgraded Lexer.
+
+    char quoted_by = '\0';
+    for (std::size_t i = 0; i < source.size(); ++i) {
+        const char curr = source[i];
+        const char next = (i + 1 < source.size() ? source[i + 1] : '\0');
+
+        switch (curr) {
+            case '\\': {
+                ++i; // Skip the next char unconditionally.
+                break;
+            }
+
+            case '"':
+            case '\'': {
+                if (quoted_by == curr) {
+                    if (next == curr) {
+                        ++i; // Skip the next char unconditionally: '' or "" SQL escaping.
+                        break;
+                    }
+                    else {
+                        quoted_by = '\0';
+                    }
+                }
+                else {
+                    quoted_by = curr;
+                }
+                break;
+            }
+
+            case '?': {
+                if (quoted_by == '\0')
+                    cut_placeholder(i, 1, ParamInfo{});
+                break;
+            }
+
+            case '@': {
+                if (quoted_by == '\0') {
+                    ParamInfo param_info;
+
+                    param_info.name = '@';
+                    for (std::size_t j = i + 1; j < source.size(); ++j) {
+                        const char jcurr = source[j];
+                        if (
+                            jcurr == '_' ||
+                            std::isalpha(static_cast<unsigned char>(jcurr)) ||
+                            (std::isdigit(static_cast<unsigned char>(jcurr)) && j > i + 1)
+                        ) {
+                            param_info.name += jcurr;
+                        }
+                        else {
+                            break;
+                        }
+                    }
+
+                    if (param_info.name.size() == 1)
+                        throw SqlException("Syntax error or access violation", "42000");
+
+                    const auto size = param_info.name.size();
+                    cut_placeholder(i, size, std::move(param_info));
+                    i += size - 1; // - 1 to compensate for the next ++i
+                }
+                break;
+            }
+        }
+    }
+
+    query.append(source, copied);
+    query_template->batch_insert_query = makeBatchInsertQuery(query, parameters);
+
+    return query_template;
+}
+
+void writeFormField(Poco::Net::MultipartWriter & form_writer, const std::string & name) {
+    Poco::Net::MessageHeader header;
+    header.set("Content-Disposition", "form-data; name=\"" + name + "\"");
+    form_writer.nextPart(header);
+}
+
+} // namespace
 
 Statement::Statement(Connection & connection)
     : ChildType(connection)
@@ -22,6 +276,10 @@ Statement::Statement(Connection & connection)
 }
 
 Statement::~Statement() {
+    // The I/O thread must not notify the application about the statement, that doesn't exist anymore.
+    if (async_execution && async_execution->watch_id)
+        SocketWatcher::getInstance().unwatch(*async_execution->watch_id);
+
     deallocateImplicitDescriptors();
 }
 
@@ -33,9 +291,34 @@ void Statement::prepareQuery(const std::string & q) {
     closeCursor();
 
     is_prepared = false;
-    query = q;
-    processEscapeSequences();
-    extractParametersinfo();
+
+    const bool process_escapes = (getAttrAs<SQLULEN>(SQL_ATTR_NOSCAN, SQL_NOSCAN_OFF) != SQL_NOSCAN_ON);
+
+    // The same text is parsed differently, depending on whether the escape sequences are processed.
+    auto & query_templates = getParent().query_templates;
+    const auto cache_key = (process_escapes ? '+' : '-') + q;
+
+    std::shared_ptr<const QueryTemplate> query_template;
+    if (auto cached = query_templates.get(cache_key)) {
+        query_template = std::move(*cached);
+    }
+    else {
+        query_template = parseQueryTemplate(q, process_escapes);
+
+        // Approximately the memory held by the entry, mostly by the texts.
+        std::size_t weight = cache_key.size() + query_template->query.size() + query_template->batch_insert_query.size();
+        for (const auto & parameter : query_template->parameters) {
+            weight += sizeof(parameter) + parameter.name.size();
+        }
+
+        query_templates.put(cache_key, query_template, weight);
+    }
+
+    query = query_template->query;
+    parameters = query_template->parameters;
+    batch_insert_query = query_template->batch_insert_query;
+
+    adjustParamRecords();
     is_prepared = true;
 }
 
@@ -65,11 +348,90 @@ void Statement::executeQuery(std::unique_ptr<ResultMutator> && mutator) {
     is_executed = true;
 }
 
-Statement::HttpRequestData Statement::prepareHttpRequest()
-{
+Statement::HttpRequestData Statement::prepareHttpRequest() {
+    const auto param_set_array_size = getEffectiveDescriptor(SQL_ATTR_APP_PARAM_DESC).getAttrAs<SQLULEN>(SQL_DESC_ARRAY_SIZE, 1);
+
+    if (canBatchParamSets(param_set_array_size))
+        return prepareBatchHttpRequest(param_set_array_size);
+
+    return prepareHttpRequest(getParamsBindingInfo(next_param_set_idx));
+}
+
+Statement::HttpRequestData Statement::prepareBatchHttpRequest(std::size_t param_set_array_size) {
+    Statement::HttpRequestData ret{};
+
+    auto & apd_desc = getEffectiveDescriptor(SQL_ATTR_APP_PARAM_DESC);
+    const auto * param_operation_ptr = apd_desc.getAttrAs<SQLUSMALLINT *>(SQL_DESC_ARRAY_STATUS_PTR, 0);
+    auto * array_status_ptr = getEffectiveDescriptor(SQL_ATTR_IMP_PARAM_DESC).getAttrAs<SQLUSMALLINT *>(SQL_DESC_ARRAY_STATUS_PTR, 0);
+
+    // The rows are read through input() with the same types, that the parameters would have in a single set query,
+    // so that the values are parsed exactly as when they are sent one set at a time.
+    const auto first_param_bindings = getParamsBindingInfo(0);
+
+    ret.query = batch_insert_query;
+    ret.query += "SELECT * FROM input('";
+
+    for (std::size_t i = 0; i < parameters.size(); ++i) {
+        if (i > 0)
+            ret.query += ", ";
+
+        ret.query += 'c' + std::to_string(i + 1) + ' ';
+        ret.query += escapeForSQL(first_param_bindings.size() <= i ? std::string{"Nullable(Nothing)"} : getParamDataSourceType(first_param_bindings[i], true));
+    }
+
+    // The query is followed by the data of all the parameter sets, one row per set, in the same request body.
+    ret.query += "') FORMAT TabSeparated\n";
+
+    std::string value;
+
+    for (std::size_t param_set_idx = 0; param_set_idx < param_set_array_size; ++param_set_idx) {
+        if (param_operation_ptr && param_operation_ptr[param_set_idx] == SQL_PARAM_IGNORE) {
+            if (array_status_ptr)
+                array_status_ptr[param_set_idx] = SQL_PARAM_UNUSED;
+            continue;
+        }
+
+        const auto param_bindings = getParamsBindingInfo(param_set_idx);
+
+        for (std::size_t i = 0; i < parameters.size(); ++i) {
+            if (i > 0)
+                ret.query += '\t';
+
+            if (param_bindings.size() <= i) {
+                ret.query += "\\N";
+                continue;
+            }
+
+            const auto & binding_info = param_bindings[i];
+
+            if (!isInputParam(binding_info.io_type) || isStreamParam(binding_info.io_type))
+                throw std::runtime_error("Unable to extract data from bound param buffer: param IO type is not supported");
+
+            if (isDataAtExecParam(binding_info))
+                throw SqlException("Optional feature not implemented", "HYC00");
+
+            if (binding_info.value == nullptr || (binding_info.indicator && *binding_info.indicator == SQL_NULL_DATA)) {
+                ret.query += "\\N";
+                continue;
+            }
+
+            value.clear();
+            readReadyDataTo(binding_info, value);
+            appendTSVField(ret.query, value);
+        }
+
+        ret.query += '\n';
+    }
+
+    return ret;
+}
+
+bool Statement::canBatchParamSets(std::size_t param_set_array_size) const {
+    return (param_set_array_size > 1 && next_param_set_idx == 0 && !batch_insert_query.empty());
+}
+
+Statement::HttpRequestData Statement::prepareHttpRequest(const std::vector<ParamBindingInfo> & param_bindings) {
     Statement::HttpRequestData ret{};
-    const auto& connection = getParent();
-    const auto param_bindings = getParamsBindingInfo(next_param_set_idx);
 
     for (std::size_t i = 0; i < parameters.size(); ++i) {
         std::string value;
@@ -83,6 +445,9 @@ Statement::HttpRequestData Statement::prepareHttpRequest()
             if (!isInputParam(binding_info.io_type) || isStreamParam(binding_info.io_type))
                 throw std::runtime_error("Unable to extract data from bound param buffer: param IO type is not supported");
 
+            if (isDataAtExecParam(binding_info))
+                continue; // The value will be supplied by SQLPutData(), and sent in the request body.
+
             if (binding_info.value == nullptr)
                 value = "\\N";
             else
@@ -97,8 +462,28 @@ Statement::HttpRequestData Statement::prepareHttpRequest()
     return ret;
 }
 
+void Statement::prepareHttpRequestHeaders(Poco::Net::HTTPRequest & request, const Poco::URI & uri) {
+    auto & connection = getParent();
+
+    request.setMethod(Poco::Net::HTTPRequest::HTTP_POST);
+    request.setVersion(Poco::Net::HTTPRequest::HTTP_1_1);
+    request.setKeepAlive(true);
+    request.setChunkedTransferEncoding(true);
+    request.setCredentials("Basic", connection.buildCredentialsString());
+    request.setHost(uri.getHost());
+    request.setURI(uri.getPathEtc());
+    request.set("User-Agent", connection.buildUserAgentString());
+
+    if (!connection.compression.empty())
+        request.set("Accept-Encoding", connection.compression);
+}
+
 void Statement::requestNextPackOfResultSets(std::unique_ptr<ResultMutator> && mutator) {
-    result_reader.reset();
+    binding_plan.reset();
+    resetResultReader();
+    abortDataAtExecRequest();
+    abortAsyncExecution();
+    releaseResponse();
 
     const auto param_set_array_size = getEffectiveDescriptor(SQL_ATTR_APP_PARAM_DESC).getAttrAs<SQLULEN>(SQL_DESC_ARRAY_SIZE, 1);
     if (next_param_set_idx >= param_set_array_size)
@@ -108,92 +493,559 @@ void Statement::requestNextPackOfResultSets(std::unique_ptr<ResultMutator> && mu
 
     auto & connection = getParent();
 
-    if (connection.session && response && in)
-        if (in->fail() || !in->eof())
-            connection.session->reset();
+    auto param_bindings = getParamsBindingInfo(next_param_set_idx);
+
+    // TODO: set this only after this single query is fully fetched (when output parameter support is added)
+    auto * param_set_processed_ptr = getEffectiveDescriptor(SQL_ATTR_IMP_PARAM_DESC).getAttrAs<SQLULEN *>(SQL_DESC_ROWS_PROCESSED_PTR, 0);
+    if (param_set_processed_ptr)
+        *param_set_processed_ptr = next_param_set_idx;
+
+    if (hasDataAtExecParams(param_bindings)) {
+        // Parameter sets are sent one request at a time, and only the first one is sent during SQLExecute()/SQLParamData().
+        if (param_set_array_size > 1)
+            throw SqlException("Optional feature not implemented", "HYC00");
+
+        startDataAtExecRequest(std::move(param_bindings), std::move(mutator));
+        return;
+    }
+
+    // All the parameter sets of an INSERT are sent in a single request, as rows of data, instead of one request per set.
+    if (canBatchParamSets(param_set_array_size)) {
+        try {
+            sendHttpRequest(prepareBatchHttpRequest(param_set_array_size), std::move(mutator));
+        }
+        catch (...) {
+            markParamSetsFailed(param_set_array_size);
+            throw;
+        }
+
+        // The failure, if any, will be known only once the response is received.
+        if (async_execution)
+            async_execution->batched_param_set_count = param_set_array_size;
+
+        next_param_set_idx = param_set_array_size;
+
+        if (param_set_processed_ptr)
+            *param_set_processed_ptr = param_set_array_size;
 
-    const auto [prepared_query, query_parameters] = prepareHttpRequest();
+        return;
+    }
+
+    sendHttpRequest(prepareHttpRequest(param_bindings), std::move(mutator));
+    ++next_param_set_idx;
+}
+
+void Statement::markParamSetsFailed(std::size_t param_set_array_size) {
+    // The ignored sets are told by the operation array of the application, since the status array may still hold the values of a previous execution.
+    const auto * param_operation_ptr = getEffectiveDescriptor(SQL_ATTR_APP_PARAM_DESC).getAttrAs<SQLUSMALLINT *>(SQL_DESC_ARRAY_STATUS_PTR, 0);
+    auto * array_status_ptr = getEffectiveDescriptor(SQL_ATTR_IMP_PARAM_DESC).getAttrAs<SQLUSMALLINT *>(SQL_DESC_ARRAY_STATUS_PTR, 0);
+
+    if (array_status_ptr) {
+        for (std::size_t i = 0; i < param_set_array_size; ++i) {
+            if (param_operation_ptr && param_operation_ptr[i] == SQL_PARAM_IGNORE)
+                array_status_ptr[i] = SQL_PARAM_UNUSED;
+            else
+                array_status_ptr[i] = SQL_PARAM_ERROR;
+        }
+    }
+}
+
+void Statement::sendHttpRequest(HttpRequestData && request_data, std::unique_ptr<ResultMutator> && mutator) {
+    // Fails right away, if the call has been cancelled already.
+    const auto query_id = startQuery();
+
+    acquireSession();
+
+    if (defer_response) {
+        sendHttpRequestThrough(*session, request_data, query_id, nullptr);
+        deferResponse(std::move(request_data), std::move(mutator));
+        return;
+    }
+
+    response = std::make_unique<Poco::Net::HTTPResponse>();
+    in = sendHttpRequestThrough(*session, request_data, query_id, response.get());
+
+    readResponse(std::move(mutator));
+}
+
+std::istream * Statement::sendHttpRequestThrough(
+    Poco::Net::HTTPClientSession & target_session, const HttpRequestData & request_data, const std::string & query_id, Poco::Net::HTTPResponse * target_response
+) {
+    auto & connection = getParent();
+
+    const auto & [prepared_query, query_parameters] = request_data;
     Poco::URI uri = connection.getUri();
 
     for (const auto& [key, value]: query_parameters) {
         uri.addQueryParameter(key, value);
     }
 
-    // TODO: set this only after this single query is fully fetched (when output parameter support is added)
-    auto * param_set_processed_ptr = getEffectiveDescriptor(SQL_ATTR_IMP_PARAM_DESC).getAttrAs<SQLULEN *>(SQL_DESC_ROWS_PROCESSED_PTR, 0);
-    if (param_set_processed_ptr)
-        *param_set_processed_ptr = next_param_set_idx;
+    uri.addQueryParameter("query_id", query_id);
 
     Poco::Net::HTTPRequest request;
-    request.setMethod(Poco::Net::HTTPRequest::HTTP_POST);
-    request.setVersion(Poco::Net::HTTPRequest::HTTP_1_1);
-    request.setKeepAlive(true);
-    request.setChunkedTransferEncoding(true);
-    request.setCredentials("Basic", connection.buildCredentialsString());
-    request.setHost(uri.getHost());
-    request.setURI(uri.getPathEtc());
-    request.set("User-Agent", connection.buildUserAgentString());
+    prepareHttpRequestHeaders(request, uri);
+
+    const auto compress_request = (!connection.request_compression.empty() && !prepared_query.empty());
+    if (compress_request)
+        request.set("Content-Encoding", connection.request_compression);
 
     LOG(request.getMethod() << " " << request.getHost() << request.getURI() << " body=" << prepared_query
                             << " UA=" << request.get("User-Agent"));
 
+    std::istream * response_stream = nullptr;
     int redirect_count = 0;
     // Send request to server with finite count of retries.
     for (int i = 1;; ++i) {
         try {
             for (; redirect_count < connection.redirect_limit; ++redirect_count) {
-                connection.session->sendRequest(request) << prepared_query;
-                response = std::make_unique<Poco::Net::HTTPResponse>();
-                in = &connection.session->receiveResponse(*response);
-                auto status = response->getStatus();
+                auto & request_stream = target_session.sendRequest(request);
+                if (compress_request)
+                    writeCompressed(connection.request_compression, prepared_query, request_stream);
+                else
+                    request_stream << prepared_query;
+                if (!target_response)
+                    return nullptr;
+                response_stream = &target_session.receiveResponse(*target_response);
+                auto status = target_response->getStatus();
                 if (status != Poco::Net::HTTPResponse::HTTP_PERMANENT_REDIRECT && status != Poco::Net::HTTPResponse::HTTP_TEMPORARY_REDIRECT) {
                     break;
                 }
-                connection.session->reset(); // reset keepalived connection
-                auto newLocation = response->get("Location");
+                target_session.reset(); // reset keepalived connection
+                auto newLocation = target_response->get("Location");
                 LOG("Redirected to " << newLocation << ", redirect index=" << redirect_count + 1 << "/" << connection.redirect_limit);
                 uri = newLocation;
-                connection.session->setHost(uri.getHost());
-                connection.session->setPort(uri.getPort());
+                target_session.setHost(uri.getHost());
+                target_session.setPort(uri.getPort());
                 request.setHost(uri.getHost());
                 request.setURI(uri.getPathEtc());
             }
             break;
         } catch (const Poco::IOException & e) {
-            connection.session->reset(); // reset keepalived connection
+            target_session.reset(); // reset keepalived connection
             LOG("Http request try=" << i << "/" << connection.retry_count << " failed: " << e.what() << ": " << e.message());
+            if (isCancelRequested())
+                throw SqlException("Operation canceled", "HY008");
             if (i > connection.retry_count)
                 throw;
         }
     }
 
+    return response_stream;
+}
+
+void Statement::startDataAtExecRequest(std::vector<ParamBindingInfo> && param_bindings, std::unique_ptr<ResultMutator> && mutator) {
+    auto & connection = getParent();
+    acquireSession();
+
+    DataAtExecRequest state;
+    state.param_bindings = std::move(param_bindings);
+    state.mutator = std::move(mutator);
+
+    for (std::size_t i = 0; i < std::min(state.param_bindings.size(), parameters.size()); ++i) {
+        if (isDataAtExecParam(state.param_bindings[i]))
+            state.params.push_back(i);
+    }
+
+    // The query, and all the parameter values, are sent as fields of a form, so that the values of data-at-execution parameters
+    // can be written directly to the request body, piece by piece, without being accumulated in memory first.
+    const auto [prepared_query, query_parameters] = prepareHttpRequest(state.param_bindings);
+    Poco::URI uri = connection.getUri();
+    uri.addQueryParameter("query_id", startQuery());
+
+    Poco::Net::HTTPRequest request;
+    prepareHttpRequestHeaders(request, uri);
+
+    const auto boundary = Poco::Net::MultipartWriter::createBoundary();
+    request.setContentType("multipart/form-data; boundary=" + boundary);
+
+    LOG(request.getMethod() << " " << request.getHost() << request.getURI() << " query=" << prepared_query
+                            << " UA=" << request.get("User-Agent"));
+
+    // Only sending of the headers can be retried here, and redirects can't be followed, since the body is not available for resending.
+    for (int i = 1;; ++i) {
+        try {
+            state.request_stream = &session->sendRequest(request);
+            break;
+        } catch (const Poco::IOException & e) {
+            session->reset(); // reset keepalived connection
+            LOG("Http request try=" << i << "/" << connection.retry_count << " failed: " << e.what() << ": " << e.message());
+            if (i > connection.retry_count)
+                throw;
+        }
+    }
+
+    state.form_writer = std::make_unique<Poco::Net::MultipartWriter>(*state.request_stream, boundary);
+
+    writeFormField(*state.form_writer, "query");
+    *state.request_stream << prepared_query;
+
+    for (const auto & [key, value] : query_parameters) {
+        writeFormField(*state.form_writer, key);
+        *state.request_stream << value;
+    }
+
+    data_at_exec_request = std::move(state);
+}
+
+bool Statement::needsData() const {
+    return data_at_exec_request.has_value();
+}
+
+bool Statement::advanceToNextDataAtExecParam(SQLPOINTER & token) {
+    if (!data_at_exec_request)
+        throw SqlException("Function sequence error", "HY010");
+
+    auto & state = *data_at_exec_request;
+
+    if (state.next_param > 0)
+        finishDataAtExecParam();
+
+    if (state.next_param < state.params.size()) {
+        const auto param_idx = state.params[state.next_param++];
+
+        state.has_data = false;
+        state.is_null = false;
+        state.incomplete_char.clear();
+
+        writeFormField(*state.form_writer, "param_" + getParamFinalName(param_idx));
+        token = state.param_bindings[param_idx].value;
+        return true;
+    }
+
+    auto mutator = std::move(state.mutator);
+
+    try {
+        state.form_writer->close();
+        state.request_stream->flush();
+
+        data_at_exec_request.reset();
+
+        response = std::make_unique<Poco::Net::HTTPResponse>();
+        in = &session->receiveResponse(*response);
+    }
+    catch (...) {
+        data_at_exec_request.reset();
+        session->reset(); // reset keepalived connection
+        if (isCancelRequested())
+            throw SqlException("Operation canceled", "HY008");
+        throw;
+    }
+
+    const auto status = response->getStatus();
+    if (status == Poco::Net::HTTPResponse::HTTP_PERMANENT_REDIRECT || status == Poco::Net::HTTPResponse::HTTP_TEMPORARY_REDIRECT)
+        throw std::runtime_error("Redirects are not supported for queries with data-at-execution parameters");
+
+    readResponse(std::move(mutator));
+    ++next_param_set_idx;
+    return false;
+}
+
+void Statement::putDataAtExecParamData(SQLPOINTER data, SQLLEN size) {
+    if (!data_at_exec_request || data_at_exec_request->next_param == 0)
+        throw SqlException("Function sequence error", "HY010");
+
+    auto & state = *data_at_exec_request;
+    const auto & binding_info = state.param_bindings[state.params[state.next_param - 1]];
+    auto & request_stream = *state.request_stream;
+
+    if (size == SQL_NULL_DATA || state.is_null) {
+        if (state.has_data)
+            throw SqlException("Attempt to concatenate a null value", "HY020");
+
+        request_stream << "\\N";
+        state.has_data = true;
+        state.is_null = true;
+        return;
+    }
+
+    if (!data || (size < 0 && size != SQL_NTS))
+        throw SqlException("Invalid string or buffer length", "HY090");
+
+    switch (binding_info.c_type) {
+        case SQL_C_CHAR: {
+            const auto * cstr = reinterpret_cast<const char *>(data);
+            state.incomplete_char.append(cstr, (size == SQL_NTS ? std::strlen(cstr) : static_cast<std::size_t>(size)));
+
+            const auto length = getCompleteUTF8Length(state.incomplete_char);
+            request_stream << toUTF8(state.incomplete_char.data(), length);
+            state.incomplete_char.erase(0, length);
+            break;
+        }
+
+        case SQL_C_WCHAR: {
+            const auto * cstr = reinterpret_cast<const char16_t *>(data);
+            const auto bytes = (size == SQL_NTS ? std::char_traits<char16_t>::length(cstr) * sizeof(char16_t) : static_cast<std::size_t>(size));
+            state.incomplete_char.append(reinterpret_cast<const char *>(data), bytes);
+
+            // Keep an odd trailing byte, and a trailing high surrogate, until the rest of the character arrives.
+            std::basic_string<char16_t> wstr(state.incomplete_char.size() / sizeof(char16_t), u'\0');
+            std::memcpy(wstr.data(), state.incomplete_char.data(), wstr.size() * sizeof(char16_t));
+
+            if (!wstr.empty() && wstr.back() >= 0xD800 && wstr.back() <= 0xDBFF)
+                wstr.pop_back();
+
+            request_stream << toUTF8(wstr.data(), wstr.size());
+            state.incomplete_char.erase(0, wstr.size() * sizeof(char16_t));
+            break;
+        }
+
+        case SQL_C_BINARY: {
+            if (size == SQL_NTS)
+                throw SqlException("Invalid string or buffer length", "HY090");
+
+            request_stream.write(reinterpret_cast<const char *>(data), size);
+            break;
+        }
+
+        default: {
+            if (state.has_data)
+                throw SqlException("Non-character and non-binary data sent in pieces", "HY019");
+
+            BindingInfo piece_binding_info;
+            piece_binding_info.c_type = binding_info.c_type;
+            piece_binding_info.value = data;
+            piece_binding_info.precision = binding_info.precision;
+            piece_binding_info.scale = binding_info.scale;
+
+            std::string value;
+            readReadyDataTo(piece_binding_info, value);
+            request_stream << value;
+            break;
+        }
+    }
+
+    state.has_data = true;
+}
+
+void Statement::finishDataAtExecParam() {
+    auto & state = *data_at_exec_request;
+
+    if (state.incomplete_char.empty())
+        return;
+
+    // The value ended in the middle of a character, let the conversion deal with what is left of it.
+    if (state.param_bindings[state.params[state.next_param - 1]].c_type == SQL_C_WCHAR) {
+        std::basic_string<char16_t> wstr(state.incomplete_char.size() / sizeof(char16_t), u'\0');
+        std::memcpy(wstr.data(), state.incomplete_char.data(), wstr.size() * sizeof(char16_t));
+        *state.request_stream << toUTF8(wstr.data(), wstr.size());
+    }
+    else {
+        *state.request_stream << toUTF8(state.incomplete_char.data(), state.incomplete_char.size());
+    }
+
+    state.incomplete_char.clear();
+}
+
+void Statement::abortDataAtExecRequest() {
+    if (!data_at_exec_request)
+        return;
+
+    data_at_exec_request.reset();
+
+    // The request has been sent only partially, so the connection can't be reused.
+    if (session)
+        session->reset();
+}
+
+void Statement::deferResponse(HttpRequestData && request_data, std::unique_ptr<ResultMutator> && mutator) {
+    // Nothing else is going to push the rest of the request out, until the response is received.
+    session->flushRequest();
+
+    AsyncExecution execution;
+    execution.request_data = std::move(request_data);
+    execution.mutator = std::move(mutator);
+
+    // In the notification mode, the driver's I/O thread tells the application, when the response arrives. Otherwise, the application polls.
+    const auto callback = reinterpret_cast<SQL_ASYNC_NOTIFICATION_CALLBACK>(getAttrAs<SQLPOINTER>(SQL_ATTR_ASYNC_STMT_NOTIFICATION_CALLBACK));
+    const auto context = getAttrAs<SQLPOINTER>(SQL_ATTR_ASYNC_STMT_NOTIFICATION_CONTEXT);
+
+#if defined(_win_) && defined(SQL_ATTR_ASYNC_STMT_EVENT)
+    const auto event = getAttrAs<SQLPOINTER>(SQL_ATTR_ASYNC_STMT_EVENT);
+#else
+    const SQLPOINTER event = nullptr;
+#endif
+
+    if (callback || event) {
+        execution.watch_id = SocketWatcher::getInstance().watch(session->socket(), [callback, context, event] () {
+            if (callback)
+                callback(context, 1);
+#if defined(_win_)
+            else
+                SetEvent(static_cast<HANDLE>(event));
+#endif
+        });
+    }
+
+    async_execution = std::move(execution);
+}
+
+void Statement::abortAsyncExecution() {
+    if (!async_execution)
+        return;
+
+    if (async_execution->watch_id)
+        SocketWatcher::getInstance().unwatch(*async_execution->watch_id);
+
+    async_execution.reset();
+
+    // The server may be still executing the query, and its response can't be read through the session anymore.
+    requestCancel();
+    session->reset();
+}
+
+bool Statement::isAsyncEnabled() const {
+    const auto connection_default = getParent().getAttrAs<SQLULEN>(SQL_ATTR_ASYNC_ENABLE, SQL_ASYNC_ENABLE_OFF);
+    return (getAttrAs<SQLULEN>(SQL_ATTR_ASYNC_ENABLE, connection_default) == SQL_ASYNC_ENABLE_ON);
+}
+
+bool Statement::isExecutingAsync() const {
+    return async_execution.has_value();
+}
+
+SQLRETURN Statement::completeAsyncExecution(bool wait) {
+    if (!async_execution)
+        throw SqlException("Function sequence error", "HY010");
+
+    if (!wait) {
+        bool ready = true;
+
+        try {
+            ready = session->socket().poll(Poco::Timespan(0), Poco::Net::Socket::SELECT_READ | Poco::Net::Socket::SELECT_ERROR);
+        }
+        catch (const Poco::Exception &) {
+            // Will fail while receiving the response.
+        }
+
+        if (!ready)
+            return SQL_STILL_EXECUTING;
+    }
+
+    auto execution = std::move(*async_execution);
+    async_execution.reset();
+
+    if (execution.watch_id)
+        SocketWatcher::getInstance().unwatch(*execution.watch_id);
+
+    try {
+        bool resend = false;
+
+        try {
+            response = std::make_unique<Poco::Net::HTTPResponse>();
+            in = &session->receiveResponse(*response);
+
+            const auto status = response->getStatus();
+            if (status == Poco::Net::HTTPResponse::HTTP_PERMANENT_REDIRECT || status == Poco::Net::HTTPResponse::HTTP_TEMPORARY_REDIRECT) {
+                session->reset(); // reset keepalived connection
+                resend = true;
+            }
+        }
+        catch (const Poco::IOException & e) {
+            session->reset(); // reset keepalived connection
+            LOG("Http response receiving failed: " << e.what() << ": " << e.message());
+            if (isCancelRequested())
+                throw SqlException("Operation canceled", "HY008");
+            resend = true;
+        }
+
+        if (resend) {
+            // Redirects are followed, and the request is retried, the usual way, while waiting for the response.
+            in = nullptr;
+            response.reset();
+            sendHttpRequest(std::move(execution.request_data), std::move(execution.mutator));
+        }
+        else {
+            readResponse(std::move(execution.mutator));
+        }
+    }
+    catch (...) {
+        if (execution.batched_param_set_count > 0)
+            markParamSetsFailed(execution.batched_param_set_count);
+        throw;
+    }
+
+    return execution.rc;
+}
+
+void Statement::acquireSession() {
+    if (!session)
+        session = getParent().leaseSession(*this);
+}
+
+std::string Statement::startQuery() {
+    auto query_id = Poco::UUIDGenerator::defaultGenerator().createRandom().toString();
+
+    std::scoped_lock lock(cancel_mutex);
+
+    // The call has been cancelled before it got to sending the query.
+    if (cancel_pending) {
+        cancel_pending = false;
+        cancel_requested = true;
+        throw SqlException("Operation canceled", "HY008");
+    }
+
+    running_query_id = query_id;
+    cancel_requested = false;
+
+    return query_id;
+}
+
+void Statement::readResponse(std::unique_ptr<ResultMutator> && mutator) {
+    auto & connection = getParent();
+
+    decompressed_in = make_decompressing_stream(response->get("Content-Encoding", ""), *in);
+    auto & response_stream = (decompressed_in ? *decompressed_in : *in);
+
     Poco::Net::HTTPResponse::HTTPStatus status = response->getStatus();
     if (status != Poco::Net::HTTPResponse::HTTP_OK) {
         std::stringstream error_message;
         if (status == Poco::Net::HTTPResponse::HTTP_TEMPORARY_REDIRECT || status == Poco::Net::HTTPResponse::HTTP_PERMANENT_REDIRECT) {
             error_message << "Redirect count exceeded" << std::endl << "Redirect limit: " << connection.redirect_limit << std::endl;
         } else {
-            error_message << "HTTP status code: " << status << std::endl << "Received error:" << std::endl << in->rdbuf() << std::endl;
+            error_message << "HTTP status code: " << status << std::endl << "Received error:" << std::endl << response_stream.rdbuf() << std::endl;
         }
         LOG(error_message.str());
+        if (isCancelRequested())
+            throw SqlException("Operation canceled", "HY008");
         throw std::runtime_error(error_message.str());
     }
 
     result_reader = make_result_reader(
         response->get("X-ClickHouse-Format", connection.default_format),
-        response->get("X-ClickHouse-Timezone", Poco::Timezone::name()),
-        *in, std::move(mutator)
+        response->get("X-ClickHouse-Timezone", std::string{}), // Local timezone, if not reported by the server.
+        response_stream, std::move(mutator), connection.read_buffer_size
     );
 
-    ++next_param_set_idx;
+    if (result_reader->hasResultSet())
+        result_reader->getResultSet().startBackgroundReading(connection.background_fetch);
 }
 
-void Statement::processEscapeSequences() {
-    if (getAttrAs<SQLULEN>(SQL_ATTR_NOSCAN, SQL_NOSCAN_OFF) != SQL_NOSCAN_ON)
-        query = replaceEscapeSequences(query);
+void Statement::releaseResponse() {
+    if (session && response && in) {
+        // Decompression stops at the end of the compressed data, which may leave the rest of the response,
+        // e.g. the terminating chunk, unread, so consume it to keep the connection reusable.
+        if (decompressed_in && decompressed_in->eof() && !in->bad()) {
+            in->clear();
+            in->ignore(std::numeric_limits<std::streamsize>::max());
+        }
+
+        if (in->fail() || !in->eof())
+            session->reset();
+    }
+
+    decompressed_in.reset();
+    in = nullptr;
+    response.reset();
+
+    {
+        std::scoped_lock lock(cancel_mutex);
+        running_query_id.clear();
+    }
+
+    // Let the other statements of the connection reuse the session, while this one has nothing to read.
+    getParent().releaseSession(std::move(session));
 }
 
-void Statement::extractParametersinfo() {
+void Statement::adjustParamRecords() {
     auto & apd_desc = getEffectiveDescriptor(SQL_ATTR_APP_PARAM_DESC);
     auto & ipd_desc = getEffectiveDescriptor(SQL_ATTR_IMP_PARAM_DESC);
 
@@ -204,130 +1056,37 @@ void Statement::extractParametersinfo() {
     ipd_record_count = std::min(ipd_record_count, apd_record_count);
     ipd_desc.setAttr(SQL_DESC_COUNT, ipd_record_count);
 
-    parameters.clear();
-
-    // TODO: implement this all in an upgraded Lexer.
-
-    Poco::UUIDGenerator uuid_gen;
-    auto generate_placeholder = [&] () {
-        std::string placeholder;
-        do {
-            const auto uuid = uuid_gen.createOne();
-            placeholder = '@' + uuid.toString();
-        } while (query.find(placeholder) != std::string::npos);
-        return placeholder;
-    };
-
-    // Replace all unquoted ? characters with a placeholder and populate 'parameters' array.
-    char quoted_by = '\0';
-    for (std::size_t i = 0; i < query.size(); ++i) {
-        const char curr = query[i];
-        const char next = (i < query.size() ? query[i + 1] : '\0');
-
-        switch (curr) {
-            case '\\': {
-                ++i; // Skip the next char unconditionally.
-                break;
-            }
-
-            case '"':
-            case '\'': {
-                if (quoted_by == curr) {
-                    if (next == curr) {
-                        ++i; // Skip the next char unconditionally: '' or "" SQL escaping.
-                        break;
-                    }
-                    else {
-                        quoted_by = '\0';
-                    }
-                }
-                else {
-                    quoted_by = curr;
-                }
-                break;
-            }
-
-            case '?': {
-                if (quoted_by == '\0') {
-                    ParamInfo param_info;
-                    param_info.tmp_placeholder = generate_placeholder();
-                    query.replace(i, 1, param_info.tmp_placeholder);
-                    i += param_info.tmp_placeholder.size() - 1; // - 1 to compensate for's next ++i
-                    parameters.emplace_back(param_info);
-                }
-                break;
-            }
-
-            case '@': {
-                if (quoted_by == '\0') {
-                    ParamInfo param_info;
-
-                    param_info.name = '@';
-                    for (std::size_t j = i + 1; j < query.size(); ++j) {
-                        const char jcurr = query[j];
-                        if (
-                            jcurr == '_' ||
-                            std::isalpha(jcurr) ||
-                            (std::isdigit(jcurr) && j > i + 1)
-                        ) {
-                            param_info.name += jcurr;
-                        }
-                        else {
-                            break;
-                        }
-                    }
-
-                    if (param_info.name.size() == 1)
-                        throw SqlException("Syntax error or access violation", "42000");
-
-                    param_info.tmp_placeholder = generate_placeholder();
-                    query.replace(i, param_info.name.size(), param_info.tmp_placeholder);
-                    i += param_info.tmp_placeholder.size() - 1; // - 1 to compensate for's next ++i
-                    parameters.emplace_back(param_info);
-                }
-                break;
-            }
-        }
-    }
-
     // Access the biggest record to [possibly] create all missing ones.
     if (ipd_record_count < parameters.size())
         ipd_desc.getRecord(parameters.size(), SQL_ATTR_IMP_PARAM_DESC);
 }
 
 std::string Statement::buildFinalQuery(const std::vector<ParamBindingInfo>& param_bindings) {
-    auto prepared_query = query;
+    std::string prepared_query;
+    prepared_query.reserve(query.size() + parameters.size() * 32);
+
+    std::size_t pos = 0;
 
     for (std::size_t i = 0; i < parameters.size(); ++i) {
         const auto & param_info = parameters[i];
         std::string param_type;
 
-        if (param_bindings.size() <= i) {
+        if (param_bindings.size() <= i)
             param_type = "Nullable(Nothing)";
-        }
-        else {
-            const auto & binding_info = param_bindings[i];
-
-            BoundTypeInfo type_info;
-            type_info.c_type = binding_info.c_type;
-            type_info.sql_type = binding_info.sql_type;
-            type_info.value_max_size = binding_info.value_max_size;
-            type_info.precision = binding_info.precision;
-            type_info.scale = binding_info.scale;
-            type_info.is_nullable = (binding_info.is_nullable || binding_info.value == nullptr);
-
-            param_type = convertSQLOrCTypeToDataSourceType(type_info);
-        }
+        else
+            param_type = getParamDataSourceType(param_bindings[i], false);
 
-        const auto pos = prepared_query.find(param_info.tmp_placeholder);
-        if (pos == std::string::npos)
-            throw SqlException("COUNT field incorrect", "07002");
+        prepared_query.append(query, pos, param_info.offset - pos);
+        prepared_query += '{';
+        prepared_query += getParamFinalName(i);
+        prepared_query += ':';
+        prepared_query += param_type;
+        prepared_query += '}';
 
-        const auto param_name = getParamFinalName(i);
-        const std::string param_placeholder = "{" + param_name + ":" + param_type + "}";
-        prepared_query.replace(pos, param_info.tmp_placeholder.size(), param_placeholder);
+        pos = param_info.offset;
     }
 
+    prepared_query.append(query, pos);
     return prepared_query;
 }
 
@@ -343,6 +1102,10 @@ void Statement::forwardExecuteQuery(std::unique_ptr<ResultMutator> && mutator) {
     if (is_executed)
         return;
 
+    // The values of data-at-execution parameters can only be supplied after the actual SQLExecute() call.
+    if (hasDataAtExecParams(getParamsBindingInfo(0)))
+        return;
+
     executeQuery(std::move(mutator));
     is_forward_executed = true;
 }
@@ -363,9 +1126,13 @@ bool Statement::advanceToNextResultSet() {
 
     std::unique_ptr<ResultMutator> mutator;
 
+    binding_plan.reset();
+
     if (result_reader) {
-        if (result_reader->advanceToNextResultSet())
+        if (result_reader->advanceToNextResultSet()) {
+            result_reader->getResultSet().startBackgroundReading(getParent().background_fetch);
             return true;
+        }
 
         mutator = result_reader->releaseMutator();
     }
@@ -374,21 +1141,115 @@ bool Statement::advanceToNextResultSet() {
     return hasResultSet();
 }
 
-void Statement::closeCursor() {
-    auto & connection = getParent();
-    if (connection.session && response && in) {
-        if (in->fail() || !in->eof())
-            connection.session->reset();
+bool Statement::isQueryInFlight() const {
+    return (data_at_exec_request || async_execution || isReceivingResponse());
+}
+
+bool Statement::isReceivingResponse() const {
+    if (!response || !in)
+        return false;
+
+    // The stream must not be touched, while the background thread is reading from it.
+    if (result_reader && result_reader->hasResultSet() && result_reader->getResultSet().isReadingInBackground())
+        return true;
+
+    return !in->eof();
+}
+
+void Statement::resetResultReader() {
+    // The background thread notices the request to stop only between the rows, while it may be blocked in a socket read,
+    // waiting for the server to send more data, so the connection is shut down first, to make that read fail right away.
+    const bool interrupt = (session && result_reader && result_reader->hasResultSet() && result_reader->getResultSet().isReadingInBackground());
+
+    // The TCP connection is shut down directly, since the TLS layer, if any, holds its lock while receiving.
+    if (interrupt) {
+        const auto sockfd = session->socket().impl()->sockfd();
+        if (sockfd != POCO_INVALID_SOCKET)
+            ::shutdown(sockfd, 2); // SHUT_RDWR, SD_BOTH
     }
 
     result_reader.reset();
-    in = nullptr;
-    response.reset();
+
+    // The rest of the response is lost, and the connection is not reusable anymore.
+    if (interrupt)
+        session->reset();
+}
+
+void Statement::closeCursor() {
+    binding_plan.reset();
+    resetResultReader();
+    abortDataAtExecRequest();
+    abortAsyncExecution();
+    releaseResponse();
 
     is_executed = false;
     is_forward_executed = false;
 }
 
+void Statement::cancel() {
+    // The function, that waits for the response, fails with HY008, when it is called again to complete the execution.
+    if (async_execution) {
+        requestCancel();
+        return;
+    }
+
+    // The query is killed before waiting for the background thread, if any, that reads its result.
+    if (isReceivingResponse())
+        requestCancel();
+
+    closeCursor();
+}
+
+void Statement::requestCancel() {
+    std::string query_id;
+
+    {
+        std::scoped_lock lock(cancel_mutex);
+
+        // The query of the call in progress, if any, is not sent yet, and will be cancelled as soon as it is about to be.
+        if (running_query_id.empty()) {
+            if (active_calls > 0)
+                cancel_pending = true;
+            return;
+        }
+
+        query_id = running_query_id;
+        cancel_requested = true;
+    }
+
+    LOG("Cancelling query " << query_id);
+    getParent().killQuery(query_id);
+}
+
+bool Statement::isCancelRequested() const {
+    std::scoped_lock lock(cancel_mutex);
+    return cancel_requested;
+}
+
+void Statement::onCallEnter(bool async_capable) {
+    // Only the function that is being executed asynchronously may be called again, to poll it, until it completes.
+    if (async_execution && !async_capable) {
+        resetDiag();
+        throw SqlException("Function sequence error", "HY010");
+    }
+
+    std::scoped_lock lock(cancel_mutex);
+    ++active_calls;
+}
+
+void Statement::onCallLeave() noexcept {
+    std::scoped_lock lock(cancel_mutex);
+
+    // A cancellation, that hasn't found any query to stop, is meant only for the call that has just finished.
+    if (--active_calls == 0)
+        cancel_pending = false;
+}
+
+bool Statement::isInCall() const {
+    std::scoped_lock lock(cancel_mutex);
+    return (active_calls > 0);
+}
+
 void Statement::resetColBindings() {
     getEffectiveDescriptor(SQL_ATTR_APP_ROW_DESC).setAttr(SQL_DESC_COUNT, 0);
 }
@@ -476,6 +1337,260 @@ std::vector<ParamBindingInfo> Statement::getParamsBindingInfo(std::size_t param_
     return param_bindings;
 }
 
+std::string Statement::extractSelectedTable(const std::string & query) {
+    const auto is_word = [] (char ch) { return (std::isalnum(static_cast<unsigned char>(ch)) || ch == '_'); };
+
+    auto pos = query.find_first_not_of(" \t\r\n");
+    if (pos == std::string::npos || !startsWithKeyword(query, pos, "SELECT"))
+        return std::string{};
+
+    pos = findTopLevelKeyword(query, pos + 6, {"FROM"});
+    if (pos >= query.size())
+        return std::string{};
+
+    pos = query.find_first_not_of(" \t\r\n", pos + 4);
+    if (pos == std::string::npos)
+        return std::string{};
+
+    // [database.]table, each part either a non-empty quoted name, or a bare word, that doesn't start with a digit.
+    const auto table_begin = pos;
+    for (std::size_t part = 1;; ++part) {
+        if (pos >= query.size())
+            return std::string{};
+
+        if (query[pos] == '`' || query[pos] == '"') {
+            const auto closing = query.find(query[pos], pos + 1);
+            if (closing == std::string::npos || closing == pos + 1)
+                return std::string{};
+            pos = closing + 1;
+        }
+        else {
+            if (std::isdigit(static_cast<unsigned char>(query[pos])))
+                return std::string{};
+
+            const auto word_begin = pos;
+            while (pos < query.size() && is_word(query[pos]))
+                ++pos;
+            if (pos == word_begin)
+                return std::string{};
+        }
+
+        if (part < 2 && pos < query.size() && query[pos] == '.')
+            ++pos;
+        else
+            break;
+    }
+
+    const auto table = query.substr(table_begin, pos - table_begin);
+
+    // Anything else right after the table, e.g. the arguments of a table function, or an alias, makes the query not a plain SELECT from a table.
+    pos = query.find_first_not_of(" \t\r\n", pos);
+    if (pos == std::string::npos || query[pos] == ';')
+        return table;
+
+    const auto clauses = {"WHERE", "PREWHERE", "FINAL", "ORDER", "LIMIT", "SETTINGS", "FORMAT"};
+    if (std::none_of(clauses.begin(), clauses.end(), [&] (const char * keyword) { return startsWithKeyword(query, pos, keyword); }))
+        return std::string{};
+
+    // The clauses that follow must not join, aggregate, or combine the rows with the ones of other queries.
+    if (findTopLevelKeyword(query, pos, {"JOIN", "ARRAY", "GROUP", "HAVING", "WINDOW", "WITH", "UNION", "INTERSECT", "EXCEPT"}) != query.size())
+        return std::string{};
+
+    return table;
+}
+
+void Statement::insertBoundRows() {
+    if (!hasResultSet())
+        throw SqlException("Invalid cursor state", "24000");
+
+    if (getAttrAs<SQLULEN>(SQL_ATTR_CONCURRENCY, SQL_CONCUR_READ_ONLY) == SQL_CONCUR_READ_ONLY)
+        throw SqlException("Invalid attribute identifier", "HY092");
+
+    const auto table = extractSelectedTable(query);
+    if (table.empty())
+        throw SqlException("Optional feature not implemented", "HYC00");
+
+    auto & connection = getParent();
+    auto & result_set = getResultSet();
+    const auto & plan = getBindingPlan();
+
+    if (plan.columns.empty())
+        throw SqlException("Invalid descriptor index", "07009");
+
+    std::string insert_query = "INSERT INTO " + table + " (";
+    for (std::size_t i = 0; i < plan.columns.size(); ++i) {
+        const auto & name = result_set.getColumnInfo(plan.columns[i].column_idx).name;
+
+        if (i > 0)
+            insert_query += ", ";
+
+        insert_query += '`';
+        for (const auto ch : name) {
+            if (ch == '`' || ch == '\\')
+                insert_query += '\\';
+            insert_query += ch;
+        }
+        insert_query += '`';
+    }
+    insert_query += ") FORMAT TabSeparated";
+
+    auto & ard_desc = getEffectiveDescriptor(SQL_ATTR_APP_ROW_DESC);
+    auto & ird_desc = getEffectiveDescriptor(SQL_ATTR_IMP_ROW_DESC);
+
+    const auto * row_operation_ptr = ard_desc.getAttrAs<SQLUSMALLINT *>(SQL_DESC_ARRAY_STATUS_PTR, 0);
+    auto * row_status_ptr = ird_desc.getAttrAs<SQLUSMALLINT *>(SQL_DESC_ARRAY_STATUS_PTR, 0);
+    auto * rows_processed_ptr = ird_desc.getAttrAs<SQLULEN *>(SQL_DESC_ROWS_PROCESSED_PTR, 0);
+    const auto bind_offset = (plan.bind_offset_ptr ? *plan.bind_offset_ptr : 0);
+
+    const auto set_row_statuses = [&] (SQLUSMALLINT row_status) {
+        if (row_status_ptr) {
+            for (std::size_t row_idx = 0; row_idx < plan.row_set_size; ++row_idx) {
+                if (!row_operation_ptr || row_operation_ptr[row_idx] != SQL_ROW_IGNORE)
+                    row_status_ptr[row_idx] = row_status;
+            }
+        }
+    };
+
+    // The rows are inserted through a separate session, so that the response of the current result set, which is still being read, is left intact.
+    auto insert_session = connection.leaseSession(*this);
+
+    // While the rows are being inserted, SQLCancel kills the INSERT query, instead of the one of the result set.
+    std::string result_set_query_id;
+    {
+        std::scoped_lock lock(cancel_mutex);
+        result_set_query_id = running_query_id;
+    }
+
+    const auto restore_running_query = [&] () {
+        std::scoped_lock lock(cancel_mutex);
+        running_query_id = result_set_query_id;
+    };
+
+    std::size_t row_count = 0;
+
+    try {
+        Poco::URI uri = connection.getUri();
+        uri.addQueryParameter("query_id", startQuery());
+
+        Poco::Net::HTTPRequest request;
+        prepareHttpRequestHeaders(request, uri);
+
+        if (!connection.request_compression.empty())
+            request.set("Content-Encoding", connection.request_compression);
+
+        LOG(request.getMethod() << " " << request.getHost() << request.getURI() << " query=" << insert_query
+                                << " UA=" << request.get("User-Agent"));
+
+        // Only sending of the headers can be retried here, and redirects can't be followed, since the rows are converted while being sent.
+        std::ostream * request_stream = nullptr;
+        for (int i = 1;; ++i) {
+            try {
+                request_stream = &insert_session->sendRequest(request);
+                break;
+            } catch (const Poco::IOException & e) {
+                insert_session->reset(); // reset keepalived connection
+                LOG("Http request try=" << i << "/" << connection.retry_count << " failed: " << e.what() << ": " << e.message());
+                if (isCancelRequested())
+                    throw SqlException("Operation canceled", "HY008");
+                if (i > connection.retry_count)
+                    throw;
+            }
+        }
+
+        std::unique_ptr<CompressingOutputStream> compressing_stream;
+        if (!connection.request_compression.empty())
+            compressing_stream = std::make_unique<CompressingOutputStream>(connection.request_compression, *request_stream);
+
+        auto & body_stream = (compressing_stream ? *compressing_stream : *request_stream);
+        body_stream << insert_query << '\n';
+
+        // Each row is written as soon as it is converted. If any row fails to convert, the session is reset below,
+        // before the body is complete, so the server discards the whole INSERT.
+        std::string row;
+        std::string value;
+
+        for (std::size_t row_idx = 0; row_idx < plan.row_set_size; ++row_idx) {
+            if (row_operation_ptr && row_operation_ptr[row_idx] == SQL_ROW_IGNORE)
+                continue;
+
+            row.clear();
+
+            for (std::size_t i = 0; i < plan.columns.size(); ++i) {
+                const auto & column = plan.columns[i];
+
+                BindingInfo binding_info = column.base;
+                binding_info.value = (SQLPOINTER)(column.base.value ? ((char *)(column.base.value) + row_idx * column.value_stride + bind_offset) : 0);
+                binding_info.value_size = (SQLLEN *)(column.base.value_size ? ((char *)(column.base.value_size) + row_idx * column.sz_ind_stride + bind_offset) : 0);
+                binding_info.indicator = (SQLLEN *)(column.base.indicator ? ((char *)(column.base.indicator) + row_idx * column.sz_ind_stride + bind_offset) : 0);
+
+                if (i > 0)
+                    row += '\t';
+
+                if (binding_info.value == nullptr || (binding_info.indicator && *binding_info.indicator == SQL_NULL_DATA)) {
+                    row += "\\N";
+                    continue;
+                }
+
+                value.clear();
+                readReadyDataTo(binding_info, value);
+                appendTSVField(row, value);
+            }
+
+            row += '\n';
+            body_stream.write(row.data(), row.size());
+            ++row_count;
+        }
+
+        if (compressing_stream)
+            compressing_stream->close();
+
+        request_stream->flush();
+        if (!*request_stream)
+            throw std::runtime_error("Unable to send the inserted rows");
+
+        Poco::Net::HTTPResponse insert_response;
+        auto & insert_response_stream = insert_session->receiveResponse(insert_response);
+
+        const auto status = insert_response.getStatus();
+        if (status == Poco::Net::HTTPResponse::HTTP_PERMANENT_REDIRECT || status == Poco::Net::HTTPResponse::HTTP_TEMPORARY_REDIRECT)
+            throw std::runtime_error("Redirects are not supported for the rows added by SQLBulkOperations");
+
+        if (status != Poco::Net::HTTPResponse::HTTP_OK) {
+            const auto decompressed_response_stream = make_decompressing_stream(insert_response.get("Content-Encoding", ""), insert_response_stream);
+
+            std::stringstream error_message;
+            error_message << "HTTP status code: " << status << std::endl << "Received error:" << std::endl
+                          << (decompressed_response_stream ? *decompressed_response_stream : insert_response_stream).rdbuf() << std::endl;
+            LOG(error_message.str());
+
+            if (isCancelRequested())
+                throw SqlException("Operation canceled", "HY008");
+            throw std::runtime_error(error_message.str());
+        }
+
+        // Only a session whose response has been read completely can be reused.
+        insert_response_stream.ignore(std::numeric_limits<std::streamsize>::max());
+        if (!insert_response_stream.eof() || insert_response_stream.bad())
+            insert_session->reset();
+    }
+    catch (...) {
+        restore_running_query();
+        insert_session->reset(); // Also aborts the request, if its body is still incomplete.
+        connection.releaseSession(std::move(insert_session));
+        set_row_statuses(SQL_ROW_ERROR);
+        throw;
+    }
+
+    restore_running_query();
+    connection.releaseSession(std::move(insert_session));
+    set_row_statuses(SQL_ROW_ADDED);
+
+    if (rows_processed_ptr)
+        *rows_processed_ptr = row_count;
+
+    getDiagHeader().setAttr(SQL_DIAG_ROW_COUNT, row_count);
+}
+
 Descriptor& Statement::getEffectiveDescriptor(SQLINTEGER type) {
     switch (type) {
         case SQL_ATTR_APP_ROW_DESC:   return choose(implicit_ard, explicit_ard);
@@ -500,6 +1615,77 @@ void Statement::setImplicitDescriptor(SQLINTEGER type) {
     return setExplicitDescriptor(type, std::shared_ptr<Descriptor>{});
 }
 
+const BindingPlan & Statement::getBindingPlan() {
+    auto & ard_desc = getEffectiveDescriptor(SQL_ATTR_APP_ROW_DESC);
+
+    if (
+        !binding_plan ||
+        binding_plan->ard != &ard_desc ||
+        binding_plan->ard_version != ard_desc.getVersion()
+    ) {
+        buildBindingPlan(ard_desc);
+    }
+
+    return *binding_plan;
+}
+
+void Statement::buildBindingPlan(Descriptor & ard_desc) {
+    binding_plan.reset();
+
+    const auto ard_record_count = ard_desc.getRecordCount();
+    ard_desc.getRecord(ard_record_count, SQL_ATTR_APP_ROW_DESC); // ...just to make sure that record container is in sync with SQL_DESC_COUNT.
+    const auto & ard_records = ard_desc.getRecordContainer();
+
+    BindingPlan plan;
+    plan.ard = &ard_desc;
+    plan.row_set_size = ard_desc.getAttrAs<SQLULEN>(SQL_DESC_ARRAY_SIZE, 1);
+    plan.bind_offset_ptr = ard_desc.getAttrAs<SQLULEN *>(SQL_DESC_BIND_OFFSET_PTR, 0);
+
+    const auto bind_type = ard_desc.getAttrAs<SQLULEN>(SQL_DESC_BIND_TYPE, SQL_BIND_TYPE_DEFAULT);
+    plan.column_wise = (bind_type == SQL_BIND_BY_COLUMN);
+
+    for (std::size_t column_num = 1; column_num <= ard_record_count; ++column_num) { // Skipping the bookmark (0) column.
+        const auto & ard_record = ard_records[column_num];
+
+        ColumnBinding column;
+        column.column_idx = column_num - 1;
+        column.base.value = ard_record.getAttrAs<SQLPOINTER>(SQL_DESC_DATA_PTR, 0);
+        column.base.value_size = ard_record.getAttrAs<SQLLEN *>(SQL_DESC_OCTET_LENGTH_PTR, 0);
+        column.base.indicator = ard_record.getAttrAs<SQLLEN *>(SQL_DESC_INDICATOR_PTR, 0);
+
+        if (
+            !column.base.value &&
+            !column.base.value_size &&
+            !column.base.indicator
+        ) { // Only if the column is bound...
+            continue;
+        }
+
+        column.base.value_max_size = ard_record.getAttrAs<SQLLEN>(SQL_DESC_OCTET_LENGTH, 0);
+        column.base.c_type = ard_record.getAttrAs<SQLSMALLINT>(SQL_DESC_CONCISE_TYPE, SQL_C_DEFAULT);
+
+        if (column.base.c_type == SQL_C_DEFAULT) {
+            const auto & column_info = getResultSet().getColumnInfo(column.column_idx);
+            column.base.c_type = convertSQLTypeToCType(getTypeInfo(column_info.type, column_info.type_without_parameters).data_type);
+        }
+
+        if (column.base.c_type == SQL_C_NUMERIC) {
+            column.base.precision = ard_record.getAttrAs<SQLSMALLINT>(SQL_DESC_PRECISION, 38);
+            column.base.scale = ard_record.getAttrAs<SQLSMALLINT>(SQL_DESC_SCALE, 0);
+        }
+
+        column.value_stride = (bind_type == SQL_BIND_BY_COLUMN ? column.base.value_max_size : bind_type);
+        column.sz_ind_stride = (bind_type == SQL_BIND_BY_COLUMN ? sizeof(SQLLEN) : bind_type);
+
+        plan.columns.push_back(column);
+    }
+
+    // Taken last, since getRecord() above may have changed the descriptor.
+    plan.ard_version = ard_desc.getVersion();
+
+    binding_plan = std::move(plan);
+}
+
 Descriptor & Statement::choose(
     std::shared_ptr<Descriptor> & implicit_desc,
     std::weak_ptr<Descriptor> & explicit_desc
@@ -5,13 +5,45 @@
 #include "driver/descriptor.h"
 #include "driver/result_set.h"
 
+#include <Poco/Net/HTTPRequest.h>
 #include <Poco/Net/HTTPResponse.h>
+#include <Poco/Net/MultipartWriter.h>
+#include <Poco/URI.h>
 
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <sstream>
 #include <string>
 #include <vector>
 
+/// Binding of a result set column, resolved from its ARD record.
+struct ColumnBinding {
+    std::size_t column_idx = 0;
+    BindingInfo base; // The concrete C type, and the buffers for the 0th row of the row set, not accounting for the bind offset.
+    std::size_t value_stride = 0;
+    std::size_t sz_ind_stride = 0;
+};
+
+/// Bindings of all bound columns of the current result set, resolved once from the ARD and reused by all the fetches
+/// until the ARD, or the result set, changes.
+struct BindingPlan {
+    const Descriptor * ard = nullptr;
+    std::uint64_t ard_version = 0;
+    SQLULEN row_set_size = 1;
+    const SQLULEN * bind_offset_ptr = nullptr; // The offset itself is not a descriptor attribute, and may be changed by the application at any time.
+    bool column_wise = true;
+    std::vector<ColumnBinding> columns;
+};
+
+/// Query text, with escape sequences already processed and parameter placeholders cut out, shared by all the statements
+/// of a connection that prepare the same text.
+struct QueryTemplate {
+    std::string query;
+    std::vector<ParamInfo> parameters; // In the order of their offsets.
+    std::string batch_insert_query; // INSERT INTO table [(columns)], if all the parameter sets of the query can be inserted by one request.
+};
+
 class Statement
     : public Child<Connection, Statement>
 {
@@ -53,6 +85,29 @@ public:
     /// Reset statement to initial state.
     void closeCursor();
 
+    /// Indicates whether the query of the statement may still be running on the server: its request is being sent, or its response is pending or being read.
+    bool isQueryInFlight() const;
+
+    /// Cancel the processing of the statement on the calling thread, see SQLCancel(): abort the data-at-execution sequence, if any,
+    /// and close the cursor. The server is asked to stop executing the query, if its response hasn't been read completely.
+    void cancel();
+
+    /// Ask the server to stop executing the current query, if any, so that the call that waits for it fails with HY008.
+    /// If the call in progress hasn't sent its query yet, the query is not sent at all, and the call fails with HY008 as well.
+    /// Unlike all the other methods, may be called while another thread is blocked in a call on the statement.
+    void requestCancel();
+
+    /// Indicates whether the current query has been asked to stop by requestCancel().
+    bool isCancelRequested() const;
+
+    /// Keep track of the calls on the statement, see Driver::call(), so that SQLCancel() can tell whether another thread is in one of them.
+    /// While a function is being executed asynchronously, refuses with HY010 the calls, that can't poll, complete, or cancel it.
+    void onCallEnter(bool async_capable);
+    void onCallLeave() noexcept;
+
+    /// Indicates whether a call on the statement is in progress. Like requestCancel(), may be called from any thread.
+    bool isInCall() const;
+
     /// Reset/release row/column buffer bindings.
     void resetColBindings();
 
@@ -68,6 +123,40 @@ public:
     /// Make an implicit descriptor active again.
     void setImplicitDescriptor(SQLINTEGER type);
 
+    /// Access the bindings of the columns of the current result set, as configured in the effective ARD.
+    const BindingPlan & getBindingPlan();
+
+    /// Insert the rows of the bound row arrays into the table the current result set is selected from, see SQLBulkOperations(SQL_ADD).
+    void insertBoundRows();
+
+    /// Indicates whether the execution waits for the values of data-at-execution parameters.
+    bool needsData() const;
+
+    /// Finish the value of the current data-at-execution parameter, if any, and advance to the next one.
+    /// Returns true and the value pointer of the next parameter in token, or false, if all the values have been supplied
+    /// and the query has been executed.
+    bool advanceToNextDataAtExecParam(SQLPOINTER & token);
+
+    /// Append a piece of the value of the current data-at-execution parameter.
+    void putDataAtExecParamData(SQLPOINTER data, SQLLEN size);
+
+    /// Indicates whether SQL_ATTR_ASYNC_ENABLE is on for the statement, or for its connection.
+    bool isAsyncEnabled() const;
+
+    /// Indicates whether an asynchronously executed function still waits for its response.
+    bool isExecutingAsync() const;
+
+    /// Run the function, that executes a query, asynchronously, if it is enabled: the query is sent, and SQL_STILL_EXECUTING is returned,
+    /// without waiting for the response. When the function is called again, while its response is still pending, it is not run again,
+    /// but SQL_STILL_EXECUTING is returned again, or the response is received, and the return code of the function is returned.
+    /// The function is identified by its SQL_API_* id, and the query it executes, and any other function called meanwhile fails with HY010.
+    template <typename Callable>
+    SQLRETURN executeAsyncCapable(SQLUSMALLINT function_id, const std::string & query, Callable && callable);
+
+    /// Receive the response of the asynchronously executed function, and return the return code of that function.
+    /// Returns SQL_STILL_EXECUTING, if the response hasn't arrived yet, unless told to wait for it.
+    SQLRETURN completeAsyncExecution(bool wait);
+
 public:
     // public only for the unit tests
     struct HttpRequestData {
@@ -76,11 +165,59 @@ public:
     };
     HttpRequestData prepareHttpRequest();
 
+    /// Returns the table, as written in the query, if the query is a simple SELECT ... FROM table, that doesn't join, aggregate,
+    /// or combine anything, or an empty string otherwise. The table must be a plain [database.]table name: subqueries and table functions
+    /// are rejected, while views are left for the server to reject.
+    static std::string extractSelectedTable(const std::string & query);
+
 private:
+    /// Request, whose data-at-execution parameter values are streamed into its body as they are supplied by the application.
+    struct DataAtExecRequest {
+        std::vector<ParamBindingInfo> param_bindings;
+        std::vector<std::size_t> params; // Indices of the data-at-execution parameters, in the order their values are requested.
+        std::size_t next_param = 0; // Position in 'params' of the parameter to be requested next.
+        bool has_data = false; // Whether any piece of the value of the current parameter has been supplied.
+        bool is_null = false;
+        std::string incomplete_char; // Trailing bytes of the last piece, that don't form a whole character yet.
+        std::ostream * request_stream = nullptr;
+        std::unique_ptr<Poco::Net::MultipartWriter> form_writer;
+        std::unique_ptr<ResultMutator> mutator;
+    };
+
+    /// Request, sent by an asynchronously executed function, whose response is still pending.
+    struct AsyncExecution {
+        HttpRequestData request_data; // Resent synchronously, if the response can't be received through the same session.
+        std::unique_ptr<ResultMutator> mutator;
+        std::size_t batched_param_set_count = 0; // Set, if all the parameter sets are sent by the request, see canBatchParamSets().
+        SQLRETURN rc = SQL_SUCCESS; // Returned by the function, once the response is received.
+        SQLUSMALLINT function_id = 0; // SQL_API_* id of the function, which is the only one that may be called, until it completes.
+        std::string query; // Passed to the function, a different one is a call of a different function.
+        std::optional<std::uint64_t> watch_id; // Set in the notification mode, see SocketWatcher.
+    };
+
+    HttpRequestData prepareHttpRequest(const std::vector<ParamBindingInfo> & param_bindings);
+    HttpRequestData prepareBatchHttpRequest(std::size_t param_set_array_size);
+    bool canBatchParamSets(std::size_t param_set_array_size) const;
+    void prepareHttpRequestHeaders(Poco::Net::HTTPRequest & request, const Poco::URI & uri);
     void requestNextPackOfResultSets(std::unique_ptr<ResultMutator> && mutator);
+    void sendHttpRequest(HttpRequestData && request_data, std::unique_ptr<ResultMutator> && mutator);
+    // Returns the stream of the response body, or nullptr, if no target_response is given to receive the response to.
+    std::istream * sendHttpRequestThrough(
+        Poco::Net::HTTPClientSession & target_session, const HttpRequestData & request_data, const std::string & query_id, Poco::Net::HTTPResponse * target_response);
+    void deferResponse(HttpRequestData && request_data, std::unique_ptr<ResultMutator> && mutator);
+    void abortAsyncExecution();
+    void markParamSetsFailed(std::size_t param_set_array_size);
+    void startDataAtExecRequest(std::vector<ParamBindingInfo> && param_bindings, std::unique_ptr<ResultMutator> && mutator);
+    void finishDataAtExecParam();
+    void abortDataAtExecRequest();
+    void acquireSession();
+    std::string startQuery();
+    void readResponse(std::unique_ptr<ResultMutator> && mutator);
+    bool isReceivingResponse() const;
+    void resetResultReader();
+    void releaseResponse();
 
-    void processEscapeSequences();
-    void extractParametersinfo();
+    void adjustParamRecords();
     std::string buildFinalQuery(const std::vector<ParamBindingInfo>& param_bindings);
     std::string getParamFinalName(std::size_t param_idx);
     std::vector<ParamBindingInfo> getParamsBindingInfo(std::size_t param_set_idx);
@@ -93,6 +230,8 @@ private:
     std::shared_ptr<Descriptor> allocateDescriptor();
     void deallocateDescriptor(std::shared_ptr<Descriptor> & desc);
 
+    void buildBindingPlan(Descriptor & ard_desc);
+
 private:
     std::shared_ptr<Descriptor> implicit_ard;
     std::shared_ptr<Descriptor> implicit_apd;
@@ -109,9 +248,54 @@ private:
     bool is_executed = false;
     std::string query;
     std::vector<ParamInfo> parameters;
+    std::string batch_insert_query; // INSERT INTO table [(columns)], if all the parameter sets of the query can be inserted by one request.
 
+    std::unique_ptr<Poco::Net::HTTPClientSession> session; // Leased from the connection for as long as a request or a response is in flight.
     std::unique_ptr<Poco::Net::HTTPResponse> response;
     std::istream* in = nullptr;
+    std::unique_ptr<std::istream> decompressed_in; // Wraps 'in', if the response is compressed.
     std::unique_ptr<ResultReader> result_reader;
+    std::optional<BindingPlan> binding_plan; // Depends on the current result set, so must be reset whenever result_reader changes.
+    std::optional<DataAtExecRequest> data_at_exec_request; // Set while the values of data-at-execution parameters are being supplied.
+    std::optional<AsyncExecution> async_execution; // Set while the response of an asynchronously executed function is pending.
+    bool defer_response = false; // Set by executeAsyncCapable(), while the function runs.
     std::size_t next_param_set_idx = 0;
+
+    mutable std::mutex cancel_mutex; // Guards the members below, that are accessed by requestCancel() from other threads.
+    std::string running_query_id; // Set from the moment the query is sent, until its response is released.
+    bool cancel_requested = false;
+    bool cancel_pending = false; // Set by requestCancel() during a call, that hasn't sent its query yet, see startQuery().
+    std::size_t active_calls = 0; // Nesting depth of the calls in progress on the statement.
 };
+
+template <typename Callable>
+SQLRETURN Statement::executeAsyncCapable(SQLUSMALLINT function_id, const std::string & query, Callable && callable) {
+    if (async_execution) {
+        if (async_execution->function_id != function_id || async_execution->query != query)
+            throw SqlException("Function sequence error", "HY010");
+
+        return completeAsyncExecution(false);
+    }
+
+    defer_response = isAsyncEnabled();
+
+    SQLRETURN rc = SQL_SUCCESS;
+
+    try {
+        rc = callable();
+    }
+    catch (...) {
+        defer_response = false;
+        throw;
+    }
+
+    defer_response = false;
+
+    if (!async_execution)
+        return rc;
+
+    async_execution->rc = rc;
+    async_execution->function_id = function_id;
+    async_execution->query = query;
+    return SQL_STILL_EXECUTING;
+}
@@ -502,6 +502,120 @@ FROM numbers(
     ASSERT_EQ(total_rows, total_rows_expected);
 }
 
+TEST_F(ColumnBindingsTest, RebindBetweenFetches) {
+    // The resolved bindings are reused by consecutive SQLFetch calls, so changing them in between must still take effect.
+
+    auto query = fromUTF8<PTChar>("SELECT CAST(number, 'Int32') AS col1, CAST(number * 10, 'Int32') AS col2 FROM numbers(4)");
+
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLExecDirect(hstmt, ptcharCast(query.data()), SQL_NTS));
+
+    SQLINTEGER col1 = -1;
+    SQLLEN col1_ind = 0;
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLBindCol(hstmt, 1, SQL_C_SLONG, &col1, sizeof(col1), &col1_ind));
+
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLFetch(hstmt));
+    EXPECT_EQ(col1, 0);
+
+    // Bind another column, and a different buffer for the already bound one.
+    SQLINTEGER col1_other = -1;
+    SQLINTEGER col2 = -1;
+    SQLLEN col2_ind = 0;
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLBindCol(hstmt, 1, SQL_C_SLONG, &col1_other, sizeof(col1_other), &col1_ind));
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLBindCol(hstmt, 2, SQL_C_SLONG, &col2, sizeof(col2), &col2_ind));
+
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLFetch(hstmt));
+    EXPECT_EQ(col1, 0);
+    EXPECT_EQ(col1_other, 1);
+    EXPECT_EQ(col2, 10);
+
+    // Change the C type of a column.
+    SQLCHAR col2_str[16] = {};
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLBindCol(hstmt, 2, SQL_C_CHAR, col2_str, sizeof(col2_str), &col2_ind));
+
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLFetch(hstmt));
+    EXPECT_EQ(col1_other, 2);
+    EXPECT_EQ(col2, 10);
+    EXPECT_EQ(std::string(reinterpret_cast<char *>(col2_str)), "20");
+    EXPECT_EQ(col2_ind, 2);
+
+    // Unbind all the columns.
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLFreeStmt(hstmt, SQL_UNBIND));
+
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLFetch(hstmt));
+    EXPECT_EQ(col1_other, 2);
+    EXPECT_EQ(std::string(reinterpret_cast<char *>(col2_str)), "20");
+
+    ASSERT_EQ(SQLFetch(hstmt), SQL_NO_DATA);
+}
+
+TEST_F(ColumnBindingsTest, BulkAdd) {
+    const auto execute = [&] (const std::string & query_orig) {
+        auto query = fromUTF8<PTChar>(query_orig);
+        ODBC_CALL_ON_STMT_THROW(hstmt, SQLExecDirect(hstmt, ptcharCast(query.data()), SQL_NTS));
+        ODBC_CALL_ON_STMT_THROW(hstmt, SQLFreeStmt(hstmt, SQL_CLOSE));
+    };
+
+    execute("DROP TABLE IF EXISTS odbc_bulk_add");
+    execute("CREATE TABLE odbc_bulk_add (id Int32, name Nullable(String)) ENGINE = Memory");
+
+    auto query = fromUTF8<PTChar>("SELECT id, name FROM odbc_bulk_add");
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLExecDirect(hstmt, ptcharCast(query.data()), SQL_NTS));
+
+    constexpr std::size_t row_count = 3;
+
+    SQLINTEGER ids[row_count] = {1, 2, 3};
+    SQLLEN id_inds[row_count] = {0, 0, 0};
+    SQLCHAR names[row_count][16] = {"first", "", "third\tpart"};
+    SQLLEN name_inds[row_count] = {SQL_NTS, SQL_NULL_DATA, SQL_NTS};
+    SQLUSMALLINT row_statuses[row_count] = {};
+
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLSetStmtAttr(hstmt, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER)row_count, 0));
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLSetStmtAttr(hstmt, SQL_ATTR_ROW_STATUS_PTR, row_statuses, 0));
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLBindCol(hstmt, 1, SQL_C_SLONG, ids, sizeof(ids[0]), id_inds));
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLBindCol(hstmt, 2, SQL_C_CHAR, names, sizeof(names[0]), name_inds));
+
+    // Rows can be added only through a cursor, that is not read-only.
+    ASSERT_EQ(SQLBulkOperations(hstmt, SQL_ADD), SQL_ERROR);
+    EXPECT_THAT(extract_diagnostics(hstmt, SQL_HANDLE_STMT), ::testing::HasSubstr("[HY092]"));
+
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLSetStmtAttr(hstmt, SQL_ATTR_CONCURRENCY, (SQLPOINTER)SQL_CONCUR_LOCK, 0));
+
+    SQLULEN concurrency = 0;
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLGetStmtAttr(hstmt, SQL_ATTR_CONCURRENCY, &concurrency, 0, nullptr));
+    EXPECT_EQ(concurrency, SQL_CONCUR_LOCK);
+
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLBulkOperations(hstmt, SQL_ADD));
+
+    for (std::size_t i = 0; i < row_count; ++i) {
+        EXPECT_EQ(row_statuses[i], SQL_ROW_ADDED);
+    }
+
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLFreeStmt(hstmt, SQL_CLOSE));
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLFreeStmt(hstmt, SQL_UNBIND));
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLSetStmtAttr(hstmt, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER)1, 0));
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLSetStmtAttr(hstmt, SQL_ATTR_ROW_STATUS_PTR, nullptr, 0));
+
+    query = fromUTF8<PTChar>("SELECT sum(id), countIf(isNull(name)), max(name) FROM odbc_bulk_add");
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLExecDirect(hstmt, ptcharCast(query.data()), SQL_NTS));
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLFetch(hstmt));
+
+    SQLBIGINT id_sum = 0;
+    SQLBIGINT null_count = 0;
+    SQLCHAR max_name[16] = {};
+    SQLLEN ind = 0;
+
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLGetData(hstmt, 1, SQL_C_SBIGINT, &id_sum, sizeof(id_sum), &ind));
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLGetData(hstmt, 2, SQL_C_SBIGINT, &null_count, sizeof(null_count), &ind));
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLGetData(hstmt, 3, SQL_C_CHAR, max_name, sizeof(max_name), &ind));
+
+    EXPECT_EQ(id_sum, 6);
+    EXPECT_EQ(null_count, 1);
+    EXPECT_EQ(std::string(reinterpret_cast<char *>(max_name)), "third\tpart");
+
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLFreeStmt(hstmt, SQL_CLOSE));
+    execute("DROP TABLE odbc_bulk_add");
+}
+
 INSTANTIATE_TEST_SUITE_P(ArrayBindings, ColumnArrayBindingsTest,
     ::testing::Combine(
         ::testing::Values(0, 1, 1234),                  // Binding offset.
@@ -69,6 +69,9 @@ TEST_P(DateTime, GetData) {
         params.expected_timestamp_val.second
     };
 
+    // Binary formats transfer date and time values as integers, which are then converted to the timezone of the column by the driver.
+    const bool is_binary_format = (params.format == "RowBinaryWithNamesAndTypes" || params.format == "Native");
+
     const auto orig_local_tz = get_env_var("TZ");
     setEnvVar("TZ", params.local_tz);
 
@@ -108,7 +111,7 @@ TEST_P(DateTime, GetData) {
         EXPECT_EQ(toUTF8(col), params.expected_str_val) << "expected: " << params.expected_str_val;;
     }
 
-    if (params.format != "RowBinaryWithNamesAndTypes" || params.expected_sql_type == SQL_TYPE_DATE) {
+    if (!is_binary_format || params.expected_sql_type == SQL_TYPE_DATE) {
         SQL_DATE_STRUCT col = {};
         SQLLEN col_ind = 0;
 
@@ -124,7 +127,7 @@ TEST_P(DateTime, GetData) {
         EXPECT_EQ(col, expected_date_val) << "expected: " << params.expected_str_val;;
     }
 
-    if (params.format != "RowBinaryWithNamesAndTypes") {
+    if (!is_binary_format) {
         SQL_TIME_STRUCT col = {};
         SQLLEN col_ind = 0;
 
@@ -140,7 +143,7 @@ TEST_P(DateTime, GetData) {
         EXPECT_EQ(col, expected_time_val) << "expected: " << params.expected_str_val;;
     }
 
-    if (params.format != "RowBinaryWithNamesAndTypes" || params.expected_sql_type != SQL_TYPE_DATE) {
+    if (!is_binary_format || params.expected_sql_type != SQL_TYPE_DATE) {
         SQL_TIMESTAMP_STRUCT col = {};
         SQLLEN col_ind = 0;
 
@@ -212,18 +215,30 @@ INSTANTIATE_TEST_SUITE_P(
         },
         DateTimeParams{"DateTime_TZ", "RowBinaryWithNamesAndTypes", "UTC",
             "toDateTime('2020-03-25 12:11:22', 'Asia/Kathmandu')", SQL_TYPE_TIMESTAMP,
-            "2020-03-25 06:26:22", SQL_TIMESTAMP_STRUCT{2020, 3, 25, 6, 26, 22, 0}
+            "2020-03-25 12:11:22", SQL_TIMESTAMP_STRUCT{2020, 3, 25, 12, 11, 22, 0}
         },
         DateTimeParams{"DateTime64_9_TZ", "RowBinaryWithNamesAndTypes", "UTC",
             "toDateTime64('2020-03-25 12:11:22.123456789', 9, 'Asia/Kathmandu')", SQL_TYPE_TIMESTAMP,
-            "2020-03-25 06:26:22.123456789", SQL_TIMESTAMP_STRUCT{2020, 3, 25, 6, 26, 22, 123456789}
+            "2020-03-25 12:11:22.123456789", SQL_TIMESTAMP_STRUCT{2020, 3, 25, 12, 11, 22, 123456789}
+        },
+        DateTimeParams{"Date", "Native", "UTC",
+            "toDate('2020-03-25')", SQL_TYPE_DATE,
+            "2020-03-25", SQL_TIMESTAMP_STRUCT{2020, 3, 25, 0, 0, 0, 0}
+        },
+        DateTimeParams{"DateTime_TZ", "Native", "UTC",
+            "toDateTime('2020-03-25 12:11:22', 'Asia/Kathmandu')", SQL_TYPE_TIMESTAMP,
+            "2020-03-25 12:11:22", SQL_TIMESTAMP_STRUCT{2020, 3, 25, 12, 11, 22, 0}
+        },
+        DateTimeParams{"DateTime64_9_TZ", "Native", "UTC",
+            "toDateTime64('2020-03-25 12:11:22.123456789', 9, 'Asia/Kathmandu')", SQL_TYPE_TIMESTAMP,
+            "2020-03-25 12:11:22.123456789", SQL_TIMESTAMP_STRUCT{2020, 3, 25, 12, 11, 22, 123456789}
         }/*,
 
         // TODO: uncomment once the target ClickHouse server is 21.4+
 
         DateTimeParams{"DateTime64_9_TZ_pre_epoch", "RowBinaryWithNamesAndTypes", "UTC",
             "toDateTime64('1955-03-25 12:11:22.123456789', 9, 'Asia/Kathmandu')", SQL_TYPE_TIMESTAMP,
-            "1955-03-25 09:26:22.123456789", SQL_TIMESTAMP_STRUCT{1955, 3, 25, 9, 26, 22, 123456789}
+            "1955-03-25 12:11:22.123456789", SQL_TIMESTAMP_STRUCT{1955, 3, 25, 12, 11, 22, 123456789}
         }
         */
     ),
@@ -323,3 +323,24 @@ TEST(EscapeSequencesCase, LTRIM) {
     ASSERT_EQ(replaceEscapeSequences("{fn LTRIM(`dm_ExperimentsData`.`Campaign`)}"),
         "replaceRegexpOne(`dm_ExperimentsData`.`Campaign`, '^\\\\s+', '')");
 }
+
+TEST(EscapeSequencesCase, NoEscapeSequences) {
+    ASSERT_EQ(replaceEscapeSequences(""), "");
+    ASSERT_EQ(replaceEscapeSequences("SELECT 1"), "SELECT 1");
+    ASSERT_EQ(replaceEscapeSequences("SELECT '}'"), "SELECT '}'");
+}
+
+TEST(EscapeSequencesCase, ManyEscapeSequences) {
+    std::string query = "SELECT ";
+    std::string expected = "SELECT ";
+
+    for (int i = 0; i < 100; ++i) {
+        query += "{fn UCASE({fn CONVERT(c" + std::to_string(i) + ", SQL_VARCHAR)})}, {ts '2017-01-01 10:01:01.555'}, ";
+        expected += "upperUTF8(toString(c" + std::to_string(i) + ")), toDateTime('2017-01-01 10:01:01'), ";
+    }
+
+    query += "{fn TIMESTAMPADD(SQL_TSI_DAY, 1, {fn CURDATE()})}";
+    expected += "addDays(today(), 1)";
+
+    ASSERT_EQ(replaceEscapeSequences(query), expected);
+}
@@ -22,3 +22,28 @@ TEST(LexerCase, ParseIdent) {
     tok = Lexer("Custom_SQL_Query.amount").Consume();
     ASSERT_STREQ(tok.literal.to_string().c_str(), "Custom_SQL_Query.amount");
 }
+
+TEST(LexerCase, ParseKeyword) {
+    ASSERT_EQ(Lexer("fn").Consume().type, Token::FN);
+    ASSERT_EQ(Lexer("TimestampAdd").Consume().type, Token::TIMESTAMPADD);
+    ASSERT_EQ(Lexer("SQL_TSI_DAY").Consume().type, Token::SQL_TSI_DAY);
+
+    // The names that are declared both as functions and as SQL_TSI_* intervals are functions.
+    ASSERT_EQ(Lexer("second").Consume().type, Token::SECOND);
+    ASSERT_EQ(Lexer("day").Consume().type, Token::SQL_TSI_DAY);
+
+    ASSERT_EQ(Lexer("timestampad").Consume().type, Token::IDENT);
+    ASSERT_EQ(Lexer("fnx").Consume().type, Token::IDENT);
+}
+
+TEST(LexerCase, LookAhead) {
+    Lexer lex("abs ( 1 )");
+    ASSERT_EQ(lex.LookAhead(2).type, Token::NUMBER);
+    ASSERT_EQ(lex.Peek().type, Token::ABS);
+    ASSERT_TRUE(lex.Match(Token::ABS));
+    ASSERT_EQ(lex.LookAhead(1).type, Token::NUMBER);
+    ASSERT_EQ(lex.Consume().type, Token::LPARENT);
+    ASSERT_EQ(lex.Consume().type, Token::NUMBER);
+    ASSERT_EQ(lex.Consume().type, Token::RPARENT);
+    ASSERT_EQ(lex.Consume().type, Token::EOS);
+}
@@ -5,6 +5,9 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <chrono>
+#include <thread>
+
 class MiscellaneousTest
     : public ClientTestBase
 {
@@ -149,6 +152,155 @@ TEST_F(MiscellaneousTest, NullableNothing) {
     EXPECT_EQ(nullable, SQL_NULLABLE);
 }
 
+TEST_F(MiscellaneousTest, CancelFromAnotherThread) {
+    // Would run for ages, if not killed.
+    auto query = fromUTF8<PTChar>("SELECT count() FROM system.numbers WHERE NOT ignore(sleepEachRow(0.001))");
+
+    auto cancel_thread = std::thread([hstmt = hstmt] () {
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+        SQLCancel(hstmt);
+    });
+
+    const auto started = std::chrono::steady_clock::now();
+    const auto rc = SQLExecDirect(hstmt, ptcharCast(query.data()), SQL_NTS);
+    const auto elapsed = std::chrono::steady_clock::now() - started;
+
+    cancel_thread.join();
+
+    ASSERT_EQ(rc, SQL_ERROR);
+    EXPECT_THAT(extract_diagnostics(hstmt, SQL_HANDLE_STMT), ::testing::HasSubstr("[HY008]"));
+    EXPECT_LT(elapsed, std::chrono::seconds(30));
+
+    // The statement is usable again.
+    auto next_query = fromUTF8<PTChar>("SELECT 1");
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLExecDirect(hstmt, ptcharCast(next_query.data()), SQL_NTS));
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLFetch(hstmt));
+}
+
+TEST_F(MiscellaneousTest, AsyncExecutionPolling) {
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLSetStmtAttr(hstmt, SQL_ATTR_ASYNC_ENABLE, (SQLPOINTER)SQL_ASYNC_ENABLE_ON, 0));
+
+    auto query = fromUTF8<PTChar>("SELECT sleep(1), 42");
+
+    SQLRETURN rc = SQLExecDirect(hstmt, ptcharCast(query.data()), SQL_NTS);
+    ASSERT_EQ(rc, SQL_STILL_EXECUTING);
+
+    std::size_t still_executing_count = 0;
+    while (rc == SQL_STILL_EXECUTING) {
+        ++still_executing_count;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        rc = SQLExecDirect(hstmt, ptcharCast(query.data()), SQL_NTS);
+    }
+
+    ODBC_CALL_ON_STMT_THROW(hstmt, rc);
+    EXPECT_GT(still_executing_count, 1);
+
+    SQLINTEGER value = 0;
+    SQLLEN indicator = 0;
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLFetch(hstmt));
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLGetData(hstmt, 2, SQL_C_SLONG, &value, sizeof(value), &indicator));
+    EXPECT_EQ(value, 42);
+    ASSERT_EQ(SQLFetch(hstmt), SQL_NO_DATA);
+}
+
+TEST_F(MiscellaneousTest, AsyncExecutionRefusesOtherCalls) {
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLSetStmtAttr(hstmt, SQL_ATTR_ASYNC_ENABLE, (SQLPOINTER)SQL_ASYNC_ENABLE_ON, 0));
+
+    auto query = fromUTF8<PTChar>("SELECT sleep(1), 42");
+    auto other_query = fromUTF8<PTChar>("SELECT 2");
+
+    SQLRETURN rc = SQLExecDirect(hstmt, ptcharCast(query.data()), SQL_NTS);
+    ASSERT_EQ(rc, SQL_STILL_EXECUTING);
+
+    ASSERT_EQ(SQLExecDirect(hstmt, ptcharCast(other_query.data()), SQL_NTS), SQL_ERROR);
+    EXPECT_THAT(extract_diagnostics(hstmt, SQL_HANDLE_STMT), ::testing::HasSubstr("[HY010]"));
+
+    ASSERT_EQ(SQLTables(hstmt, nullptr, 0, nullptr, 0, nullptr, 0, nullptr, 0), SQL_ERROR);
+    EXPECT_THAT(extract_diagnostics(hstmt, SQL_HANDLE_STMT), ::testing::HasSubstr("[HY010]"));
+
+    ASSERT_EQ(SQLPrepare(hstmt, ptcharCast(other_query.data()), SQL_NTS), SQL_ERROR);
+    EXPECT_THAT(extract_diagnostics(hstmt, SQL_HANDLE_STMT), ::testing::HasSubstr("[HY010]"));
+
+    ASSERT_EQ(SQLFetch(hstmt), SQL_ERROR);
+    EXPECT_THAT(extract_diagnostics(hstmt, SQL_HANDLE_STMT), ::testing::HasSubstr("[HY010]"));
+
+    // The pending function is neither replaced, nor dropped by the refused calls.
+    while (rc == SQL_STILL_EXECUTING) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        rc = SQLExecDirect(hstmt, ptcharCast(query.data()), SQL_NTS);
+    }
+
+    ODBC_CALL_ON_STMT_THROW(hstmt, rc);
+
+    SQLINTEGER value = 0;
+    SQLLEN indicator = 0;
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLFetch(hstmt));
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLGetData(hstmt, 2, SQL_C_SLONG, &value, sizeof(value), &indicator));
+    EXPECT_EQ(value, 42);
+}
+
+TEST_F(MiscellaneousTest, StatementsFetchedAlternately) {
+    SQLHSTMT hstmt2 = nullptr;
+    ODBC_CALL_ON_DBC_THROW(hdbc, SQLAllocHandle(SQL_HANDLE_STMT, hdbc, &hstmt2));
+
+    constexpr SQLBIGINT row_count = 100000;
+
+    // Big enough for the responses to be still in flight, while the rows are being fetched from both statements.
+    auto query = fromUTF8<PTChar>("SELECT number FROM numbers(" + std::to_string(row_count) + ")");
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLExecDirect(hstmt, ptcharCast(query.data()), SQL_NTS));
+    ODBC_CALL_ON_STMT_THROW(hstmt2, SQLExecDirect(hstmt2, ptcharCast(query.data()), SQL_NTS));
+
+    SQLBIGINT number = -1;
+    SQLBIGINT number2 = -1;
+    SQLLEN ind = 0;
+    SQLLEN ind2 = 0;
+
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLBindCol(hstmt, 1, SQL_C_SBIGINT, &number, sizeof(number), &ind));
+    ODBC_CALL_ON_STMT_THROW(hstmt2, SQLBindCol(hstmt2, 1, SQL_C_SBIGINT, &number2, sizeof(number2), &ind2));
+
+    for (SQLBIGINT expected = 0; expected < row_count; ++expected) {
+        ODBC_CALL_ON_STMT_THROW(hstmt, SQLFetch(hstmt));
+        ASSERT_EQ(number, expected);
+
+        ODBC_CALL_ON_STMT_THROW(hstmt2, SQLFetch(hstmt2));
+        ASSERT_EQ(number2, expected);
+    }
+
+    ASSERT_EQ(SQLFetch(hstmt), SQL_NO_DATA);
+    ASSERT_EQ(SQLFetch(hstmt2), SQL_NO_DATA);
+
+    ODBC_CALL_ON_STMT_THROW(hstmt2, SQLFreeHandle(SQL_HANDLE_STMT, hstmt2));
+}
+
+TEST_F(MiscellaneousTest, NamedSessionRunsOneQueryAtATime) {
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLFreeHandle(SQL_HANDLE_STMT, hstmt));
+    hstmt = nullptr;
+    SQLDisconnect(hdbc);
+
+    auto cs = fromUTF8<PTChar>("DSN=" + TestEnvironment::getInstance().getDSN() + ";AutoSessionId=on");
+    ODBC_CALL_ON_DBC_THROW(hdbc, SQLDriverConnect(hdbc, NULL, ptcharCast(cs.data()), SQL_NTS, NULL, 0, NULL, SQL_DRIVER_NOPROMPT));
+    ODBC_CALL_ON_DBC_THROW(hdbc, SQLAllocHandle(SQL_HANDLE_STMT, hdbc, &hstmt));
+
+    SQLHSTMT hstmt2 = nullptr;
+    ODBC_CALL_ON_DBC_THROW(hdbc, SQLAllocHandle(SQL_HANDLE_STMT, hdbc, &hstmt2));
+
+    // The response is far from being read completely, when the second query is executed, so the query is still running in the session.
+    auto query = fromUTF8<PTChar>("SELECT number FROM numbers(100000000)");
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLExecDirect(hstmt, ptcharCast(query.data()), SQL_NTS));
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLFetch(hstmt));
+
+    // Instead of failing with SESSION_IS_LOCKED, the second query closes the cursor of the first one.
+    auto query2 = fromUTF8<PTChar>("SELECT 1");
+    ODBC_CALL_ON_STMT_THROW(hstmt2, SQLExecDirect(hstmt2, ptcharCast(query2.data()), SQL_NTS));
+    ODBC_CALL_ON_STMT_THROW(hstmt2, SQLFetch(hstmt2));
+    ASSERT_EQ(SQLFetch(hstmt2), SQL_NO_DATA);
+
+    // There are no more rows to fetch from the closed cursor.
+    ASSERT_EQ(SQLFetch(hstmt), SQL_NO_DATA);
+
+    ODBC_CALL_ON_STMT_THROW(hstmt2, SQLFreeHandle(SQL_HANDLE_STMT, hstmt2));
+}
+
 enum class FailOn {
     Connect,
     Execute,
@@ -337,3 +489,98 @@ INSTANTIATE_TEST_SUITE_P(
         return std::get<0>(std::get<1>(param_info.param)) + "_with_" + std::get<0>(param_info.param);
     }
 );
+
+class HTTPCompression
+    : public ClientTestWithParamBase<
+        std::tuple<
+            std::string, // parameter set name
+            std::string  // extra name=value semicolon-separated string to append to the connection string
+        >
+    >
+{
+private:
+    using Base = ClientTestWithParamBase<std::tuple<std::string, std::string>>;
+
+public:
+    HTTPCompression()
+        : Base(/*skip_connect = */true)
+    {
+    }
+
+    void connect(const std::string & connection_string) {
+        ASSERT_EQ(hstmt, nullptr);
+
+        auto cs = fromUTF8<PTChar>(connection_string);
+
+        ODBC_CALL_ON_DBC_THROW(hdbc, SQLDriverConnect(hdbc, NULL, ptcharCast(cs.data()), SQL_NTS, NULL, 0, NULL, SQL_DRIVER_NOPROMPT));
+        ODBC_CALL_ON_DBC_THROW(hdbc, SQLAllocHandle(SQL_HANDLE_STMT, hdbc, &hstmt));
+    }
+};
+
+TEST_P(HTTPCompression, FetchAll) {
+    const auto & [/* unused */name, cs_extras] = GetParam();
+
+    const auto & dsn = TestEnvironment::getInstance().getDSN();
+    const auto cs = "DSN=" + dsn + ";" + cs_extras;
+    connect(cs);
+
+    constexpr SQLBIGINT row_count = 100000;
+
+    // Execute the query twice, to make sure that the connection stays usable after the compressed response is fully read.
+    for (int i = 0; i < 2; ++i) {
+        auto query = fromUTF8<PTChar>("SELECT number, toString(number) FROM numbers(" + std::to_string(row_count) + ")");
+        ODBC_CALL_ON_STMT_THROW(hstmt, SQLExecDirect(hstmt, ptcharCast(query.data()), SQL_NTS));
+
+        SQLBIGINT number = -1;
+        SQLLEN number_ind = 0;
+        SQLCHAR str[32] = {};
+        SQLLEN str_ind = 0;
+
+        ODBC_CALL_ON_STMT_THROW(hstmt, SQLBindCol(hstmt, 1, SQL_C_SBIGINT, &number, sizeof(number), &number_ind));
+        ODBC_CALL_ON_STMT_THROW(hstmt, SQLBindCol(hstmt, 2, SQL_C_CHAR, &str, sizeof(str), &str_ind));
+
+        SQLBIGINT expected = 0;
+        while (true) {
+            const auto rc = SQLFetch(hstmt);
+
+            if (rc == SQL_NO_DATA)
+                break;
+
+            ODBC_CALL_ON_STMT_THROW(hstmt, rc);
+
+            ASSERT_EQ(number, expected);
+            ASSERT_EQ(std::string(reinterpret_cast<char *>(str), str_ind), std::to_string(expected));
+            ++expected;
+        }
+
+        ASSERT_EQ(expected, row_count);
+
+        ODBC_CALL_ON_STMT_THROW(hstmt, SQLFreeStmt(hstmt, SQL_CLOSE));
+        ODBC_CALL_ON_STMT_THROW(hstmt, SQLFreeStmt(hstmt, SQL_UNBIND));
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    MiscellaneousTest,
+    HTTPCompression,
+    ::testing::Values(
+        std::make_tuple("Compression_Default", ""),
+        std::make_tuple("Compression_Off",     "Compression=off"),
+        std::make_tuple("Compression_On",      "Compression=on"),
+        std::make_tuple("Compression_Gzip",    "Compression=gzip"),
+        std::make_tuple("Compression_Deflate", "Compression=deflate"),
+        std::make_tuple("Compression_LZ4",     "Compression=lz4"),
+        std::make_tuple("RequestCompression_Off",     "RequestCompression=off"),
+        std::make_tuple("RequestCompression_Gzip",    "RequestCompression=gzip"),
+        std::make_tuple("RequestCompression_Deflate", "RequestCompression=deflate"),
+        std::make_tuple("RequestCompression_LZ4",     "RequestCompression=lz4"),
+        std::make_tuple("BothCompressions_LZ4",       "Compression=lz4;RequestCompression=lz4"),
+        std::make_tuple("BackgroundFetch_1",          "BackgroundFetch=1"),
+        std::make_tuple("BackgroundFetch_4",          "BackgroundFetch=4"),
+        std::make_tuple("BackgroundFetch_4_LZ4",      "BackgroundFetch=4;Compression=lz4"),
+        std::make_tuple("SessionPooling_On",          "SessionPooling=on")
+    ),
+    [] (const auto & param_info) {
+        return std::get<0>(param_info.param);
+    }
+);
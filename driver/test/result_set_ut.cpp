@@ -0,0 +1,914 @@
+#include "driver/result_set.h"
+
+#include <Poco/Net/ServerSocket.h>
+#include <Poco/Net/SocketStream.h>
+#include <Poco/Net/StreamSocket.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <thread>
+
+class ResultSetReaderTest
+    : public ::testing::Test
+{
+protected:
+    void writeSize(std::uint64_t value) {
+        do {
+            std::uint8_t byte = value & 0b01111111;
+            value >>= 7;
+            if (value != 0)
+                byte |= 0b10000000;
+            data.push_back(static_cast<char>(byte));
+        } while (value != 0);
+    }
+
+    void writeString(const std::string & value) {
+        writeSize(value.size());
+        data += value;
+    }
+
+    template <typename T>
+    void writePOD(const T & value) {
+        data.append(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+    ResultSet & read(const std::string & format, std::unique_ptr<ResultMutator> && mutator = {}, std::size_t read_buffer_size = AmortizedIStreamReader::default_min_read_size) {
+        stream.str(data);
+        reader = make_result_reader(format, "UTC", stream, std::move(mutator), read_buffer_size);
+        return reader->getResultSet();
+    }
+
+    std::string extractString(ResultSet & result_set, std::size_t row_idx, std::size_t column_idx) {
+        char buffer[256] = {};
+        SQLLEN indicator = 0;
+
+        BindingInfo binding_info;
+        binding_info.c_type = SQL_C_CHAR;
+        binding_info.value = buffer;
+        binding_info.value_max_size = sizeof(buffer);
+        binding_info.value_size = &indicator;
+        binding_info.indicator = &indicator;
+
+        EXPECT_TRUE(SQL_SUCCEEDED(result_set.extractField(row_idx, column_idx, binding_info)));
+
+        if (indicator == SQL_NULL_DATA)
+            return "NULL";
+
+        return buffer;
+    }
+
+protected:
+    std::string data;
+    std::istringstream stream;
+    std::unique_ptr<ResultReader> reader;
+};
+
+class AlternatingResultMutator
+    : public ResultMutator
+{
+public:
+    virtual void transformRow(const std::vector<ColumnInfo> & columns_info, Row & row) override {
+        if (row_count++ % 2 == 0)
+            row.fields[0].data = DataSourceType<DataSourceTypeId::String>{"mutated"};
+    }
+
+private:
+    std::size_t row_count = 0;
+};
+
+TEST_F(ResultSetReaderTest, NativeMultipleBlocks) {
+    constexpr std::size_t num_blocks = 3;
+    constexpr std::size_t num_rows = 70;
+
+    for (std::size_t block = 0; block < num_blocks; ++block) {
+        writeSize(2);
+        writeSize(num_rows);
+
+        writeString("num");
+        writeString("Int32");
+        for (std::size_t i = 0; i < num_rows; ++i) {
+            writePOD<std::int32_t>(block * 1000 + i);
+        }
+
+        writeString("str");
+        writeString("Nullable(String)");
+        for (std::size_t i = 0; i < num_rows; ++i) {
+            writePOD<std::uint8_t>(i % 3 == 0 ? 1 : 0);
+        }
+        for (std::size_t i = 0; i < num_rows; ++i) {
+            writeString(i % 3 == 0 ? "" : "value" + std::to_string(block * 1000 + i));
+        }
+    }
+
+    auto & result_set = read("Native");
+    ASSERT_EQ(result_set.getColumnCount(), 2);
+    EXPECT_EQ(result_set.getColumnInfo(0).name, "num");
+    EXPECT_EQ(result_set.getColumnInfo(1).type, "Nullable(String)");
+
+    std::size_t row_count = 0;
+    while (const auto row_set_size = result_set.fetchRowSet(SQL_FETCH_NEXT, 0, 33)) {
+        for (std::size_t row_idx = 0; row_idx < row_set_size; ++row_idx, ++row_count) {
+            const auto expected = (row_count / num_rows) * 1000 + (row_count % num_rows);
+            EXPECT_EQ(extractString(result_set, row_idx, 0), std::to_string(expected));
+            EXPECT_EQ(extractString(result_set, row_idx, 1), (row_count % num_rows % 3 == 0 ? "NULL" : "value" + std::to_string(expected)));
+        }
+    }
+
+    EXPECT_EQ(row_count, num_blocks * num_rows);
+}
+
+TEST_F(ResultSetReaderTest, NativeResolvedExtractors) {
+    constexpr std::size_t num_rows = 4;
+
+    writeSize(2);
+    writeSize(num_rows);
+
+    writeString("num");
+    writeString("Nullable(Int32)");
+    for (std::size_t i = 0; i < num_rows; ++i) {
+        writePOD<std::uint8_t>(i == 1 ? 1 : 0);
+    }
+    for (std::size_t i = 0; i < num_rows; ++i) {
+        writePOD<std::int32_t>(i * 10);
+    }
+
+    writeString("str");
+    writeString("String");
+    for (std::size_t i = 0; i < num_rows; ++i) {
+        writeString(std::to_string(i * 100));
+    }
+
+    auto & result_set = read("Native");
+    ASSERT_EQ(result_set.fetchRowSet(SQL_FETCH_NEXT, 0, num_rows), num_rows);
+
+    // Both columns are read as integers, and as strings, via the extractors resolved once for the row set.
+    const auto num_as_int = result_set.getExtractor(0, SQL_C_SBIGINT);
+    const auto str_as_int = result_set.getExtractor(1, SQL_C_SBIGINT);
+    const auto num_as_str = result_set.getExtractor(0, SQL_C_CHAR);
+    const auto str_as_str = result_set.getExtractor(1, SQL_C_CHAR);
+
+    for (std::size_t row_idx = 0; row_idx < num_rows; ++row_idx) {
+        SQLBIGINT value = -1;
+        char buffer[32] = {};
+        SQLLEN indicator = 0;
+
+        BindingInfo int_binding;
+        int_binding.c_type = SQL_C_SBIGINT;
+        int_binding.value = &value;
+        int_binding.indicator = &indicator;
+
+        BindingInfo str_binding;
+        str_binding.c_type = SQL_C_CHAR;
+        str_binding.value = buffer;
+        str_binding.value_max_size = sizeof(buffer);
+        str_binding.value_size = &indicator;
+        str_binding.indicator = &indicator;
+
+        ASSERT_TRUE(SQL_SUCCEEDED(result_set.extractField(row_idx, 0, num_as_int, int_binding)));
+        if (row_idx == 1) {
+            EXPECT_EQ(indicator, SQL_NULL_DATA);
+        }
+        else {
+            EXPECT_EQ(value, row_idx * 10);
+        }
+
+        ASSERT_TRUE(SQL_SUCCEEDED(result_set.extractField(row_idx, 0, num_as_str, str_binding)));
+        EXPECT_EQ(std::string(buffer), (row_idx == 1 ? "" : std::to_string(row_idx * 10)));
+
+        ASSERT_TRUE(SQL_SUCCEEDED(result_set.extractField(row_idx, 1, str_as_int, int_binding)));
+        EXPECT_EQ(value, row_idx * 100);
+
+        ASSERT_TRUE(SQL_SUCCEEDED(result_set.extractField(row_idx, 1, str_as_str, str_binding)));
+        EXPECT_EQ(std::string(buffer), std::to_string(row_idx * 100));
+    }
+
+    // Nulls are written regardless of the C type, but values can't be written to an unsupported one.
+    SQLLEN indicator = 0;
+    BindingInfo binding_info;
+    binding_info.c_type = SQL_C_DEFAULT;
+    binding_info.indicator = &indicator;
+
+    const auto num_as_unsupported = result_set.getExtractor(0, SQL_C_DEFAULT);
+    ASSERT_TRUE(SQL_SUCCEEDED(result_set.extractField(1, 0, num_as_unsupported, binding_info)));
+    EXPECT_EQ(indicator, SQL_NULL_DATA);
+    EXPECT_THROW(result_set.extractField(0, 0, num_as_unsupported, binding_info), std::runtime_error);
+
+    EXPECT_THROW(result_set.getExtractor(2, SQL_C_CHAR), SqlException);
+}
+
+TEST_F(ResultSetReaderTest, NativeColumnWiseExtraction) {
+    constexpr std::size_t num_rows = 5;
+
+    writeSize(3);
+    writeSize(num_rows);
+
+    writeString("num");
+    writeString("Nullable(Int32)");
+    for (std::size_t i = 0; i < num_rows; ++i) {
+        writePOD<std::uint8_t>(i == 2 ? 1 : 0);
+    }
+    for (std::size_t i = 0; i < num_rows; ++i) {
+        writePOD<std::int32_t>(i * 10 - 20);
+    }
+
+    writeString("dbl");
+    writeString("Float64");
+    for (std::size_t i = 0; i < num_rows; ++i) {
+        writePOD<double>(i + 0.5);
+    }
+
+    writeString("flag");
+    writeString("UInt8");
+    for (std::size_t i = 0; i < num_rows; ++i) {
+        writePOD<std::uint8_t>(i % 2);
+    }
+
+    auto & result_set = read("Native");
+    ASSERT_EQ(result_set.fetchRowSet(SQL_FETCH_NEXT, 0, 2), 2);
+    ASSERT_EQ(result_set.fetchRowSet(SQL_FETCH_NEXT, 0, 10), 3);
+
+    SQLINTEGER nums[3] = {};
+    SQLLEN num_inds[3] = {};
+
+    BindingInfo num_binding;
+    num_binding.c_type = SQL_C_SLONG;
+    num_binding.value = nums;
+    num_binding.value_max_size = sizeof(nums[0]);
+    num_binding.indicator = num_inds;
+
+    ASSERT_TRUE(result_set.extractColumn(0, num_binding));
+    EXPECT_EQ(num_inds[0], SQL_NULL_DATA);
+    EXPECT_EQ(num_inds[1], 0);
+    EXPECT_EQ(nums[1], 10);
+    EXPECT_EQ(num_inds[2], 0);
+    EXPECT_EQ(nums[2], 20);
+
+    SQLDOUBLE dbls[3] = {};
+    SQLLEN dbl_sizes[3] = {};
+
+    BindingInfo dbl_binding;
+    dbl_binding.c_type = SQL_C_DOUBLE;
+    dbl_binding.value = dbls;
+    dbl_binding.value_max_size = sizeof(dbls[0]);
+    dbl_binding.value_size = dbl_sizes;
+    dbl_binding.indicator = dbl_sizes;
+
+    ASSERT_TRUE(result_set.extractColumn(1, dbl_binding));
+    for (std::size_t i = 0; i < 3; ++i) {
+        EXPECT_EQ(dbls[i], i + 2.5);
+        EXPECT_EQ(dbl_sizes[i], sizeof(SQLDOUBLE));
+    }
+
+    // Values that need a conversion are left to the regular extraction.
+    SQLBIGINT wide_nums[3] = {};
+    num_binding.c_type = SQL_C_SBIGINT;
+    num_binding.value = wide_nums;
+    num_binding.value_max_size = sizeof(wide_nums[0]);
+    EXPECT_FALSE(result_set.extractColumn(0, num_binding));
+
+    SQLCHAR flags[3] = {};
+    BindingInfo flag_binding;
+    flag_binding.c_type = SQL_C_BIT;
+    flag_binding.value = flags;
+    flag_binding.value_max_size = sizeof(flags[0]);
+    EXPECT_FALSE(result_set.extractColumn(2, flag_binding));
+
+    flag_binding.c_type = SQL_C_UTINYINT;
+    ASSERT_TRUE(result_set.extractColumn(2, flag_binding));
+    EXPECT_EQ(flags[0], 0);
+    EXPECT_EQ(flags[1], 1);
+    EXPECT_EQ(flags[2], 0);
+
+    // Rows that are not adjacent in the bound arrays.
+    SQLINTEGER sparse_nums[6] = {};
+    num_binding.c_type = SQL_C_SLONG;
+    num_binding.value = sparse_nums;
+    num_binding.value_max_size = sizeof(sparse_nums[0]) * 2;
+    EXPECT_FALSE(result_set.extractColumn(0, num_binding));
+    EXPECT_EQ(sparse_nums[2], 0);
+}
+
+TEST_F(ResultSetReaderTest, NativeGetDataInPieces) {
+    constexpr std::size_t num_rows = 2;
+
+    writeSize(2);
+    writeSize(num_rows);
+
+    writeString("str");
+    writeString("Nullable(String)");
+    writePOD<std::uint8_t>(0);
+    writePOD<std::uint8_t>(1);
+    writeString("0123456789");
+    writeString("");
+
+    writeString("num");
+    writeString("Int32");
+    writePOD<std::int32_t>(42);
+    writePOD<std::int32_t>(43);
+
+    auto & result_set = read("Native");
+    ASSERT_EQ(result_set.fetchRowSet(SQL_FETCH_NEXT, 0, num_rows), num_rows);
+
+    const auto expect_truncated = [] (auto && call) {
+        try {
+            call();
+            ADD_FAILURE() << "Truncation expected";
+        }
+        catch (const SqlException & ex) {
+            EXPECT_EQ(ex.getSQLState(), "01004");
+            EXPECT_EQ(ex.getReturnCode(), SQL_SUCCESS_WITH_INFO);
+        }
+    };
+
+    char buffer[5] = {};
+    SQLLEN size = 0;
+
+    BindingInfo binding_info;
+    binding_info.c_type = SQL_C_CHAR;
+    binding_info.value = buffer;
+    binding_info.value_max_size = sizeof(buffer);
+    binding_info.value_size = &size;
+    binding_info.indicator = &size;
+
+    // Each piece reports the length of the rest of the value.
+    expect_truncated([&] { result_set.getData(0, 0, binding_info); });
+    EXPECT_EQ(std::string(buffer), "0123");
+    EXPECT_EQ(size, 10);
+
+    expect_truncated([&] { result_set.getData(0, 0, binding_info); });
+    EXPECT_EQ(std::string(buffer), "4567");
+    EXPECT_EQ(size, 6);
+
+    EXPECT_EQ(result_set.getData(0, 0, binding_info), SQL_SUCCESS);
+    EXPECT_EQ(std::string(buffer), "89");
+    EXPECT_EQ(size, 2);
+
+    EXPECT_EQ(result_set.getData(0, 0, binding_info), SQL_NO_DATA);
+
+    // Switching the target type starts over.
+    char16_t wide_buffer[8] = {};
+    binding_info.c_type = SQL_C_WCHAR;
+    binding_info.value = wide_buffer;
+    binding_info.value_max_size = sizeof(wide_buffer);
+
+    expect_truncated([&] { result_set.getData(0, 0, binding_info); });
+    EXPECT_EQ(std::u16string(wide_buffer), u"0123456");
+    EXPECT_EQ(size, 10 * sizeof(char16_t));
+
+    EXPECT_EQ(result_set.getData(0, 0, binding_info), SQL_SUCCESS);
+    EXPECT_EQ(std::u16string(wide_buffer), u"789");
+    EXPECT_EQ(size, 3 * sizeof(char16_t));
+
+    // Binary pieces don't reserve space for a null terminator.
+    binding_info.c_type = SQL_C_BINARY;
+    binding_info.value = buffer;
+    binding_info.value_max_size = sizeof(buffer);
+
+    expect_truncated([&] { result_set.getData(0, 0, binding_info); });
+    EXPECT_EQ(std::string(buffer, sizeof(buffer)), "01234");
+    EXPECT_EQ(result_set.getData(0, 0, binding_info), SQL_SUCCESS);
+    EXPECT_EQ(std::string(buffer, sizeof(buffer)), "56789");
+    EXPECT_EQ(result_set.getData(0, 0, binding_info), SQL_NO_DATA);
+
+    // Fixed-length values are returned by the first call only.
+    SQLINTEGER num = 0;
+    BindingInfo num_binding;
+    num_binding.c_type = SQL_C_SLONG;
+    num_binding.value = &num;
+    num_binding.value_max_size = sizeof(num);
+
+    EXPECT_EQ(result_set.getData(0, 1, num_binding), SQL_SUCCESS);
+    EXPECT_EQ(num, 42);
+    EXPECT_EQ(result_set.getData(0, 1, num_binding), SQL_NO_DATA);
+
+    binding_info.c_type = SQL_C_CHAR;
+    EXPECT_EQ(result_set.getData(1, 0, binding_info), SQL_SUCCESS);
+    EXPECT_EQ(size, SQL_NULL_DATA);
+    EXPECT_EQ(result_set.getData(1, 0, binding_info), SQL_NO_DATA);
+
+    // A new row set resets the state.
+    EXPECT_EQ(result_set.fetchRowSet(SQL_FETCH_NEXT, 0, num_rows), 0);
+    EXPECT_THROW(result_set.getData(0, 0, binding_info), SqlException);
+}
+
+TEST_F(ResultSetReaderTest, RowBinaryNullsAcrossRowSets) {
+    constexpr std::size_t num_rows = 300;
+
+    writeSize(2);
+    writeString("num");
+    writeString("str");
+    writeString("Nullable(UInt8)");
+    writeString("String");
+
+    for (std::size_t i = 0; i < num_rows; ++i) {
+        if (i < 5 || i % 4 == 0) {
+            writePOD<std::uint8_t>(1);
+        }
+        else {
+            writePOD<std::uint8_t>(0);
+            writePOD<std::uint8_t>(i % 256);
+        }
+        writeString("value" + std::to_string(i));
+    }
+
+    auto & result_set = read("RowBinaryWithNamesAndTypes");
+
+    std::size_t row_count = 0;
+    while (const auto row_set_size = result_set.fetchRowSet(SQL_FETCH_NEXT, 0, 7)) {
+        for (std::size_t row_idx = 0; row_idx < row_set_size; ++row_idx, ++row_count) {
+            EXPECT_EQ(extractString(result_set, row_idx, 0), ((row_count < 5 || row_count % 4 == 0) ? "NULL" : std::to_string(row_count % 256)));
+            EXPECT_EQ(extractString(result_set, row_idx, 1), "value" + std::to_string(row_count));
+        }
+    }
+
+    EXPECT_EQ(row_count, num_rows);
+}
+
+TEST_F(ResultSetReaderTest, MutatedValuesOfDifferentTypes) {
+    constexpr std::size_t num_rows = 150;
+
+    writeSize(1);
+    writeSize(num_rows);
+    writeString("num");
+    writeString("UInt64");
+    for (std::size_t i = 0; i < num_rows; ++i) {
+        writePOD<std::uint64_t>(i);
+    }
+
+    auto & result_set = read("Native", std::make_unique<AlternatingResultMutator>());
+
+    std::size_t row_count = 0;
+    while (const auto row_set_size = result_set.fetchRowSet(SQL_FETCH_NEXT, 0, 10)) {
+        for (std::size_t row_idx = 0; row_idx < row_set_size; ++row_idx, ++row_count) {
+            EXPECT_EQ(extractString(result_set, row_idx, 0), (row_count % 2 == 0 ? "mutated" : std::to_string(row_count)));
+        }
+    }
+
+    EXPECT_EQ(row_count, num_rows);
+}
+
+class PassThroughResultMutator
+    : public ResultMutator
+{
+public:
+    virtual void transformRow(const std::vector<ColumnInfo> & columns_info, Row & row) override {
+    }
+};
+
+class RowBinaryDecoderPlanTest
+    : public ResultSetReaderTest
+    , public ::testing::WithParamInterface<bool> // Whether the rows are read one by one, through a mutator.
+{
+protected:
+    static constexpr std::size_t num_rows = 50;
+
+    void writeData() {
+        writeSize(7);
+        writeString("i8");
+        writeString("ni32");
+        writeString("u64");
+        writeString("f64");
+        writeString("nstr");
+        writeString("fixed");
+        writeString("nu16");
+        writeString("Int8");
+        writeString("Nullable(Int32)");
+        writeString("UInt64");
+        writeString("Float64");
+        writeString("Nullable(String)");
+        writeString("FixedString(2)");
+        writeString("Nullable(UInt16)");
+
+        for (std::size_t i = 0; i < num_rows; ++i) {
+            writePOD<std::int8_t>(-static_cast<std::int8_t>(i));
+
+            if (i % 3 == 0) {
+                writePOD<std::uint8_t>(1);
+            }
+            else {
+                writePOD<std::uint8_t>(0);
+                writePOD<std::int32_t>(i * 100000);
+            }
+
+            writePOD<std::uint64_t>(i * 10000000000ull);
+            writePOD<double>(i + 0.5);
+
+            if (i % 2 == 0) {
+                writePOD<std::uint8_t>(1);
+            }
+            else {
+                writePOD<std::uint8_t>(0);
+                writeString("s" + std::to_string(i));
+            }
+
+            data += std::string(2, 'a' + i % 26);
+
+            if (i % 5 == 0) {
+                writePOD<std::uint8_t>(1);
+            }
+            else {
+                writePOD<std::uint8_t>(0);
+                writePOD<std::uint16_t>(i);
+            }
+        }
+    }
+
+    std::unique_ptr<ResultMutator> makeMutator() {
+        if (GetParam())
+            return std::make_unique<PassThroughResultMutator>();
+        return {};
+    }
+};
+
+TEST_P(RowBinaryDecoderPlanTest, MixedNullableAndNonNullableColumns) {
+    writeData();
+    auto & result_set = read("RowBinaryWithNamesAndTypes", makeMutator());
+
+    std::size_t row_count = 0;
+    while (const auto row_set_size = result_set.fetchRowSet(SQL_FETCH_NEXT, 0, 8)) {
+        for (std::size_t row_idx = 0; row_idx < row_set_size; ++row_idx, ++row_count) {
+            const auto i = row_count;
+            EXPECT_EQ(extractString(result_set, row_idx, 0), std::to_string(-static_cast<int>(i)));
+            EXPECT_EQ(extractString(result_set, row_idx, 1), (i % 3 == 0 ? "NULL" : std::to_string(i * 100000)));
+            EXPECT_EQ(extractString(result_set, row_idx, 2), std::to_string(i * 10000000000ull));
+            EXPECT_EQ(std::stod(extractString(result_set, row_idx, 3)), i + 0.5);
+            EXPECT_EQ(extractString(result_set, row_idx, 4), (i % 2 == 0 ? "NULL" : "s" + std::to_string(i)));
+            EXPECT_EQ(extractString(result_set, row_idx, 5), std::string(2, 'a' + i % 26));
+            EXPECT_EQ(extractString(result_set, row_idx, 6), (i % 5 == 0 ? "NULL" : std::to_string(i)));
+        }
+    }
+
+    EXPECT_EQ(row_count, num_rows);
+}
+
+TEST_P(RowBinaryDecoderPlanTest, DateAndTimeColumns) {
+    writeSize(2);
+    writeString("d");
+    writeString("dt");
+    writeString("Date");
+    writeString("Nullable(DateTime)");
+
+    writePOD<std::uint16_t>(18262); // 2020-01-01
+    writePOD<std::uint8_t>(0);
+    writePOD<std::uint32_t>(1577934245); // 2020-01-02 03:04:05
+
+    writePOD<std::uint16_t>(0); // 1970-01-01
+    writePOD<std::uint8_t>(1);
+
+    auto & result_set = read("RowBinaryWithNamesAndTypes", makeMutator());
+
+    ASSERT_EQ(result_set.fetchRowSet(SQL_FETCH_NEXT, 0, 8), 2);
+    EXPECT_EQ(extractString(result_set, 0, 0), "2020-01-01");
+    EXPECT_EQ(extractString(result_set, 0, 1), "2020-01-02 03:04:05");
+    EXPECT_EQ(extractString(result_set, 1, 0), "1970-01-01");
+    EXPECT_EQ(extractString(result_set, 1, 1), "NULL");
+}
+
+INSTANTIATE_TEST_SUITE_P(RowByRow, RowBinaryDecoderPlanTest, ::testing::Values(false, true),
+    [] (const auto & info) { return (info.param ? "WithMutator" : "ColumnWise"); }
+);
+
+TEST_F(ResultSetReaderTest, RowBinaryStringsAcrossRowSets) {
+    constexpr std::size_t num_rows = 100;
+
+    writeSize(2);
+    writeString("str");
+    writeString("fixed");
+    writeString("String");
+    writeString("FixedString(3)");
+
+    for (std::size_t i = 0; i < num_rows; ++i) {
+        writeString(std::to_string(i * 1000));
+        data += std::string(3, 'a' + i % 26);
+    }
+
+    auto & result_set = read("RowBinaryWithNamesAndTypes");
+
+    std::size_t row_count = 0;
+    while (const auto row_set_size = result_set.fetchRowSet(SQL_FETCH_NEXT, 0, 7)) {
+        for (std::size_t row_idx = 0; row_idx < row_set_size; ++row_idx, ++row_count) {
+            EXPECT_EQ(extractString(result_set, row_idx, 0), std::to_string(row_count * 1000));
+            EXPECT_EQ(extractString(result_set, row_idx, 1), std::string(3, 'a' + row_count % 26));
+
+            SQLINTEGER value = 0;
+            SQLLEN indicator = 0;
+
+            BindingInfo binding_info;
+            binding_info.c_type = SQL_C_SLONG;
+            binding_info.value = &value;
+            binding_info.value_max_size = sizeof(value);
+            binding_info.value_size = &indicator;
+            binding_info.indicator = &indicator;
+
+            EXPECT_TRUE(SQL_SUCCEEDED(result_set.extractField(row_idx, 0, binding_info)));
+            EXPECT_EQ(value, row_count * 1000);
+        }
+    }
+
+    EXPECT_EQ(row_count, num_rows);
+}
+
+TEST_F(ResultSetReaderTest, NativeBackgroundReading) {
+    constexpr std::size_t num_blocks = 20;
+    constexpr std::size_t num_rows = 500;
+
+    for (std::size_t block = 0; block < num_blocks; ++block) {
+        writeSize(1);
+        writeSize(num_rows);
+        writeString("str");
+        writeString("Nullable(String)");
+        for (std::size_t i = 0; i < num_rows; ++i) {
+            writePOD<std::uint8_t>(i % 5 == 0 ? 1 : 0);
+        }
+        for (std::size_t i = 0; i < num_rows; ++i) {
+            writeString(i % 5 == 0 ? "" : std::to_string(block * num_rows + i));
+        }
+    }
+
+    auto & result_set = read("Native");
+    result_set.startBackgroundReading(2);
+
+    std::size_t row_count = 0;
+    while (const auto row_set_size = result_set.fetchRowSet(SQL_FETCH_NEXT, 0, 333)) {
+        for (std::size_t row_idx = 0; row_idx < row_set_size; ++row_idx, ++row_count) {
+            EXPECT_EQ(extractString(result_set, row_idx, 0), (row_count % num_rows % 5 == 0 ? "NULL" : std::to_string(row_count)));
+        }
+    }
+
+    EXPECT_EQ(row_count, num_blocks * num_rows);
+}
+
+TEST_F(ResultSetReaderTest, RowBinaryBackgroundReading) {
+    constexpr std::size_t num_rows = 5000;
+
+    writeSize(2);
+    writeString("num");
+    writeString("str");
+    writeString("Nullable(Int64)");
+    writeString("String");
+
+    for (std::size_t i = 0; i < num_rows; ++i) {
+        if (i % 7 == 0) {
+            writePOD<std::uint8_t>(1);
+        }
+        else {
+            writePOD<std::uint8_t>(0);
+            writePOD<std::int64_t>(i);
+        }
+        writeString("value" + std::to_string(i));
+    }
+
+    auto & result_set = read("RowBinaryWithNamesAndTypes");
+    result_set.startBackgroundReading(1);
+
+    std::size_t row_count = 0;
+    while (const auto row_set_size = result_set.fetchRowSet(SQL_FETCH_NEXT, 0, 64)) {
+        for (std::size_t row_idx = 0; row_idx < row_set_size; ++row_idx, ++row_count) {
+            EXPECT_EQ(extractString(result_set, row_idx, 0), (row_count % 7 == 0 ? "NULL" : std::to_string(row_count)));
+            EXPECT_EQ(extractString(result_set, row_idx, 1), "value" + std::to_string(row_count));
+        }
+    }
+
+    EXPECT_EQ(row_count, num_rows);
+}
+
+TEST_F(ResultSetReaderTest, BackgroundReadingInterruptedByShutdown) {
+    Poco::Net::ServerSocket server{Poco::Net::SocketAddress("127.0.0.1", 0)};
+    Poco::Net::StreamSocket client;
+    client.connect(server.address());
+    auto peer = server.acceptConnection();
+
+    writeSize(1);
+    writeString("num");
+    writeString("UInt32");
+    for (std::uint32_t i = 0; i < AmortizedIStreamReader::default_min_read_size / 2; ++i) {
+        writePOD<std::uint32_t>(i);
+    }
+
+    // The server keeps the connection open, and sends nothing more, so the background thread blocks in a read, once it has decoded what was sent.
+    peer.sendBytes(data.data(), data.size());
+
+    Poco::Net::SocketStream client_stream(client);
+    reader = make_result_reader("RowBinaryWithNamesAndTypes", "UTC", client_stream, {}, AmortizedIStreamReader::default_min_read_size);
+
+    auto & result_set = reader->getResultSet();
+    result_set.startBackgroundReading(16);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_TRUE(result_set.isReadingInBackground());
+
+    ::shutdown(client.impl()->sockfd(), 2);
+
+    const auto started = std::chrono::steady_clock::now();
+    reader.reset();
+    EXPECT_LT(std::chrono::steady_clock::now() - started, std::chrono::seconds(5));
+}
+
+TEST_F(ResultSetReaderTest, NativeSmallReadBuffer) {
+    constexpr std::size_t num_rows = 200;
+
+    writeSize(2);
+    writeSize(num_rows);
+
+    writeString("num");
+    writeString("Int64");
+    for (std::size_t i = 0; i < num_rows; ++i) {
+        writePOD<std::int64_t>(i);
+    }
+
+    writeString("str");
+    writeString("String");
+    for (std::size_t i = 0; i < num_rows; ++i) {
+        writeString(std::string(i % 50, 'a' + i % 26));
+    }
+
+    // Values of at least 16 bytes bypass the buffer of the stream.
+    auto & result_set = read("Native", {}, 16);
+
+    std::size_t row_count = 0;
+    while (const auto row_set_size = result_set.fetchRowSet(SQL_FETCH_NEXT, 0, 30)) {
+        for (std::size_t row_idx = 0; row_idx < row_set_size; ++row_idx, ++row_count) {
+            EXPECT_EQ(extractString(result_set, row_idx, 0), std::to_string(row_count));
+            EXPECT_EQ(extractString(result_set, row_idx, 1), std::string(row_count % 50, 'a' + row_count % 26));
+        }
+    }
+
+    EXPECT_EQ(row_count, num_rows);
+}
+
+TEST_F(ResultSetReaderTest, WideDecimalsAndIntegers) {
+    // Little-endian two's complement representation of -(2^127) + 1 and 2^128 - 1.
+    const std::string int128_min_plus_one = std::string(1, '\x01') + std::string(14, '\x00') + std::string(1, '\x80');
+    const std::string uint128_max(16, '\xFF');
+
+    // -12345678901234567890.1234 as Decimal(38, 4), i.e., -123456789012345678901234 as a 128-bit integer.
+    const std::string decimal128_negative("\x0E\x50\x69\x93\x5F\xEF\xE0\x64\xDB\xE5\xFF\xFF\xFF\xFF\xFF\xFF", 16);
+
+    writeSize(3);
+    writeSize(3);
+
+    writeString("dec");
+    writeString("Nullable(Decimal(38, 4))");
+    data += std::string("\x00\x01\x00", 3);
+    data += decimal128_negative;
+    data += std::string(16, '\x00');
+    data += std::string(1, '\x01') + std::string(15, '\x00');
+
+    writeString("i128");
+    writeString("Int128");
+    data += int128_min_plus_one;
+    data += std::string(16, '\xFF');
+    data += std::string(16, '\x00');
+
+    writeString("u256");
+    writeString("UInt256");
+    data += uint128_max + std::string(16, '\x00');
+    data += std::string(32, '\xFF');
+    data += std::string(1, '\x0A') + std::string(31, '\x00');
+
+    auto & result_set = read("Native");
+    ASSERT_EQ(result_set.fetchRowSet(SQL_FETCH_NEXT, 0, 10), 3);
+
+    EXPECT_EQ(extractString(result_set, 0, 0), "-12345678901234567890.1234");
+    EXPECT_EQ(extractString(result_set, 1, 0), "NULL");
+    EXPECT_EQ(extractString(result_set, 2, 0), ".0001");
+
+    EXPECT_EQ(extractString(result_set, 0, 1), "-170141183460469231731687303715884105727");
+    EXPECT_EQ(extractString(result_set, 1, 1), "-1");
+    EXPECT_EQ(extractString(result_set, 2, 1), "0");
+
+    EXPECT_EQ(extractString(result_set, 0, 2), "340282366920938463463374607431768211455");
+    EXPECT_EQ(extractString(result_set, 1, 2), "115792089237316195423570985008687907853269984665640564039457584007913129639935");
+    EXPECT_EQ(extractString(result_set, 2, 2), "10");
+
+    SQL_NUMERIC_STRUCT numeric = {};
+    SQLLEN indicator = 0;
+
+    BindingInfo binding_info;
+    binding_info.c_type = SQL_C_NUMERIC;
+    binding_info.value = &numeric;
+    binding_info.value_max_size = sizeof(numeric);
+    binding_info.value_size = &indicator;
+    binding_info.indicator = &indicator;
+
+    ASSERT_TRUE(SQL_SUCCEEDED(result_set.extractField(0, 0, binding_info)));
+    EXPECT_EQ(numeric.sign, 0);
+    EXPECT_EQ(numeric.scale, 4);
+    EXPECT_EQ(std::string(reinterpret_cast<const char *>(numeric.val), sizeof(numeric.val)), std::string("\xF2\xAF\x96\x6C\xA0\x10\x1F\x9B\x24\x1A\x00\x00\x00\x00\x00\x00", 16));
+
+    EXPECT_THROW(result_set.extractField(1, 2, binding_info), std::runtime_error);
+}
+
+TEST_F(ResultSetReaderTest, RowBinaryWideDecimals) {
+    writeSize(2);
+    writeString("dec");
+    writeString("num");
+    writeString("Decimal(76, 30)");
+    writeString("Nullable(Int256)");
+
+    // -10^45 + 1 followed by 10^45, as Decimal(76, 30).
+    const std::string minus_ten_pow_45_plus_one("\x01\x00\x00\x00\x00\x60\xDD\xF4\x5F\x97\x08\x1D\xC3\x46\x79\x1F\x90\x28\xD3\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF", 32);
+    const std::string ten_pow_45("\x00\x00\x00\x00\x00\xA0\x22\x0B\xA0\x68\xF7\xE2\x3C\xB9\x86\xE0\x6F\xD7\x2C\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00", 32);
+
+    data += minus_ten_pow_45_plus_one;
+    writePOD<std::uint8_t>(0);
+    data += std::string(1, '\x85') + std::string(31, '\xFF');
+
+    data += ten_pow_45;
+    writePOD<std::uint8_t>(1);
+
+    auto & result_set = read("RowBinaryWithNamesAndTypes");
+    ASSERT_EQ(result_set.fetchRowSet(SQL_FETCH_NEXT, 0, 10), 2);
+
+    EXPECT_EQ(extractString(result_set, 0, 0), "-999999999999999.999999999999999999999999999999");
+    EXPECT_EQ(extractString(result_set, 0, 1), "-123");
+    EXPECT_EQ(extractString(result_set, 1, 0), "1000000000000000.000000000000000000000000000000");
+    EXPECT_EQ(extractString(result_set, 1, 1), "NULL");
+}
+
+TEST_F(ResultSetReaderTest, NativeLowCardinality) {
+    constexpr std::size_t num_blocks = 3;
+    constexpr std::size_t num_rows = 70;
+    constexpr std::size_t num_keys = 5;
+
+    const auto write_header = [&] (std::size_t rows) {
+        writeSize(2);
+        writeSize(rows);
+    };
+
+    for (std::size_t block = 0; block <= num_blocks; ++block) {
+        // The last block is empty, no data at all is sent for its columns.
+        const auto rows = (block < num_blocks ? num_rows : 0);
+        write_header(rows);
+
+        writeString("str");
+        writeString("LowCardinality(Nullable(String))");
+        if (rows > 0) {
+            writePOD<std::uint64_t>(1);              // Serialization version.
+            writePOD<std::uint64_t>(0 | (1ull << 9)); // UInt8 indexes, additional keys only.
+            writePOD<std::uint64_t>(num_keys + 1);
+            writeString("");                         // Represents Null.
+            for (std::size_t key = 0; key < num_keys; ++key) {
+                writeString("key" + std::to_string(block * 10 + key));
+            }
+            writePOD<std::uint64_t>(rows);
+            for (std::size_t i = 0; i < rows; ++i) {
+                writePOD<std::uint8_t>(i % (num_keys + 1));
+            }
+        }
+
+        writeString("num");
+        writeString("LowCardinality(Int32)");
+        if (rows > 0) {
+            writePOD<std::uint64_t>(1);
+            writePOD<std::uint64_t>(1 | (1ull << 9)); // UInt16 indexes.
+            writePOD<std::uint64_t>(2);
+            writePOD<std::int32_t>(-1);
+            writePOD<std::int32_t>(block);
+            writePOD<std::uint64_t>(rows);
+            for (std::size_t i = 0; i < rows; ++i) {
+                writePOD<std::uint16_t>(i % 2);
+            }
+        }
+    }
+
+    auto & result_set = read("Native");
+    ASSERT_EQ(result_set.getColumnCount(), 2);
+    EXPECT_TRUE(result_set.getColumnInfo(0).is_nullable);
+    EXPECT_EQ(result_set.getColumnInfo(0).type_without_parameters_id, DataSourceTypeId::String);
+    EXPECT_EQ(result_set.getColumnInfo(1).type_without_parameters_id, DataSourceTypeId::Int32);
+
+    std::size_t row_count = 0;
+    while (const auto row_set_size = result_set.fetchRowSet(SQL_FETCH_NEXT, 0, 33)) {
+        for (std::size_t row_idx = 0; row_idx < row_set_size; ++row_idx, ++row_count) {
+            const auto block = row_count / num_rows;
+            const auto key = row_count % num_rows % (num_keys + 1);
+            const std::string expected = (key == 0 ? "NULL" : "key" + std::to_string(block * 10 + key - 1));
+
+            EXPECT_EQ(extractString(result_set, row_idx, 0), expected);
+            EXPECT_EQ(extractString(result_set, row_idx, 1), (row_count % num_rows % 2 == 0 ? "-1" : std::to_string(block)));
+
+            char16_t buffer[16] = {};
+            SQLLEN indicator = 0;
+
+            BindingInfo binding_info;
+            binding_info.c_type = SQL_C_WCHAR;
+            binding_info.value = buffer;
+            binding_info.value_max_size = sizeof(buffer);
+            binding_info.value_size = &indicator;
+            binding_info.indicator = &indicator;
+
+            ASSERT_TRUE(SQL_SUCCEEDED(result_set.extractField(row_idx, 0, binding_info)));
+
+            if (key == 0)
+                EXPECT_EQ(indicator, SQL_NULL_DATA);
+            else
+                EXPECT_EQ(std::u16string(buffer), std::u16string(expected.begin(), expected.end()));
+        }
+    }
+
+    EXPECT_EQ(row_count, num_blocks * num_rows);
+}
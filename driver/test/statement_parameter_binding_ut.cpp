@@ -287,3 +287,134 @@ TEST_F(StatementBindingTest, FunctionLocate) {
     ASSERT_EQ(params["param_odbc_positional_2"], "haystack");
     ASSERT_EQ(params["param_odbc_positional_3"], "5");
 }
+
+TEST_F(StatementBindingTest, DataAtExecutionBinding) {
+    prepare("select ?, ?");
+
+    int param_1 = 5;
+    bind(1, SQL_PARAM_INPUT, SQL_C_LONG, SQL_INTEGER, 0, 0, &param_1, 0, NULL);
+
+    SQLLEN param_2_ind = SQL_LEN_DATA_AT_EXEC(0);
+    bind(2, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_LONGVARCHAR, 0, 0, reinterpret_cast<SQLPOINTER>(2), 0, &param_2_ind);
+
+    // The value of the data-at-execution parameter is not known yet, and will be sent separately.
+    auto [query, params] = execute();
+    ASSERT_EQ(query, "select {odbc_positional_1:Nullable(Int32)}, {odbc_positional_2:String}");
+    ASSERT_EQ(params.size(), 1);
+    ASSERT_EQ(params["param_odbc_positional_1"], "5");
+}
+
+TEST_F(StatementBindingTest, InsertParamSetsInOneRequest) {
+    prepare("INSERT INTO t (a, b) VALUES (?, @b);");
+
+    SQLINTEGER param_1[] = {1, 2, 3};
+    bind(1, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER, 0, 0, param_1, 0, NULL);
+
+    char param_2[][8] = {"x", "t\t\\N\r", ""};
+    SQLLEN param_2_ind[] = {SQL_NTS, SQL_NTS, SQL_NULL_DATA};
+    bind(2, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_VARCHAR, 0, 0, param_2, sizeof(param_2[0]), param_2_ind);
+
+    SQLUSMALLINT param_status[3] = {};
+    statement.getEffectiveDescriptor(SQL_ATTR_APP_PARAM_DESC).setAttr(SQL_DESC_ARRAY_SIZE, 3);
+    statement.getEffectiveDescriptor(SQL_ATTR_IMP_PARAM_DESC).setAttr(SQL_DESC_ARRAY_STATUS_PTR, static_cast<SQLUSMALLINT *>(param_status));
+
+    auto [query, params] = execute();
+    ASSERT_EQ(query,
+        "INSERT INTO t (a, b) SELECT * FROM input('c1 Nullable(Int32), c2 LowCardinality(Nullable(String))') FORMAT TabSeparated\n"
+        "1\tx\n"
+        "2\tt\\t\\\\N\\r\n"
+        "3\t\\N\n");
+    ASSERT_TRUE(params.empty());
+    ASSERT_EQ(param_status[0], SQL_PARAM_SUCCESS);
+    ASSERT_EQ(param_status[2], SQL_PARAM_SUCCESS);
+
+    // Parameters that are not bare values of the inserted row keep the query executed once per parameter set.
+    prepare("INSERT INTO t (a, b) VALUES (? + 1, ?)");
+
+    auto [single_query, single_params] = execute();
+    ASSERT_EQ(single_query,
+        "INSERT INTO t (a, b) VALUES ({odbc_positional_1:Nullable(Int32)} + 1, {odbc_positional_2:LowCardinality(String)})");
+    ASSERT_EQ(single_params.size(), 2);
+    ASSERT_EQ(single_params["param_odbc_positional_1"], "1");
+}
+
+TEST_F(StatementBindingTest, FailedParamSetsInOneRequest) {
+    prepare("INSERT INTO t (a) VALUES (?)");
+
+    // Data-at-execution values are not supported in the sets after the first one, so the rest of the sets is not even looked at.
+    char param_1[][8] = {"1", "2", "3"};
+    SQLLEN param_1_ind[] = {SQL_NTS, SQL_DATA_AT_EXEC, SQL_NTS};
+    bind(1, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_VARCHAR, 0, 0, param_1, sizeof(param_1[0]), param_1_ind);
+
+    // The statuses are left from a previous execution, where other sets were ignored.
+    SQLUSMALLINT param_operation[3] = {SQL_PARAM_PROCEED, SQL_PARAM_PROCEED, SQL_PARAM_IGNORE};
+    SQLUSMALLINT param_status[3] = {SQL_PARAM_SUCCESS, SQL_PARAM_UNUSED, SQL_PARAM_SUCCESS};
+    statement.getEffectiveDescriptor(SQL_ATTR_APP_PARAM_DESC).setAttr(SQL_DESC_ARRAY_SIZE, 3);
+    statement.getEffectiveDescriptor(SQL_ATTR_APP_PARAM_DESC).setAttr(SQL_DESC_ARRAY_STATUS_PTR, static_cast<SQLUSMALLINT *>(param_operation));
+    statement.getEffectiveDescriptor(SQL_ATTR_IMP_PARAM_DESC).setAttr(SQL_DESC_ARRAY_STATUS_PTR, static_cast<SQLUSMALLINT *>(param_status));
+
+    const auto rc = CALL_WITH_TYPED_HANDLE(SQL_HANDLE_STMT, statement.getHandle(), [] (Statement & statement) {
+        statement.executeQuery();
+    });
+
+    ASSERT_EQ(rc, SQL_ERROR);
+    EXPECT_EQ(statement.getDiagStatus(1).getAttrAs<std::string>(SQL_DIAG_SQLSTATE), "HYC00");
+    EXPECT_EQ(param_status[0], SQL_PARAM_ERROR);
+    EXPECT_EQ(param_status[1], SQL_PARAM_ERROR);
+    EXPECT_EQ(param_status[2], SQL_PARAM_UNUSED);
+}
+
+TEST_F(StatementBindingTest, CancelBeforeQueryIsSent) {
+    const auto get_sql_state = [&] () {
+        return statement.getDiagStatus(1).getAttrAs<std::string>(SQL_DIAG_SQLSTATE);
+    };
+
+    EXPECT_FALSE(statement.isInCall());
+
+    // As if SQLCancel() were called by another thread, while the call is preparing the query.
+    auto rc = CALL_WITH_TYPED_HANDLE(SQL_HANDLE_STMT, statement.getHandle(), [] (Statement & statement) {
+        EXPECT_TRUE(statement.isInCall());
+        statement.requestCancel();
+        statement.executeQuery("select 1");
+    });
+
+    ASSERT_EQ(rc, SQL_ERROR);
+    EXPECT_EQ(get_sql_state(), "HY008");
+    EXPECT_FALSE(statement.isInCall());
+
+    // The cancellation applies only to the call that was in progress, while the next one fails only because there is no connection.
+    rc = CALL_WITH_TYPED_HANDLE(SQL_HANDLE_STMT, statement.getHandle(), [] (Statement & statement) {
+        statement.executeQuery("select 1");
+    });
+
+    ASSERT_EQ(rc, SQL_ERROR);
+    EXPECT_EQ(get_sql_state(), "08003");
+}
+
+TEST(StatementBulkAddTest, ExtractSelectedTable) {
+    EXPECT_EQ(Statement::extractSelectedTable("SELECT a, b FROM t"), "t");
+    EXPECT_EQ(Statement::extractSelectedTable("  select a FROM db.t;"), "db.t");
+    EXPECT_EQ(Statement::extractSelectedTable("SELECT a FROM `my db`.\"my t\" WHERE a > 1 ORDER BY a LIMIT 10"), "`my db`.\"my t\"");
+    EXPECT_EQ(Statement::extractSelectedTable("SELECT a FROM t WHERE a IN (SELECT a FROM u GROUP BY a UNION ALL SELECT 1)"), "t");
+    EXPECT_EQ(Statement::extractSelectedTable("SELECT a FROM t WHERE s = 'GROUP BY' AND `JOIN` = 1"), "t");
+    EXPECT_EQ(Statement::extractSelectedTable("SELECT (SELECT 1 FROM u) AS x, a FROM t"), "t");
+
+    EXPECT_EQ(Statement::extractSelectedTable("INSERT INTO t VALUES (1)"), "");
+    EXPECT_EQ(Statement::extractSelectedTable("SELECT 1"), "");
+    EXPECT_EQ(Statement::extractSelectedTable("SELECT a FROM (SELECT a FROM t)"), "");
+    EXPECT_EQ(Statement::extractSelectedTable("SELECT a FROM numbers(10)"), "");
+    EXPECT_EQ(Statement::extractSelectedTable("SELECT a FROM t AS x"), "");
+    EXPECT_EQ(Statement::extractSelectedTable("SELECT a FROM t, u"), "");
+    EXPECT_EQ(Statement::extractSelectedTable("SELECT a FROM a.b.c"), "");
+    EXPECT_EQ(Statement::extractSelectedTable("SELECT a FROM 1t"), "");
+    EXPECT_EQ(Statement::extractSelectedTable("SELECT a FROM t GROUP BY a"), "");
+    EXPECT_EQ(Statement::extractSelectedTable("SELECT a FROM t WHERE x GROUP BY a"), "");
+    EXPECT_EQ(Statement::extractSelectedTable("SELECT a FROM t WHERE x GROUP BY a HAVING count() > 1"), "");
+    EXPECT_EQ(Statement::extractSelectedTable("SELECT a FROM t LIMIT 1 UNION ALL SELECT a FROM u"), "");
+    EXPECT_EQ(Statement::extractSelectedTable("SELECT a FROM t WHERE x EXCEPT SELECT a FROM u"), "");
+    EXPECT_EQ(Statement::extractSelectedTable("SELECT a FROM t FINAL JOIN u USING (a)"), "");
+    EXPECT_EQ(Statement::extractSelectedTable("SELECT a FROM t ARRAY JOIN arr"), "");
+    EXPECT_EQ(Statement::extractSelectedTable("SELECT a FROM t FINAL ARRAY JOIN arr AS a"), "");
+    EXPECT_EQ(Statement::extractSelectedTable("SELECT a FROM t ORDER BY a WITH FILL"), "");
+    EXPECT_EQ(Statement::extractSelectedTable("SELECT a FROM t WHERE (a > 1"), "");
+}
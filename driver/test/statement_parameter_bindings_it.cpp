@@ -307,3 +307,78 @@ TEST_F(StatementParameterBindingsTest, StringArray) {
         ASSERT_EQ(SQLMoreResults(hstmt), (i + 1 == lengthof(param) ? SQL_NO_DATA : SQL_SUCCESS));
     }
 }
+
+TEST_F(StatementParameterBindingsTest, DataAtExecution) {
+    auto query = fromUTF8<PTChar>("SELECT length(?), ?, ?");
+
+    SQLLEN param_ind = SQL_DATA_AT_EXEC;
+    SQLLEN wparam_ind = SQL_LEN_DATA_AT_EXEC(0);
+    SQLINTEGER param_int = 0;
+    SQLLEN param_int_ind = SQL_DATA_AT_EXEC;
+
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLPrepare(hstmt, ptcharCast(query.data()), SQL_NTS));
+    ODBC_CALL_ON_STMT_THROW(hstmt,
+        SQLBindParameter(hstmt, 1, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_LONGVARCHAR, 0, 0, reinterpret_cast<SQLPOINTER>(1), 0, &param_ind)
+    );
+    ODBC_CALL_ON_STMT_THROW(hstmt,
+        SQLBindParameter(hstmt, 2, SQL_PARAM_INPUT, SQL_C_WCHAR, SQL_WLONGVARCHAR, 0, 0, reinterpret_cast<SQLPOINTER>(2), 0, &wparam_ind)
+    );
+    ODBC_CALL_ON_STMT_THROW(hstmt,
+        SQLBindParameter(hstmt, 3, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER, 0, 0, reinterpret_cast<SQLPOINTER>(3), 0, &param_int_ind)
+    );
+
+    ASSERT_EQ(SQLExecute(hstmt), SQL_NEED_DATA);
+
+    const std::string piece(1000, 'x');
+    const std::u16string wvalue = u"привет \U0001F600";
+    const SQLINTEGER int_value = 42;
+
+    SQLPOINTER token = nullptr;
+    SQLRETURN rc = SQL_ERROR;
+    while ((rc = SQLParamData(hstmt, &token)) == SQL_NEED_DATA) {
+        switch (reinterpret_cast<std::uintptr_t>(token)) {
+            case 1: {
+                for (std::size_t i = 0; i < 100; ++i) {
+                    ODBC_CALL_ON_STMT_THROW(hstmt, SQLPutData(hstmt, const_cast<char *>(piece.data()), piece.size()));
+                }
+                break;
+            }
+
+            case 2: {
+                // Pieces that split a surrogate pair.
+                for (std::size_t i = 0; i < wvalue.size(); ++i) {
+                    ODBC_CALL_ON_STMT_THROW(hstmt, SQLPutData(hstmt, const_cast<char16_t *>(wvalue.data() + i), sizeof(char16_t)));
+                }
+                break;
+            }
+
+            case 3: {
+                ODBC_CALL_ON_STMT_THROW(hstmt, SQLPutData(hstmt, const_cast<SQLINTEGER *>(&int_value), 0));
+                break;
+            }
+
+            default:
+                FAIL() << "Unexpected data-at-execution token";
+        }
+    }
+
+    ODBC_CALL_ON_STMT_THROW(hstmt, rc);
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLFetch(hstmt));
+
+    SQLBIGINT length = 0;
+    SQLLEN length_ind = 0;
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLGetData(hstmt, 1, getCTypeFor<decltype(length)>(), &length, sizeof(length), &length_ind));
+    ASSERT_EQ(length, piece.size() * 100);
+
+    char16_t wcol[32] = {};
+    SQLLEN wcol_ind = 0;
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLGetData(hstmt, 2, SQL_C_WCHAR, wcol, sizeof(wcol), &wcol_ind));
+    ASSERT_EQ(std::u16string(wcol), wvalue);
+
+    SQLINTEGER int_col = 0;
+    SQLLEN int_col_ind = 0;
+    ODBC_CALL_ON_STMT_THROW(hstmt, SQLGetData(hstmt, 3, getCTypeFor<decltype(int_col)>(), &int_col, sizeof(int_col), &int_col_ind));
+    ASSERT_EQ(int_col, int_value);
+
+    ASSERT_EQ(SQLFetch(hstmt), SQL_NO_DATA);
+}
@@ -85,7 +85,12 @@ INSTANTIATE_TEST_SUITE_P(TypeConversion, StringPongNumericSymmetric,
         "18446744073709551615",
         "-18446744073709551615",
         ".18446744073709551615",
-        "-.18446744073709551615"
+        "-.18446744073709551615",
+        "12345678901234567890123456789012345678",
+        "-1234567890123456789012345678.9012345678",
+        ".00000000000000000000000000000000000001",
+        "340282366920938463463374607431768211455",
+        "-340282366920938463463374607431768211455"
     )
 );
 
@@ -100,3 +105,83 @@ INSTANTIATE_TEST_SUITE_P(TypeConversion, StringPongNumericAsymmetric,
         { "000000.123", ".123" }
     })
 );
+
+TEST(TimeZoneConversion, Dates) {
+    const auto check = [] (std::int64_t days, int year, int month, int day) {
+        const auto date = TimeZone::toCivilDate(days);
+        EXPECT_EQ(date.year, year) << days;
+        EXPECT_EQ(date.month, month) << days;
+        EXPECT_EQ(date.day, day) << days;
+    };
+
+    check(0, 1970, 1, 1);
+    check(-1, 1969, 12, 31);
+    check(-25567, 1900, 1, 1);
+    check(11016, 2000, 2, 29);
+    check(18346, 2020, 3, 25);
+    check(65535, 2149, 6, 6);
+    check(120530, 2300, 1, 1);  // Beyond the tabulated range.
+    check(-719162, 1, 1, 1);
+
+    DataSourceType<DataSourceTypeId::Date> date;
+    WireTypeDateAsInt src;
+    src.value = 18346;
+    value_manip::from_value<WireTypeDateAsInt>::to_value<DataSourceType<DataSourceTypeId::Date>>::convert(src, date);
+    EXPECT_EQ(date.value.year, 2020);
+    EXPECT_EQ(date.value.month, 3);
+    EXPECT_EQ(date.value.day, 25);
+}
+
+TEST(TimeZoneConversion, OffsetChanges) {
+    // +01:00, then +02:00 starting from 2020-03-29 01:00:00 UTC, then +05:45 starting from 2020-03-29 01:30:00 UTC.
+    const TimeZone time_zone("Test", {
+        {std::numeric_limits<std::int64_t>::min(), 60 * 60},
+        {1585443600, 2 * 60 * 60},
+        {1585445400, 5 * 60 * 60 + 45 * 60}
+    });
+
+    const auto check = [&] (std::int64_t time, int year, int month, int day, int hour, int minute, int second) {
+        const auto civil_time = time_zone.toCivilTime(time);
+        EXPECT_EQ(civil_time.date.year, year) << time;
+        EXPECT_EQ(civil_time.date.month, month) << time;
+        EXPECT_EQ(civil_time.date.day, day) << time;
+        EXPECT_EQ(civil_time.hour, hour) << time;
+        EXPECT_EQ(civil_time.minute, minute) << time;
+        EXPECT_EQ(civil_time.second, second) << time;
+    };
+
+    check(0, 1970, 1, 1, 1, 0, 0);
+    check(-1, 1970, 1, 1, 0, 59, 59);
+    check(-2208996000, 1899, 12, 31, 23, 0, 0); // Before the tabulated range.
+    check(1585443599, 2020, 3, 29, 1, 59, 59);
+    check(1585443600, 2020, 3, 29, 3, 0, 0);
+    check(1585445399, 2020, 3, 29, 3, 29, 59);
+    check(1585445400, 2020, 3, 29, 7, 15, 0);
+    check(10413792000, 2300, 1, 1, 5, 45, 0);  // After the tabulated range.
+
+    WireTypeDateTime64AsInt src(3, time_zone);
+    src.value = -1500; // 1970-01-01 00:59:58.5 in +01:00
+
+    DataSourceType<DataSourceTypeId::DateTime64> timestamp;
+    value_manip::from_value<WireTypeDateTime64AsInt>::to_value<DataSourceType<DataSourceTypeId::DateTime64>>::convert(src, timestamp);
+    EXPECT_EQ(timestamp.value.year, 1970);
+    EXPECT_EQ(timestamp.value.hour, 0);
+    EXPECT_EQ(timestamp.value.minute, 59);
+    EXPECT_EQ(timestamp.value.second, 58);
+    EXPECT_EQ(timestamp.value.fraction, 500000000);
+}
+
+TEST(TimeZoneConversion, UTC) {
+    const auto & time_zone = TimeZone::get("UTC");
+    EXPECT_EQ(&time_zone, &TimeZone::get("UTC"));
+    EXPECT_EQ(time_zone.getOffset(0), 0);
+    EXPECT_EQ(time_zone.getOffset(1585443600), 0);
+
+    const auto civil_time = time_zone.toCivilTime(1585138282);
+    EXPECT_EQ(civil_time.date.year, 2020);
+    EXPECT_EQ(civil_time.date.month, 3);
+    EXPECT_EQ(civil_time.date.day, 25);
+    EXPECT_EQ(civil_time.hour, 12);
+    EXPECT_EQ(civil_time.minute, 11);
+    EXPECT_EQ(civil_time.second, 22);
+}
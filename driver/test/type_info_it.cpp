@@ -37,10 +37,10 @@ TEST_F(TypeInfoTest, ClickhouseToSQLTypeMapping)
         {"UInt32", "0", SQL_BIGINT},
         {"Int64", "0", SQL_BIGINT},
         {"UInt64", "0", SQL_BIGINT},
-        {"Int128", "0", SQL_VARCHAR},
-        {"UInt128", "0", SQL_VARCHAR},
-        {"Int256", "0", SQL_VARCHAR},
-        {"UInt256", "0", SQL_VARCHAR},
+        {"Int128", "0", SQL_DECIMAL},
+        {"UInt128", "0", SQL_DECIMAL},
+        {"Int256", "0", SQL_DECIMAL},
+        {"UInt256", "0", SQL_DECIMAL},
         {"Float32", "0", SQL_REAL},
         {"Float64", "0", SQL_DOUBLE},
         {"Decimal(5)", "0", SQL_DECIMAL},
@@ -231,6 +231,10 @@ TEST_F(TypeInfoTest, SQLGetTypeInfoResultSet)
         {{"DateTime",   SQL_TYPE_TIMESTAMP}, {19,       na,  na,   na,     na,    na, na,  SQL_DATE,      3,   na,  }},
         {{"UUID",       SQL_GUID          }, {35,       na,  na,   na,     na,    na, na,  SQL_GUID,      na,  na,  }},
         {{"Array",      SQL_VARCHAR       }, {max_size, na,  na,   na,     na,    na, na,  SQL_VARCHAR,   na,  na,  }},
+        {{"Int128",     SQL_DECIMAL       }, {40,       na,  na,   na,     false, na, na,  SQL_DECIMAL,   na,  10,  }},
+        {{"UInt128",    SQL_DECIMAL       }, {39,       na,  na,   na,     true,  na, na,  SQL_DECIMAL,   na,  10,  }},
+        {{"Int256",     SQL_DECIMAL       }, {78,       na,  na,   na,     false, na, na,  SQL_DECIMAL,   na,  10,  }},
+        {{"UInt256",    SQL_DECIMAL       }, {78,       na,  na,   na,     true,  na, na,  SQL_DECIMAL,   na,  10,  }},
     };
     // clang-format on
 
@@ -376,6 +380,10 @@ TEST_F(TypeInfoTest, AllTypesColumns)
     {"UInt32",         {SQL_BIGINT,        "UInt32",      10,  0,   na,   10,    false, SQL_BIGINT,   na,  4   }},
     {"Int64",          {SQL_BIGINT,        "Int64",       20,  0,   na,   10,    false, SQL_BIGINT,   na,  8   }},
     {"UInt64",         {SQL_BIGINT,        "UInt64",      20,  0,   na,   10,    false, SQL_BIGINT,   na,  8   }},
+    {"Int128",         {SQL_DECIMAL,       "Int128",      40,  0,   na,   10,    false, SQL_DECIMAL,  na,  16  }},
+    {"UInt128",        {SQL_DECIMAL,       "UInt128",     39,  0,   na,   10,    false, SQL_DECIMAL,  na,  16  }},
+    {"Int256",         {SQL_DECIMAL,       "Int256",      78,  0,   na,   10,    false, SQL_DECIMAL,  na,  32  }},
+    {"UInt256",        {SQL_DECIMAL,       "UInt256",     78,  0,   na,   10,    false, SQL_DECIMAL,  na,  32  }},
     {"Float32",        {SQL_REAL,          "Float32",     7,   0,   na,   2,     false, SQL_REAL,     na,  4   }},
     {"Float64",        {SQL_DOUBLE,        "Float64",     15,  0,   na,   2,     false, SQL_DOUBLE,   na,  8   }},
     {"Decimal",        {SQL_DECIMAL,       "Decimal",     10,  0,   0,    10,    false, SQL_DECIMAL,  na,  32  }},
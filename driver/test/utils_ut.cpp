@@ -1,8 +1,21 @@
 #include "driver/utils/sql_encoding.h"
 #include "driver/utils/utils.h"
+#include "driver/utils/compression.h"
+#include "driver/utils/lru_cache.h"
+#include "driver/utils/sharded_map.h"
+#include "driver/utils/session_pool.h"
+#include "driver/utils/socket_watcher.h"
 
 #include <gtest/gtest.h>
 
+#include <Poco/Net/ServerSocket.h>
+#include <Poco/Net/StreamSocket.h>
+
+#include <atomic>
+#include <sstream>
+#include <thread>
+#include <vector>
+
 using values_t = std::set<std::string>;
 
 class ParseToSet
@@ -101,3 +114,297 @@ TEST(Escaping, ToSqlQuery)
     ASSERT_EQ(toSqlQueryValue(std::optional<int64_t>{}), "NULL");
     ASSERT_EQ(toSqlQueryValue(std::optional<uint64_t>{}), "NULL");
 }
+
+TEST(LRUCache, EvictsLeastRecentlyUsed)
+{
+    LRUCache<std::string, int> cache(2);
+
+    cache.put("a", 1);
+    cache.put("b", 2);
+    ASSERT_EQ(cache.get("a"), 1); // "b" is the least recently used now.
+
+    cache.put("c", 3);
+    ASSERT_EQ(cache.size(), 2);
+    ASSERT_EQ(cache.get("a"), 1);
+    ASSERT_EQ(cache.get("b"), std::nullopt);
+    ASSERT_EQ(cache.get("c"), 3);
+
+    cache.put("a", 4); // Replaces the value, and makes "c" the least recently used.
+    cache.put("d", 5);
+    ASSERT_EQ(cache.size(), 2);
+    ASSERT_EQ(cache.get("a"), 4);
+    ASSERT_EQ(cache.get("c"), std::nullopt);
+    ASSERT_EQ(cache.get("d"), 5);
+
+    cache.clear();
+    ASSERT_EQ(cache.size(), 0);
+    ASSERT_EQ(cache.get("a"), std::nullopt);
+}
+
+TEST(LRUCache, EvictsOverWeightBudget)
+{
+    LRUCache<std::string, int> cache(10, 100);
+
+    cache.put("a", 1, 40);
+    cache.put("b", 2, 40);
+    ASSERT_EQ(cache.weight(), 80);
+
+    cache.put("c", 3, 40); // Doesn't fit with "a", the least recently used one.
+    ASSERT_EQ(cache.size(), 2);
+    ASSERT_EQ(cache.weight(), 80);
+    ASSERT_EQ(cache.get("a"), std::nullopt);
+    ASSERT_EQ(cache.get("b"), 2);
+
+    cache.put("b", 4, 10); // Replaces the value and the weight.
+    ASSERT_EQ(cache.weight(), 50);
+    ASSERT_EQ(cache.get("b"), 4);
+
+    cache.put("d", 5, 101); // Heavier than the whole budget, so it is not stored, and nothing is evicted for it.
+    ASSERT_EQ(cache.get("d"), std::nullopt);
+    ASSERT_EQ(cache.size(), 2);
+
+    cache.put("e", 6, 100); // Takes the whole budget.
+    ASSERT_EQ(cache.size(), 1);
+    ASSERT_EQ(cache.weight(), 100);
+    ASSERT_EQ(cache.get("e"), 6);
+}
+
+TEST(ShardedMap, SetFindErase)
+{
+    ShardedMap<int, std::string, 4> map;
+
+    ASSERT_EQ(map.find(1), std::nullopt);
+
+    map.set(1, "a");
+    map.set(2, "b");
+    ASSERT_EQ(map.find(1), "a");
+    ASSERT_EQ(map.find(2), "b");
+
+    map.set(1, "c");
+    ASSERT_EQ(map.find(1), "c");
+
+    map.erase(1);
+    ASSERT_EQ(map.find(1), std::nullopt);
+    ASSERT_EQ(map.find(2), "b");
+
+    map.clear();
+    ASSERT_EQ(map.find(2), std::nullopt);
+}
+
+TEST(ShardedMap, ConcurrentAccess)
+{
+    constexpr int thread_count = 8;
+    constexpr int key_count = 10000;
+
+    ShardedMap<int, int> map;
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < thread_count; ++t) {
+        threads.emplace_back([&map, t] {
+            for (int i = t; i < key_count; i += thread_count) {
+                map.set(i, i * 2);
+                ASSERT_EQ(map.find(i), i * 2);
+                if (i % 2)
+                    map.erase(i);
+            }
+        });
+    }
+
+    for (auto & thread : threads) {
+        thread.join();
+    }
+
+    for (int i = 0; i < key_count; ++i) {
+        ASSERT_EQ(map.find(i), (i % 2 ? std::nullopt : std::optional<int>{i * 2}));
+    }
+}
+
+class SessionPoolTest
+    : public ::testing::Test
+{
+protected:
+    // A session with an established TCP connection to the local server socket.
+    std::unique_ptr<Poco::Net::HTTPClientSession> makeConnectedSession() {
+        Poco::Net::StreamSocket socket;
+        socket.connect(server.address());
+        return std::make_unique<Poco::Net::HTTPClientSession>(socket);
+    }
+
+    Poco::Net::ServerSocket server{Poco::Net::SocketAddress("127.0.0.1", 0)};
+    const std::string key = SessionPool::makeKey("http", "127.0.0.1", 8123, "", "", "", "");
+    const std::string other_key = SessionPool::makeKey("https", "127.0.0.1", 8123, "", "", "", "");
+    const SessionPool::Clock::time_point now = SessionPool::Clock::now();
+};
+
+TEST_F(SessionPoolTest, ReusesSessionOfSameEndpoint)
+{
+    SessionPool pool(4, std::chrono::seconds(10));
+
+    auto session = makeConnectedSession();
+    const auto * session_ptr = session.get();
+
+    pool.put(key, std::move(session), now);
+    ASSERT_EQ(pool.getIdleCount(key), 1);
+    ASSERT_EQ(pool.take(other_key, now), nullptr);
+
+    auto reused_session = pool.take(key, now + std::chrono::seconds(1));
+    ASSERT_EQ(reused_session.get(), session_ptr);
+    ASSERT_EQ(pool.getIdleCount(key), 0);
+    ASSERT_EQ(pool.take(key, now), nullptr);
+}
+
+TEST_F(SessionPoolTest, DropsDisconnectedSessions)
+{
+    SessionPool pool(4, std::chrono::seconds(10));
+
+    pool.put(key, std::make_unique<Poco::Net::HTTPClientSession>("127.0.0.1", 8123), now);
+    ASSERT_EQ(pool.getIdleCount(key), 0);
+}
+
+TEST_F(SessionPoolTest, LimitsIdleSessionsPerEndpoint)
+{
+    SessionPool pool(2, std::chrono::seconds(10));
+
+    for (int i = 0; i < 3; ++i) {
+        pool.put(key, makeConnectedSession(), now);
+    }
+
+    pool.put(other_key, makeConnectedSession(), now);
+
+    ASSERT_EQ(pool.getIdleCount(key), 2);
+    ASSERT_EQ(pool.getIdleCount(other_key), 1);
+}
+
+TEST_F(SessionPoolTest, ReapsExpiredSessions)
+{
+    SessionPool pool(4, std::chrono::seconds(10));
+
+    pool.put(key, makeConnectedSession(), now);
+    pool.put(key, makeConnectedSession(), now + std::chrono::seconds(5));
+
+    ASSERT_NE(pool.take(key, now + std::chrono::seconds(12)), nullptr);
+    ASSERT_EQ(pool.take(key, now + std::chrono::seconds(12)), nullptr);
+}
+
+class SocketWatcherTest
+    : public ::testing::Test
+{
+protected:
+    void SetUp() override {
+        client.connect(server.address());
+        peer = server.acceptConnection();
+    }
+
+    Poco::Net::ServerSocket server{Poco::Net::SocketAddress("127.0.0.1", 0)};
+    Poco::Net::StreamSocket client;
+    Poco::Net::StreamSocket peer;
+};
+
+TEST_F(SocketWatcherTest, CallsBackWhenReadable)
+{
+    SocketWatcher watcher(std::chrono::milliseconds(1));
+    std::atomic<int> call_count = 0;
+
+    watcher.watch(client, [&] { ++call_count; });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    ASSERT_EQ(call_count, 0);
+
+    peer.sendBytes("x", 1);
+
+    for (int i = 0; i < 10000 && call_count == 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    ASSERT_EQ(call_count, 1);
+    ASSERT_EQ(watcher.getWatchedCount(), 0);
+}
+
+TEST_F(SocketWatcherTest, DoesNotCallBackAfterUnwatch)
+{
+    SocketWatcher watcher(std::chrono::milliseconds(1));
+    std::atomic<int> call_count = 0;
+
+    const auto id = watcher.watch(client, [&] { ++call_count; });
+    watcher.unwatch(id);
+    ASSERT_EQ(watcher.getWatchedCount(), 0);
+
+    peer.sendBytes("x", 1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    ASSERT_EQ(call_count, 0);
+}
+
+TEST_F(SocketWatcherTest, ForgetsClosedSockets)
+{
+    SocketWatcher watcher(std::chrono::milliseconds(1));
+    std::atomic<int> call_count = 0;
+
+    watcher.watch(client, [&] { ++call_count; });
+    client.close();
+
+    for (int i = 0; i < 1000 && watcher.getWatchedCount() > 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    ASSERT_EQ(watcher.getWatchedCount(), 0);
+    ASSERT_EQ(call_count, 0);
+}
+
+TEST_F(SocketWatcherTest, CallbackMayUseWatcher)
+{
+    SocketWatcher watcher(std::chrono::milliseconds(1));
+    std::atomic<int> call_count = 0;
+    std::atomic<std::uint64_t> id = 0;
+
+    id = watcher.watch(client, [&] {
+        watcher.unwatch(id);
+        watcher.getWatchedCount();
+        ++call_count;
+    });
+
+    peer.sendBytes("x", 1);
+
+    for (int i = 0; i < 10000 && call_count == 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    ASSERT_EQ(call_count, 1);
+    ASSERT_EQ(watcher.getWatchedCount(), 0);
+}
+
+class CompressingOutputStreamTest
+    : public ::testing::TestWithParam<std::string>
+{
+};
+
+TEST_P(CompressingOutputStreamTest, RoundTrip)
+{
+    const auto & content_encoding = GetParam();
+
+    std::string data;
+    for (std::size_t i = 0; data.size() < 300 * 1024; ++i) {
+        data += std::to_string(i * 7919);
+        data += '\t';
+    }
+
+    std::stringstream compressed;
+    CompressingOutputStream stream(content_encoding, compressed);
+
+    // Written in pieces, that don't match the internal buffer sizes.
+    for (std::size_t offset = 0; offset < data.size(); offset += 1000) {
+        stream.write(data.data() + offset, std::min<std::size_t>(1000, data.size() - offset));
+    }
+
+    stream.close();
+    ASSERT_LT(compressed.str().size(), data.size());
+
+    const auto decompressing_stream = make_decompressing_stream(content_encoding, compressed);
+    ASSERT_NE(decompressing_stream, nullptr);
+
+    std::stringstream decompressed;
+    decompressed << decompressing_stream->rdbuf();
+    ASSERT_EQ(decompressed.str(), data);
+}
+
+INSTANTIATE_TEST_SUITE_P(Compression, CompressingOutputStreamTest, ::testing::Values("gzip", "deflate", "lz4"));
@@ -7,17 +7,22 @@
 #include <istream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 
 #include <cstring>
 
 // A restricted wrapper around std::istream, that tries to reduce the number of std::istream::read() calls at the cost of extra std::memcpy().
 // Maintains internal buffer of pre-read characters making AmortizedIStreamReader::read() calls for small counts more efficient.
+// Reads of at least min_read_size bytes bypass the buffer, and AmortizedIStreamReader::readView() gives access to the buffered data without copying.
 // Handles incomplete reads and terminated std::istream more aggressively, by throwing exceptions.
 class AmortizedIStreamReader
 {
 public:
-    explicit AmortizedIStreamReader(std::istream & raw_stream)
+    static constexpr std::size_t default_min_read_size = 1 << 13; // 8 KB
+
+    explicit AmortizedIStreamReader(std::istream & raw_stream, std::size_t min_read_size = default_min_read_size)
         : raw_stream_(raw_stream)
+        , min_read_size_(std::max<std::size_t>(min_read_size, 1))
     {
     }
 
@@ -60,6 +65,23 @@ public:
     }
 
     AmortizedIStreamReader & read(char * str, std::size_t count) {
+        const auto avail = available();
+
+        // Large reads go directly to the destination, instead of being buffered and copied afterwards.
+        if (str && avail < count && count - avail >= min_read_size_) {
+            std::memcpy(str, &buffer_[offset_], avail);
+            offset_ += avail;
+
+            const auto to_read = count - avail;
+            raw_stream_.read(str + avail, to_read);
+
+            const auto read_count = static_cast<std::size_t>(raw_stream_.gcount());
+            if (read_count < to_read)
+                throw std::runtime_error("Incomplete input stream, expected at least " + std::to_string(to_read - read_count) + " more bytes");
+
+            return *this;
+        }
+
         tryPrepare(count);
 
         if (available() < count)
@@ -73,6 +95,19 @@ public:
         return *this;
     }
 
+    // Consume count bytes and return a view to them, that stays valid until the next call to any of the member functions.
+    std::string_view readView(std::size_t count) {
+        tryPrepare(count);
+
+        if (available() < count)
+            throw std::runtime_error("Incomplete input stream, expected at least " + std::to_string(count) + " more bytes");
+
+        const std::string_view view{buffer_.data() + offset_, count};
+        offset_ += count;
+
+        return view;
+    }
+
 private:
     std::size_t available() const {
         if (offset_ < buffer_.size())
@@ -85,9 +120,7 @@ private:
         const auto avail = available();
 
         if (avail < count) {
-            static constexpr std::size_t min_read_size = 1 << 13; // 8 KB
-
-            const auto to_read = std::max<std::size_t>(min_read_size, count - avail);
+            const auto to_read = std::max<std::size_t>(min_read_size_, count - avail);
             const auto tail_capacity = buffer_.capacity() - buffer_.size();
             const auto free_capacity = tail_capacity + offset_;
 
@@ -123,6 +156,7 @@ private:
 
 private:
     std::istream & raw_stream_;
+    const std::size_t min_read_size_;
     std::size_t offset_ = 0;
     std::string buffer_;
 };
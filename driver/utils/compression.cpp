@@ -0,0 +1,179 @@
+#include "driver/utils/compression.h"
+#include "driver/utils/utils.h"
+
+#include <Poco/DeflatingStream.h>
+#include <Poco/InflatingStream.h>
+
+#include <lz4frame.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+LZ4InflatingStreamBuf::LZ4InflatingStreamBuf(std::istream & raw_stream)
+    : raw_stream(raw_stream)
+    , in_buffer(64 * 1024)
+    , out_buffer(64 * 1024)
+{
+    const auto res = LZ4F_createDecompressionContext(&context, LZ4F_VERSION);
+    if (LZ4F_isError(res))
+        throw std::runtime_error(std::string("Unable to create LZ4 decompression context: ") + LZ4F_getErrorName(res));
+}
+
+LZ4InflatingStreamBuf::~LZ4InflatingStreamBuf() {
+    LZ4F_freeDecompressionContext(context);
+}
+
+LZ4InflatingStreamBuf::int_type LZ4InflatingStreamBuf::underflow() {
+    if (gptr() < egptr())
+        return traits_type::to_int_type(*gptr());
+
+    while (true) {
+        if (in_offset == in_size) {
+            raw_stream.read(in_buffer.data(), in_buffer.size());
+            in_offset = 0;
+            in_size = raw_stream.gcount();
+
+            if (in_size == 0) {
+                if (!frame_complete)
+                    throw std::runtime_error("Incomplete LZ4 frame");
+
+                return traits_type::eof();
+            }
+        }
+
+        std::size_t src_size = in_size - in_offset;
+        std::size_t dst_size = out_buffer.size();
+
+        const auto res = LZ4F_decompress(context, out_buffer.data(), &dst_size, in_buffer.data() + in_offset, &src_size, nullptr);
+        if (LZ4F_isError(res))
+            throw std::runtime_error(std::string("Unable to decompress LZ4 frame: ") + LZ4F_getErrorName(res));
+
+        in_offset += src_size;
+        frame_complete = (res == 0); // The context is ready to accept the next frame in this case, if any.
+
+        if (dst_size > 0) {
+            setg(out_buffer.data(), out_buffer.data(), out_buffer.data() + dst_size);
+            return traits_type::to_int_type(*gptr());
+        }
+    }
+}
+
+LZ4InflatingInputStream::LZ4InflatingInputStream(std::istream & raw_stream)
+    : std::istream(nullptr)
+    , buf(raw_stream)
+{
+    init(&buf);
+}
+
+std::unique_ptr<std::istream> make_decompressing_stream(const std::string & content_encoding, std::istream & raw_stream) {
+    if (content_encoding.empty() || Poco::UTF8::icompare(content_encoding, "identity") == 0)
+        return {};
+
+    // An empty body is not a valid compressed stream, but there is nothing to decompress there anyway.
+    if (raw_stream.peek() == std::char_traits<char>::eof())
+        return {};
+
+    if (Poco::UTF8::icompare(content_encoding, "gzip") == 0)
+        return std::make_unique<Poco::InflatingInputStream>(raw_stream, Poco::InflatingStreamBuf::STREAM_GZIP);
+
+    if (Poco::UTF8::icompare(content_encoding, "deflate") == 0)
+        return std::make_unique<Poco::InflatingInputStream>(raw_stream, Poco::InflatingStreamBuf::STREAM_ZLIB);
+
+    if (Poco::UTF8::icompare(content_encoding, "lz4") == 0)
+        return std::make_unique<LZ4InflatingInputStream>(raw_stream);
+
+    throw std::runtime_error("'" + content_encoding + "' content encoding is not supported");
+}
+
+LZ4DeflatingStreamBuf::LZ4DeflatingStreamBuf(std::ostream & raw_stream)
+    : raw_stream(raw_stream)
+    , in_buffer(64 * 1024)
+{
+    const auto res = LZ4F_createCompressionContext(&context, LZ4F_VERSION);
+    if (LZ4F_isError(res))
+        throw std::runtime_error(std::string("Unable to create LZ4 compression context: ") + LZ4F_getErrorName(res));
+
+    out_buffer.resize(std::max(LZ4F_compressBound(in_buffer.size(), nullptr), static_cast<std::size_t>(LZ4F_HEADER_SIZE_MAX)));
+    setp(in_buffer.data(), in_buffer.data() + in_buffer.size());
+}
+
+LZ4DeflatingStreamBuf::~LZ4DeflatingStreamBuf() {
+    LZ4F_freeCompressionContext(context);
+}
+
+void LZ4DeflatingStreamBuf::close() {
+    compressPending();
+
+    const auto res = LZ4F_compressEnd(context, out_buffer.data(), out_buffer.size(), nullptr);
+    if (LZ4F_isError(res))
+        throw std::runtime_error(std::string("Unable to compress LZ4 frame: ") + LZ4F_getErrorName(res));
+
+    raw_stream.write(out_buffer.data(), res);
+    raw_stream.flush();
+}
+
+LZ4DeflatingStreamBuf::int_type LZ4DeflatingStreamBuf::overflow(int_type ch) {
+    compressPending();
+
+    if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+        *pptr() = traits_type::to_char_type(ch);
+        pbump(1);
+    }
+
+    return traits_type::not_eof(ch);
+}
+
+void LZ4DeflatingStreamBuf::compressPending() {
+    auto check = [] (std::size_t res) {
+        if (LZ4F_isError(res))
+            throw std::runtime_error(std::string("Unable to compress LZ4 frame: ") + LZ4F_getErrorName(res));
+        return res;
+    };
+
+    if (!frame_started) {
+        raw_stream.write(out_buffer.data(), check(LZ4F_compressBegin(context, out_buffer.data(), out_buffer.size(), nullptr)));
+        frame_started = true;
+    }
+
+    const auto size = static_cast<std::size_t>(pptr() - pbase());
+    if (size > 0)
+        raw_stream.write(out_buffer.data(), check(LZ4F_compressUpdate(context, out_buffer.data(), out_buffer.size(), pbase(), size, nullptr)));
+
+    setp(in_buffer.data(), in_buffer.data() + in_buffer.size());
+}
+
+CompressingOutputStream::CompressingOutputStream(const std::string & content_encoding, std::ostream & raw_stream)
+    : std::ostream(nullptr)
+{
+    if (Poco::UTF8::icompare(content_encoding, "gzip") == 0)
+        zlib_buf = std::make_unique<Poco::DeflatingStreamBuf>(raw_stream, Poco::DeflatingStreamBuf::STREAM_GZIP, Z_DEFAULT_COMPRESSION);
+    else if (Poco::UTF8::icompare(content_encoding, "deflate") == 0)
+        zlib_buf = std::make_unique<Poco::DeflatingStreamBuf>(raw_stream, Poco::DeflatingStreamBuf::STREAM_ZLIB, Z_DEFAULT_COMPRESSION);
+    else if (Poco::UTF8::icompare(content_encoding, "lz4") == 0)
+        lz4_buf = std::make_unique<LZ4DeflatingStreamBuf>(raw_stream);
+    else
+        throw std::runtime_error("'" + content_encoding + "' content encoding is not supported");
+
+    if (zlib_buf)
+        init(zlib_buf.get());
+    else
+        init(lz4_buf.get());
+}
+
+CompressingOutputStream::~CompressingOutputStream() = default;
+
+void CompressingOutputStream::close() {
+    if (zlib_buf)
+        zlib_buf->close();
+    else
+        lz4_buf->close();
+
+    if (!good())
+        throw std::runtime_error("Unable to write compressed data");
+}
+
+void writeCompressed(const std::string & content_encoding, const std::string & data, std::ostream & dest) {
+    CompressingOutputStream stream(content_encoding, dest);
+    stream.write(data.data(), data.size());
+    stream.close();
+}
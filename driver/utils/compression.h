@@ -0,0 +1,102 @@
+#pragma once
+
+#include "driver/platform/platform.h"
+
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+struct LZ4F_dctx_s;
+struct LZ4F_cctx_s;
+
+namespace Poco {
+    class DeflatingStreamBuf;
+}
+
+// A stream buffer that decompresses LZ4 frames read from the underlying stream on the fly.
+class LZ4InflatingStreamBuf
+    : public std::streambuf
+{
+public:
+    explicit LZ4InflatingStreamBuf(std::istream & raw_stream);
+    virtual ~LZ4InflatingStreamBuf() override;
+
+    LZ4InflatingStreamBuf(const LZ4InflatingStreamBuf &) = delete;
+    LZ4InflatingStreamBuf & operator= (const LZ4InflatingStreamBuf &) = delete;
+
+protected:
+    virtual int_type underflow() override;
+
+private:
+    std::istream & raw_stream;
+    LZ4F_dctx_s * context = nullptr;
+    std::vector<char> in_buffer;
+    std::size_t in_offset = 0;
+    std::size_t in_size = 0;
+    std::vector<char> out_buffer;
+    bool frame_complete = true;
+};
+
+class LZ4InflatingInputStream
+    : public std::istream
+{
+public:
+    explicit LZ4InflatingInputStream(std::istream & raw_stream);
+
+private:
+    LZ4InflatingStreamBuf buf;
+};
+
+// A stream buffer that compresses the data written to it into an LZ4 frame, and writes it to the underlying stream on the fly.
+// close() must be called, once all the data is written, to complete the frame.
+class LZ4DeflatingStreamBuf
+    : public std::streambuf
+{
+public:
+    explicit LZ4DeflatingStreamBuf(std::ostream & raw_stream);
+    virtual ~LZ4DeflatingStreamBuf() override;
+
+    LZ4DeflatingStreamBuf(const LZ4DeflatingStreamBuf &) = delete;
+    LZ4DeflatingStreamBuf & operator= (const LZ4DeflatingStreamBuf &) = delete;
+
+    void close();
+
+protected:
+    virtual int_type overflow(int_type ch) override;
+
+private:
+    void compressPending();
+
+private:
+    std::ostream & raw_stream;
+    LZ4F_cctx_s * context = nullptr;
+    std::vector<char> in_buffer;
+    std::vector<char> out_buffer;
+    bool frame_started = false;
+};
+
+// A stream that compresses the data written to it according to the value of Content-Encoding HTTP header, and writes it to raw_stream.
+// close() must be called, once all the data is written, to complete the compressed data.
+class CompressingOutputStream
+    : public std::ostream
+{
+public:
+    CompressingOutputStream(const std::string & content_encoding, std::ostream & raw_stream);
+    virtual ~CompressingOutputStream() override;
+
+    void close();
+
+private:
+    std::unique_ptr<Poco::DeflatingStreamBuf> zlib_buf;
+    std::unique_ptr<LZ4DeflatingStreamBuf> lz4_buf;
+};
+
+// Returns a stream that decompresses the data read from raw_stream according to the value of Content-Encoding HTTP header,
+// or nullptr, if the data is not compressed and raw_stream must be read directly.
+std::unique_ptr<std::istream> make_decompressing_stream(const std::string & content_encoding, std::istream & raw_stream);
+
+// Writes data to dest, compressed according to the value of Content-Encoding HTTP header.
+void writeCompressed(const std::string & content_encoding, const std::string & data, std::ostream & dest);
@@ -5,6 +5,7 @@
 #include <codecvt>
 #include <locale>
 #include <string>
+#include <string_view>
 #include <type_traits>
 
 class UnicodeConversionContext {
@@ -161,6 +162,14 @@ inline decltype(auto) fromUTF8<unsigned short>(const std::string & src, UnicodeC
 }
 #endif
 
+template <typename CharType>
+inline auto fromUTF8(const std::string_view & src, UnicodeConversionContext & context) {
+    if constexpr (std::is_same_v<CharType, char>)
+        return std::string{src};
+    else
+        return std::basic_string<CharType>{fromUTF8<CharType>(std::string{src}, context)};
+}
+
 template <typename CharType>
 inline decltype(auto) fromUTF8(const std::string & src) {
     UnicodeConversionContext context;
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "driver/platform/platform.h"
+
+#include <functional>
+#include <limits>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+
+// A thread-safe map of at most max_size entries, whose weights, as told by put(), add up to at most max_weight,
+// that evicts the least recently used entries, when a new one doesn't fit. An entry heavier than max_weight is not stored at all.
+// Values are returned by copy, so for anything bigger than a handle, a std::shared_ptr to an immutable object should be stored.
+template <typename Key, typename Value>
+class LRUCache {
+public:
+    explicit LRUCache(const std::size_t max_size, const std::size_t max_weight = std::numeric_limits<std::size_t>::max())
+        : max_size_(max_size)
+        , max_weight_(max_weight)
+    {
+    }
+
+    std::optional<Value> get(const Key & key) {
+        std::scoped_lock lock(mutex_);
+
+        const auto it = index_.find(std::cref(key));
+        if (it == index_.end())
+            return std::nullopt;
+
+        entries_.splice(entries_.begin(), entries_, it->second);
+        return it->second->value;
+    }
+
+    void put(const Key & key, Value value, const std::size_t weight = 0) {
+        if (max_size_ == 0 || weight > max_weight_)
+            return;
+
+        std::scoped_lock lock(mutex_);
+
+        if (const auto it = index_.find(std::cref(key)); it != index_.end()) {
+            weight_ -= it->second->weight;
+            index_.erase(it->second->key);
+            entries_.erase(it->second);
+        }
+
+        while (!entries_.empty() && (entries_.size() >= max_size_ || weight_ + weight > max_weight_)) {
+            weight_ -= entries_.back().weight;
+            index_.erase(entries_.back().key);
+            entries_.pop_back();
+        }
+
+        entries_.push_front(Entry{key, std::move(value), weight});
+        index_.emplace(entries_.front().key, entries_.begin());
+        weight_ += weight;
+    }
+
+    void clear() {
+        std::scoped_lock lock(mutex_);
+        index_.clear();
+        entries_.clear();
+        weight_ = 0;
+    }
+
+    std::size_t size() const {
+        std::scoped_lock lock(mutex_);
+        return entries_.size();
+    }
+
+    std::size_t weight() const {
+        std::scoped_lock lock(mutex_);
+        return weight_;
+    }
+
+private:
+    struct Entry {
+        Key key;
+        Value value;
+        std::size_t weight = 0;
+    };
+
+    using Entries = std::list<Entry>;
+
+    // The index refers to the keys stored in the entries, which never move, so that each key is stored only once.
+    using KeyRef = std::reference_wrapper<const Key>;
+
+    struct KeyRefHash {
+        std::size_t operator() (const KeyRef & key) const {
+            return std::hash<Key>{}(key.get());
+        }
+    };
+
+    struct KeyRefEqual {
+        bool operator() (const KeyRef & lhs, const KeyRef & rhs) const {
+            return (lhs.get() == rhs.get());
+        }
+    };
+
+    const std::size_t max_size_;
+    const std::size_t max_weight_;
+    mutable std::mutex mutex_;
+    Entries entries_; // The most recently used entry first.
+    std::unordered_map<KeyRef, typename Entries::iterator, KeyRefHash, KeyRefEqual> index_;
+    std::size_t weight_ = 0;
+};
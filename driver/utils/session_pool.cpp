@@ -0,0 +1,105 @@
+#include "driver/utils/session_pool.h"
+
+#include <utility>
+#include <vector>
+
+SessionPool::SessionPool(std::size_t max_idle_per_endpoint_, Clock::duration max_idle_time_)
+    : max_idle_per_endpoint(max_idle_per_endpoint_)
+    , max_idle_time(max_idle_time_)
+{
+}
+
+SessionPool & SessionPool::getInstance() {
+    static auto * pool = new SessionPool;
+    return *pool;
+}
+
+std::string SessionPool::makeKey(
+    const std::string & proto,
+    const std::string & host,
+    std::uint16_t port,
+    const std::string & sslmode,
+    const std::string & private_key_file,
+    const std::string & certificate_file,
+    const std::string & ca_location
+) {
+    std::string key;
+
+    for (const auto * part : {&proto, &host, &sslmode, &private_key_file, &certificate_file, &ca_location}) {
+        key += *part;
+        key += '\0';
+    }
+
+    key += std::to_string(port);
+    return key;
+}
+
+std::unique_ptr<Poco::Net::HTTPClientSession> SessionPool::take(const std::string & key, Clock::time_point now) {
+    std::vector<std::unique_ptr<Poco::Net::HTTPClientSession>> stale_sessions; // Closed outside of the lock.
+    std::unique_ptr<Poco::Net::HTTPClientSession> session;
+
+    {
+        std::scoped_lock lock(mutex);
+        reapExpired(now);
+
+        const auto it = idle_sessions.find(key);
+        if (it == idle_sessions.end())
+            return nullptr;
+
+        auto & sessions = it->second;
+        while (!session && !sessions.empty()) {
+            auto candidate = std::move(sessions.back().session);
+            sessions.pop_back();
+
+            // The server may have closed the connection in the meantime.
+            if (candidate->connected())
+                session = std::move(candidate);
+            else
+                stale_sessions.emplace_back(std::move(candidate));
+        }
+
+        if (sessions.empty())
+            idle_sessions.erase(it);
+    }
+
+    return session;
+}
+
+void SessionPool::put(const std::string & key, std::unique_ptr<Poco::Net::HTTPClientSession> && session, Clock::time_point now) {
+    if (!session || !session->connected() || max_idle_per_endpoint == 0)
+        return;
+
+    std::unique_ptr<Poco::Net::HTTPClientSession> evicted_session; // Closed outside of the lock.
+
+    std::scoped_lock lock(mutex);
+    reapExpired(now);
+
+    auto & sessions = idle_sessions[key];
+    if (sessions.size() >= max_idle_per_endpoint) {
+        evicted_session = std::move(sessions.front().session);
+        sessions.pop_front();
+    }
+
+    sessions.push_back(IdleSession{std::move(session), now});
+}
+
+std::size_t SessionPool::getIdleCount(const std::string & key) {
+    std::scoped_lock lock(mutex);
+    const auto it = idle_sessions.find(key);
+    return (it == idle_sessions.end() ? 0 : it->second.size());
+}
+
+void SessionPool::reapExpired(Clock::time_point now) {
+    for (auto it = idle_sessions.begin(); it != idle_sessions.end(); ) {
+        auto & sessions = it->second;
+
+        while (!sessions.empty() && now - sessions.front().idle_since >= max_idle_time) {
+            sessions.pop_front();
+        }
+
+        if (sessions.empty())
+            it = idle_sessions.erase(it);
+        else
+            ++it;
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "driver/platform/platform.h"
+
+#include <Poco/Net/HTTPClientSession.h>
+
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// Process-wide pool of idle keep-alive HTTP sessions, shared by all connections, so that the connections
+// that are opened and closed often don't pay for TCP and TLS handshakes every time.
+// Sessions are pooled per endpoint, i.e., per protocol, host, port, and TLS settings, see makeKey().
+// Idle sessions are reaped lazily, whenever the pool is accessed, so no background thread is needed.
+class SessionPool {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::size_t default_max_idle_per_endpoint = 16;
+    static constexpr std::chrono::seconds default_max_idle_time{10}; // The default keep_alive_timeout of the server.
+
+    explicit SessionPool(std::size_t max_idle_per_endpoint_ = default_max_idle_per_endpoint, Clock::duration max_idle_time_ = default_max_idle_time);
+
+    // Lives forever, to avoid closing TLS sessions after the SSL machinery has been shut down at exit.
+    static SessionPool & getInstance();
+
+    static std::string makeKey(
+        const std::string & proto,
+        const std::string & host,
+        std::uint16_t port,
+        const std::string & sslmode,
+        const std::string & private_key_file,
+        const std::string & certificate_file,
+        const std::string & ca_location
+    );
+
+    // Returns the most recently used idle session to the endpoint, or nullptr, if there is none.
+    std::unique_ptr<Poco::Net::HTTPClientSession> take(const std::string & key, Clock::time_point now = Clock::now());
+
+    // Keeps the session for reuse, if it is still connected, and the endpoint has room for one more idle session.
+    void put(const std::string & key, std::unique_ptr<Poco::Net::HTTPClientSession> && session, Clock::time_point now = Clock::now());
+
+    std::size_t getIdleCount(const std::string & key);
+
+private:
+    struct IdleSession {
+        std::unique_ptr<Poco::Net::HTTPClientSession> session;
+        Clock::time_point idle_since;
+    };
+
+    void reapExpired(Clock::time_point now);
+
+private:
+    const std::size_t max_idle_per_endpoint;
+    const Clock::duration max_idle_time;
+
+    std::mutex mutex;
+    std::unordered_map<std::string, std::deque<IdleSession>> idle_sessions; // The most recently used session last.
+};
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "driver/platform/platform.h"
+
+#include <array>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+
+#include <cstdint>
+
+// A thread-safe map, split into ShardCount independently locked shards, so that concurrent lookups never block each other,
+// and concurrent modifications block each other only if their keys fall into the same shard.
+// Values are returned by copy, so they should be cheap to copy, e.g., handles or references.
+template <typename Key, typename Value, std::size_t ShardCount = 64>
+class ShardedMap {
+    static_assert(ShardCount > 0 && (ShardCount & (ShardCount - 1)) == 0, "ShardCount must be a power of 2");
+
+public:
+    void set(const Key & key, Value value) {
+        auto & shard = getShard(key);
+        std::unique_lock lock(shard.mutex);
+        shard.map.insert_or_assign(key, std::move(value));
+    }
+
+    void erase(const Key & key) noexcept {
+        auto & shard = getShard(key);
+        std::unique_lock lock(shard.mutex);
+        shard.map.erase(key);
+    }
+
+    std::optional<Value> find(const Key & key) const {
+        const auto & shard = getShard(key);
+        std::shared_lock lock(shard.mutex);
+
+        const auto it = shard.map.find(key);
+        if (it == shard.map.end())
+            return std::nullopt;
+
+        return it->second;
+    }
+
+    void clear() noexcept {
+        for (auto & shard : shards) {
+            std::unique_lock lock(shard.mutex);
+            shard.map.clear();
+        }
+    }
+
+private:
+    // Each shard occupies its own cache lines, so that the locking of one doesn't invalidate the others.
+    struct alignas(64) Shard {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<Key, Value> map;
+    };
+
+    static std::size_t getShardIdx(const Key & key) noexcept {
+        // Handles are mostly pointers, whose low bits are always zero, and std::hash of a pointer is usually the identity,
+        // so the hash is scrambled (Fibonacci hashing) and its high bits are used.
+        const auto hash = static_cast<std::uint64_t>(std::hash<Key>{}(key)) * 0x9E3779B97F4A7C15ull;
+        return static_cast<std::size_t>(hash >> 32) & (ShardCount - 1);
+    }
+
+    Shard & getShard(const Key & key) noexcept {
+        return shards[getShardIdx(key)];
+    }
+
+    const Shard & getShard(const Key & key) const noexcept {
+        return shards[getShardIdx(key)];
+    }
+
+private:
+    std::array<Shard, ShardCount> shards;
+};
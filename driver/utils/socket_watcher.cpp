@@ -0,0 +1,121 @@
+#include "driver/utils/socket_watcher.h"
+
+#include <algorithm>
+#include <thread>
+#include <utility>
+
+SocketWatcher::SocketWatcher(std::chrono::milliseconds poll_interval_)
+    : poll_interval(poll_interval_)
+{
+}
+
+SocketWatcher::~SocketWatcher() {
+    std::unique_lock lock(mutex);
+    watches.clear();
+    pending.clear();
+    stopped.wait(lock, [this] { return !running; });
+}
+
+SocketWatcher & SocketWatcher::getInstance() {
+    static auto * watcher = new SocketWatcher;
+    return *watcher;
+}
+
+std::uint64_t SocketWatcher::watch(const Poco::Net::Socket & socket, Callback callback) {
+    std::scoped_lock lock(mutex);
+
+    const auto id = next_id++;
+    watches.emplace(id, Watch{socket, std::move(callback)});
+
+    if (!running) {
+        running = true;
+        std::thread(&SocketWatcher::run, this).detach();
+    }
+
+    return id;
+}
+
+void SocketWatcher::unwatch(std::uint64_t id) {
+    std::scoped_lock lock(mutex);
+    watches.erase(id);
+    pending.erase(id);
+}
+
+std::size_t SocketWatcher::getWatchedCount() {
+    std::scoped_lock lock(mutex);
+    return watches.size();
+}
+
+void SocketWatcher::run() {
+    std::unique_lock lock(mutex);
+
+    while (!watches.empty()) {
+        Poco::Net::Socket::SocketList readable;
+        Poco::Net::Socket::SocketList writable;
+
+        for (auto it = watches.begin(); it != watches.end(); ) {
+            // The socket has been closed by its owner, without unwatching it first.
+            if (it->second.socket.impl()->sockfd() == POCO_INVALID_SOCKET) {
+                it = watches.erase(it);
+                continue;
+            }
+
+            readable.push_back(it->second.socket);
+            ++it;
+        }
+
+        auto failed = readable;
+
+        // The sockets that start being watched in the meantime are picked up on the next iteration.
+        lock.unlock();
+
+        try {
+            Poco::Net::Socket::select(readable, writable, failed, Poco::Timespan(std::chrono::microseconds(poll_interval).count()));
+        }
+        catch (...) {
+            // Some socket has been closed while being selected, all of them are checked again on the next iteration.
+            readable.clear();
+            failed.clear();
+            std::this_thread::sleep_for(poll_interval);
+        }
+
+        lock.lock();
+
+        const auto is_ready = [&] (const Poco::Net::Socket & socket) {
+            return (
+                std::find(readable.begin(), readable.end(), socket) != readable.end() ||
+                std::find(failed.begin(), failed.end(), socket) != failed.end()
+            );
+        };
+
+        for (auto it = watches.begin(); it != watches.end(); ) {
+            if (!is_ready(it->second.socket)) {
+                ++it;
+                continue;
+            }
+
+            pending.emplace(it->first, std::move(it->second.callback));
+            it = watches.erase(it);
+        }
+
+        // The callbacks are called without the lock held, since they may e.g. complete the statement, which unwatches its socket.
+        while (!pending.empty()) {
+            const auto it = pending.begin();
+            const auto callback = std::move(it->second);
+            pending.erase(it);
+
+            lock.unlock();
+
+            try {
+                callback();
+            }
+            catch (...) {
+            }
+
+            lock.lock();
+        }
+    }
+
+    running = false;
+    stopped.notify_all();
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "driver/platform/platform.h"
+
+#include <Poco/Net/Socket.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+
+#include <cstdint>
+
+// Driver-owned I/O thread, that waits until any of the watched sockets has data to read, and calls the callback of that socket,
+// so that any number of asynchronously executed statements can notify the application about the arrival of their responses,
+// without a thread per statement. The thread is started on demand, and exits as soon as there is nothing to watch.
+class SocketWatcher {
+public:
+    using Callback = std::function<void()>;
+
+    static constexpr std::chrono::milliseconds default_poll_interval{10}; // How soon the sockets that start being watched are noticed.
+
+    explicit SocketWatcher(std::chrono::milliseconds poll_interval_ = default_poll_interval);
+    ~SocketWatcher();
+
+    // Lives forever, since the I/O thread may still be running, when the last user of it is gone.
+    static SocketWatcher & getInstance();
+
+    // Calls the callback once, on the I/O thread, when the socket becomes readable, or fails, and stops watching it.
+    // The callbacks are called one at a time, without the internal lock held, so they may use the watcher, but should be quick.
+    std::uint64_t watch(const Poco::Net::Socket & socket, Callback callback);
+
+    // Stops watching the socket. Once this returns, the callback of the socket won't be called, but it may be still running,
+    // since waiting for it would deadlock with a callback that waits for the caller, e.g. to complete the same statement.
+    void unwatch(std::uint64_t id);
+
+    std::size_t getWatchedCount();
+
+private:
+    struct Watch {
+        Poco::Net::Socket socket;
+        Callback callback;
+    };
+
+    void run();
+
+private:
+    const std::chrono::milliseconds poll_interval;
+
+    std::mutex mutex;
+    std::condition_variable stopped;
+    std::unordered_map<std::uint64_t, Watch> watches;
+    std::unordered_map<std::uint64_t, Callback> pending; // Ready to be called, in the current iteration.
+    std::uint64_t next_id = 1;
+    bool running = false;
+};
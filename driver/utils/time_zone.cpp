@@ -0,0 +1,665 @@
+#include "driver/utils/time_zone.h"
+#include "driver/utils/utils.h"
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+
+#include <cctype>
+#include <cstdlib>
+
+namespace {
+
+    constexpr std::int64_t seconds_per_day = 24 * 60 * 60;
+
+    // Range of days, for which the dates and the offsets are tabulated: [1900-01-01, 2300-01-01),
+    // which covers the ranges of all ClickHouse date and time types.
+    constexpr std::int64_t first_tabulated_day = -25567;
+    constexpr std::int64_t last_tabulated_day = 120530;
+
+    // Offsets are given for these years, at most, when generated from the POSIX TZ string of a time zone.
+    constexpr std::int64_t first_rule_year = 1900;
+    constexpr std::int64_t last_rule_year = 2300;
+
+    inline std::int64_t floorDiv(std::int64_t value, std::int64_t divisor) {
+        const auto quotient = value / divisor;
+        return ((value % divisor < 0) ? quotient - 1 : quotient);
+    }
+
+    // The algorithms of days_from_civil() and civil_from_days() by Howard Hinnant.
+
+    std::int64_t daysFromCivil(std::int64_t year, unsigned month, unsigned day) {
+        year -= (month <= 2);
+        const std::int64_t era = (year >= 0 ? year : year - 399) / 400;
+        const auto year_of_era = static_cast<unsigned>(year - era * 400);
+        const auto day_of_year = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+        const auto day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+        return era * 146097 + static_cast<std::int64_t>(day_of_era) - 719468;
+    }
+
+    CivilDate civilFromDays(std::int64_t days) {
+        days += 719468;
+        const std::int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+        const auto day_of_era = static_cast<unsigned>(days - era * 146097);
+        const auto year_of_era = (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365;
+        const auto day_of_year = day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+        const auto shifted_month = (5 * day_of_year + 2) / 153;
+        const auto month = (shifted_month < 10 ? shifted_month + 3 : shifted_month - 9);
+
+        CivilDate date;
+        date.year = static_cast<std::int16_t>(static_cast<std::int64_t>(year_of_era) + era * 400 + (month <= 2));
+        date.month = static_cast<std::uint8_t>(month);
+        date.day = static_cast<std::uint8_t>(day_of_year - (153 * shifted_month + 2) / 5 + 1);
+        return date;
+    }
+
+    const std::vector<CivilDate> & getDateTable() {
+        static const auto table = [] {
+            std::vector<CivilDate> dates;
+            dates.reserve(last_tabulated_day - first_tabulated_day);
+
+            for (auto day = first_tabulated_day; day < last_tabulated_day; ++day) {
+                dates.push_back(civilFromDays(day));
+            }
+
+            return dates;
+        }();
+
+        return table;
+    }
+
+    inline bool isLeapYear(std::int64_t year) {
+        return (year % 4 == 0 && (year % 100 != 0 || year % 400 == 0));
+    }
+
+    inline unsigned getMonthLength(std::int64_t year, unsigned month) {
+        static constexpr unsigned lengths[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+        return lengths[month - 1] + (month == 2 && isLeapYear(year));
+    }
+
+    // A rule of POSIX TZ string, that defines when the daylight saving time starts or ends.
+    struct PosixRule {
+        char kind = 'M';      // 'J' - Julian day, ignoring Feb 29; 'N' - zero-based day of year, counting Feb 29; 'M' - day of week of a month.
+        unsigned day = 0;     // For 'J' and 'N' rules.
+        unsigned month = 0;   // For 'M' rules.
+        unsigned week = 0;    // For 'M' rules, 5 means the last one.
+        unsigned weekday = 0; // For 'M' rules, 0 is Sunday.
+        std::int32_t time = 2 * 60 * 60; // Local time of the change.
+    };
+
+    struct PosixTZ {
+        std::int32_t std_offset = 0;
+        bool has_dst = false;
+        std::int32_t dst_offset = 0;
+        PosixRule dst_start;
+        PosixRule dst_end;
+    };
+
+    class PosixTZParser {
+    public:
+        explicit PosixTZParser(const std::string & str_)
+            : str(str_)
+        {
+        }
+
+        bool parse(PosixTZ & tz) {
+            if (!parseName())
+                return false;
+
+            std::int32_t offset = 0;
+            if (!parseOffset(offset, 24))
+                return false;
+
+            tz.std_offset = -offset; // POSIX offsets are positive to the west of Greenwich.
+
+            if (atEnd())
+                return true;
+
+            if (!parseName())
+                return false;
+
+            tz.has_dst = true;
+            tz.dst_offset = tz.std_offset + 60 * 60;
+
+            if (!atEnd() && peek() != ',') {
+                if (!parseOffset(offset, 24))
+                    return false;
+
+                tz.dst_offset = -offset;
+            }
+
+            // The rules are implementation-defined, if omitted. US rules are the usual choice.
+            if (atEnd()) {
+                tz.dst_start = PosixRule{'M', 0, 3, 2, 0};
+                tz.dst_end = PosixRule{'M', 0, 11, 1, 0};
+                return true;
+            }
+
+            return (
+                consume(',') && parseRule(tz.dst_start) &&
+                consume(',') && parseRule(tz.dst_end) &&
+                atEnd()
+            );
+        }
+
+    private:
+        bool atEnd() const {
+            return (pos >= str.size());
+        }
+
+        char peek() const {
+            return str[pos];
+        }
+
+        bool consume(char ch) {
+            if (atEnd() || peek() != ch)
+                return false;
+
+            ++pos;
+            return true;
+        }
+
+        bool parseName() {
+            const auto begin = pos;
+
+            if (consume('<')) {
+                while (!atEnd() && peek() != '>')
+                    ++pos;
+
+                return consume('>') && (pos - begin > 2);
+            }
+
+            while (!atEnd() && std::isalpha(static_cast<unsigned char>(peek())))
+                ++pos;
+
+            return (pos - begin >= 3);
+        }
+
+        bool parseNumber(unsigned & value, unsigned max_value) {
+            const auto begin = pos;
+            value = 0;
+
+            while (!atEnd() && std::isdigit(static_cast<unsigned char>(peek()))) {
+                value = value * 10 + (peek() - '0');
+                if (value > max_value)
+                    return false;
+
+                ++pos;
+            }
+
+            return (pos > begin);
+        }
+
+        // [+|-]hh[:mm[:ss]]
+        bool parseOffset(std::int32_t & offset, unsigned max_hours) {
+            bool negative = false;
+
+            if (consume('-'))
+                negative = true;
+            else
+                consume('+');
+
+            unsigned hours = 0;
+            unsigned minutes = 0;
+            unsigned seconds = 0;
+
+            if (!parseNumber(hours, max_hours))
+                return false;
+
+            if (consume(':')) {
+                if (!parseNumber(minutes, 59))
+                    return false;
+
+                if (consume(':') && !parseNumber(seconds, 59))
+                    return false;
+            }
+
+            offset = static_cast<std::int32_t>(hours * 60 * 60 + minutes * 60 + seconds);
+
+            if (negative)
+                offset = -offset;
+
+            return true;
+        }
+
+        // Jn | n | Mm.w.d, optionally followed by /time
+        bool parseRule(PosixRule & rule) {
+            if (consume('J')) {
+                rule.kind = 'J';
+                if (!parseNumber(rule.day, 365) || rule.day < 1)
+                    return false;
+            }
+            else if (consume('M')) {
+                rule.kind = 'M';
+                if (
+                    !parseNumber(rule.month, 12) || rule.month < 1 || !consume('.') ||
+                    !parseNumber(rule.week, 5) || rule.week < 1 || !consume('.') ||
+                    !parseNumber(rule.weekday, 6)
+                ) {
+                    return false;
+                }
+            }
+            else {
+                rule.kind = 'N';
+                if (!parseNumber(rule.day, 365))
+                    return false;
+            }
+
+            rule.time = 2 * 60 * 60;
+
+            // Hours up to 167, and negative times, are an extension, that is used by TZif files.
+            if (consume('/') && !parseOffset(rule.time, 167))
+                return false;
+
+            return true;
+        }
+
+    private:
+        const std::string & str;
+        std::size_t pos = 0;
+    };
+
+    // Days since the Unix epoch of the day, when the rule applies in the given year.
+    std::int64_t getRuleDay(const PosixRule & rule, std::int64_t year) {
+        const auto first_day_of_year = daysFromCivil(year, 1, 1);
+
+        switch (rule.kind) {
+            case 'J':
+                return first_day_of_year + rule.day - 1 + (isLeapYear(year) && rule.day >= 60 ? 1 : 0);
+
+            case 'N':
+                return first_day_of_year + rule.day;
+
+            default: {
+                const auto first_day_of_month = daysFromCivil(year, rule.month, 1);
+                const auto first_weekday = static_cast<unsigned>(first_day_of_month + 4 - floorDiv(first_day_of_month + 4, 7) * 7); // 1970-01-01 is Thursday.
+                auto day = (rule.weekday + 7 - first_weekday) % 7 + (rule.week - 1) * 7;
+
+                while (day >= getMonthLength(year, rule.month))
+                    day -= 7;
+
+                return first_day_of_month + day;
+            }
+        }
+    }
+
+    void appendPeriod(std::vector<TimeZone::Period> & periods, std::int64_t start, std::int32_t offset) {
+        if (!periods.empty()) {
+            if (start <= periods.back().start || offset == periods.back().offset)
+                return;
+        }
+
+        periods.push_back(TimeZone::Period{start, offset});
+    }
+
+    // Extends the periods with the offset changes defined by the POSIX TZ string, up to the last_rule_year.
+    void appendPosixTZPeriods(const PosixTZ & tz, std::vector<TimeZone::Period> & periods) {
+        // Without daylight saving time, the offset after the last transition is already in effect.
+        if (!tz.has_dst) {
+            if (periods.size() == 1)
+                periods.front().offset = tz.std_offset;
+
+            return;
+        }
+
+        const auto first_year = (periods.size() > 1 ? civilFromDays(floorDiv(periods.back().start, seconds_per_day)).year : first_rule_year);
+
+        for (std::int64_t year = first_year; year <= last_rule_year; ++year) {
+            // The start is given in standard time, the end is given in daylight saving time.
+            const auto start = getRuleDay(tz.dst_start, year) * seconds_per_day + tz.dst_start.time - tz.std_offset;
+            const auto end = getRuleDay(tz.dst_end, year) * seconds_per_day + tz.dst_end.time - tz.dst_offset;
+
+            if (start < end) {
+                appendPeriod(periods, start, tz.dst_offset);
+                appendPeriod(periods, end, tz.std_offset);
+            }
+            else {
+                appendPeriod(periods, end, tz.std_offset);
+                appendPeriod(periods, start, tz.dst_offset);
+            }
+        }
+    }
+
+    template <typename T>
+    bool readBigEndian(const std::string & data, std::size_t & pos, T & value) {
+        if (data.size() < pos + sizeof(T))
+            return false;
+
+        std::make_unsigned_t<T> tmp = 0;
+        for (std::size_t i = 0; i < sizeof(T); ++i) {
+            tmp = (tmp << 8) | static_cast<unsigned char>(data[pos + i]);
+        }
+
+        value = static_cast<T>(tmp);
+        pos += sizeof(T);
+        return true;
+    }
+
+    bool isUTCName(const std::string & name) {
+        static const std::array<std::string, 7> names = {"UTC", "GMT", "Etc/UTC", "Etc/GMT", "UCT", "Universal", "Zulu"};
+        return std::find(names.begin(), names.end(), name) != names.end();
+    }
+
+#ifndef _win_
+    // Only plain relative paths within the time zone database are accepted.
+    bool isSafeName(const std::string & name) {
+        if (name.empty() || name.front() == '/' || name.find("..") != std::string::npos)
+            return false;
+
+        return std::all_of(name.begin(), name.end(), [] (char ch) {
+            return (std::isalnum(static_cast<unsigned char>(ch)) || ch == '/' || ch == '_' || ch == '-' || ch == '+');
+        });
+    }
+
+    bool readFile(const std::string & path, std::string & data) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+            return false;
+
+        std::ostringstream contents;
+        contents << file.rdbuf();
+
+        if (!file && !file.eof())
+            return false;
+
+        data = contents.str();
+        return true;
+    }
+
+    bool loadTZifFile(const std::string & path, std::vector<TimeZone::Period> & periods) {
+        std::string data;
+        return (readFile(path, data) && parseTZif(data, periods));
+    }
+#endif
+
+    bool loadNamedPeriods(const std::string & name, std::vector<TimeZone::Period> & periods) {
+        if (isUTCName(name)) {
+            periods.push_back(TimeZone::Period{std::numeric_limits<std::int64_t>::min(), 0});
+            return true;
+        }
+
+#ifndef _win_
+        if (!isSafeName(name))
+            return false;
+
+        std::vector<std::string> dirs;
+
+        if (const auto * tzdir = std::getenv("TZDIR"); tzdir && *tzdir)
+            dirs.emplace_back(tzdir);
+
+        dirs.emplace_back("/usr/share/zoneinfo");
+        dirs.emplace_back("/usr/lib/zoneinfo");
+        dirs.emplace_back("/usr/share/lib/zoneinfo");
+
+        for (const auto & dir : dirs) {
+            if (loadTZifFile(dir + '/' + name, periods))
+                return true;
+
+            periods.clear();
+        }
+#endif
+
+        return false;
+    }
+
+    std::int32_t getLocalOffset(std::time_t time) {
+        std::tm tm = {};
+        toLocalTime(time, tm);
+
+        const auto local_time = daysFromCivil(1900 + tm.tm_year, tm.tm_mon + 1, tm.tm_mday) * seconds_per_day +
+            tm.tm_hour * 60 * 60 + tm.tm_min * 60 + tm.tm_sec;
+
+        return static_cast<std::int32_t>(local_time - time);
+    }
+
+    // Discovers the offset changes of the local time zone of the process, by sampling the local time every day,
+    // in the range of DateTime type, and pinpointing the exact moment of each change.
+    void sampleLocalPeriods(std::vector<TimeZone::Period> & periods) {
+        constexpr std::int64_t first_sampled_day = 0;     // 1970-01-01
+        constexpr std::int64_t last_sampled_day = 49710; // 2106-02-07
+
+        try {
+            periods.push_back(TimeZone::Period{std::numeric_limits<std::int64_t>::min(), getLocalOffset(0)});
+
+            for (auto day = first_sampled_day + 1; day <= last_sampled_day; ++day) {
+                const std::int64_t time = day * seconds_per_day;
+                const auto offset = getLocalOffset(time);
+
+                if (offset == periods.back().offset)
+                    continue;
+
+                // The change is somewhere within the last day.
+                std::int64_t low = time - seconds_per_day;
+                std::int64_t high = time;
+
+                while (high - low > 1) {
+                    const auto middle = low + (high - low) / 2;
+
+                    if (getLocalOffset(middle) == offset)
+                        high = middle;
+                    else
+                        low = middle;
+                }
+
+                appendPeriod(periods, high, offset);
+            }
+        }
+        catch (...) {
+            // The local time outside of the range supported by the platform is assumed to have the last known offset.
+            if (periods.empty())
+                periods.push_back(TimeZone::Period{std::numeric_limits<std::int64_t>::min(), 0});
+        }
+    }
+
+    std::vector<TimeZone::Period> loadPeriods(const std::string & name) {
+        std::vector<TimeZone::Period> periods;
+
+        if (!name.empty() && loadNamedPeriods(name, periods))
+            return periods;
+
+        periods.clear();
+
+#ifndef _win_
+        // Unless overridden by TZ, the local time zone is defined by the TZif file at /etc/localtime.
+        const auto * tz = std::getenv("TZ");
+        const std::string tz_name = (tz ? tz : "");
+
+        if (tz_name.empty() && loadTZifFile("/etc/localtime", periods))
+            return periods;
+
+        periods.clear();
+
+        if (!tz_name.empty() && loadNamedPeriods(tz_name.front() == ':' ? tz_name.substr(1) : tz_name, periods))
+            return periods;
+
+        periods.clear();
+#endif
+
+        sampleLocalPeriods(periods);
+        return periods;
+    }
+
+} // namespace
+
+bool parseTZif(const std::string & data, std::vector<TimeZone::Period> & periods) {
+    constexpr std::size_t header_size = 44;
+
+    if (data.size() < header_size || data.compare(0, 4, "TZif") != 0)
+        return false;
+
+    const auto version = data[4];
+    std::size_t pos = 20;
+
+    std::uint32_t isutcnt = 0, isstdcnt = 0, leapcnt = 0, timecnt = 0, typecnt = 0, charcnt = 0;
+
+    const auto read_counts = [&] () {
+        return (
+            readBigEndian(data, pos, isutcnt) && readBigEndian(data, pos, isstdcnt) && readBigEndian(data, pos, leapcnt) &&
+            readBigEndian(data, pos, timecnt) && readBigEndian(data, pos, typecnt) && readBigEndian(data, pos, charcnt)
+        );
+    };
+
+    if (!read_counts())
+        return false;
+
+    // Version 2+ files repeat the data with 64-bit transition times, after the version 1 data, which is skipped then.
+    std::size_t time_size = 4;
+
+    if (version >= '2') {
+        pos += std::size_t{timecnt} * 4 + timecnt + std::size_t{typecnt} * 6 + charcnt + std::size_t{leapcnt} * 8 + isstdcnt + isutcnt;
+        pos += 20;
+
+        if (!read_counts())
+            return false;
+
+        time_size = 8;
+    }
+
+    // Time zones that account for leap seconds are not supported.
+    if (typecnt == 0 || leapcnt != 0)
+        return false;
+
+    std::vector<std::int64_t> times(timecnt);
+    for (auto & time : times) {
+        if (time_size == 8) {
+            if (!readBigEndian(data, pos, time))
+                return false;
+        }
+        else {
+            std::int32_t time32 = 0;
+            if (!readBigEndian(data, pos, time32))
+                return false;
+
+            time = time32;
+        }
+    }
+
+    if (data.size() < pos + timecnt)
+        return false;
+
+    const auto types_pos = pos;
+    pos += timecnt;
+
+    std::vector<std::int32_t> offsets(typecnt);
+    for (auto & offset : offsets) {
+        if (!readBigEndian(data, pos, offset))
+            return false;
+
+        pos += 2; // isdst and desigidx
+    }
+
+    pos += std::size_t{charcnt} + std::size_t{leapcnt} * (time_size + 4) + isstdcnt + isutcnt;
+
+    if (data.size() < pos)
+        return false;
+
+    periods.clear();
+    periods.push_back(TimeZone::Period{std::numeric_limits<std::int64_t>::min(), offsets.front()});
+
+    for (std::size_t i = 0; i < timecnt; ++i) {
+        const auto type = static_cast<unsigned char>(data[types_pos + i]);
+        if (type >= typecnt)
+            return false;
+
+        appendPeriod(periods, times[i], offsets[type]);
+    }
+
+    // The footer holds the POSIX TZ string, that defines the offset changes after the last transition.
+    if (version >= '2' && pos < data.size() && data[pos] == '\n') {
+        const auto end = data.find('\n', pos + 1);
+
+        if (end != std::string::npos && end > pos + 1) {
+            const auto footer = data.substr(pos + 1, end - pos - 1);
+
+            PosixTZ tz;
+            if (PosixTZParser{footer}.parse(tz))
+                appendPosixTZPeriods(tz, periods);
+        }
+    }
+
+    return true;
+}
+
+TimeZone::TimeZone(const std::string & name_, std::vector<Period> && periods_)
+    : name(name_)
+    , periods(std::move(periods_))
+{
+    if (periods.empty())
+        periods.push_back(Period{std::numeric_limits<std::int64_t>::min(), 0});
+
+    // Pathological time zones with too many offset changes are handled by the binary search only.
+    if (periods.size() > std::numeric_limits<std::uint16_t>::max())
+        return;
+
+    day_periods.reserve(last_tabulated_day - first_tabulated_day);
+
+    std::size_t idx = 0;
+    for (auto day = first_tabulated_day; day < last_tabulated_day; ++day) {
+        const auto time = day * seconds_per_day;
+
+        while (idx + 1 < periods.size() && periods[idx + 1].start <= time)
+            ++idx;
+
+        day_periods.push_back(static_cast<std::uint16_t>(idx));
+    }
+}
+
+const TimeZone & TimeZone::get(const std::string & name) {
+    static std::mutex mutex;
+    static std::map<std::string, std::unique_ptr<TimeZone>> time_zones;
+
+    std::lock_guard lock(mutex);
+
+    auto & time_zone = time_zones[name];
+    if (!time_zone)
+        time_zone = std::make_unique<TimeZone>(name, loadPeriods(name));
+
+    return *time_zone;
+}
+
+CivilDate TimeZone::toCivilDate(std::int64_t days) {
+    if (days >= first_tabulated_day && days < last_tabulated_day)
+        return getDateTable()[days - first_tabulated_day];
+
+    return civilFromDays(days);
+}
+
+std::int32_t TimeZone::getOffset(std::int64_t time) const {
+    const auto day = floorDiv(time, seconds_per_day);
+    std::size_t idx = 0;
+
+    if (!day_periods.empty() && day >= first_tabulated_day && day < last_tabulated_day) {
+        // There may be an offset change later in the day.
+        idx = day_periods[day - first_tabulated_day];
+        while (idx + 1 < periods.size() && periods[idx + 1].start <= time)
+            ++idx;
+    }
+    else {
+        const auto it = std::upper_bound(periods.begin(), periods.end(), time, [] (std::int64_t value, const Period & period) {
+            return value < period.start;
+        });
+
+        idx = (it == periods.begin() ? 0 : std::distance(periods.begin(), it) - 1);
+    }
+
+    return periods[idx].offset;
+}
+
+CivilTime TimeZone::toCivilTime(std::int64_t time) const {
+    const auto local_time = time + getOffset(time);
+    const auto days = floorDiv(local_time, seconds_per_day);
+    const auto seconds = local_time - days * seconds_per_day;
+
+    CivilTime civil_time;
+    civil_time.date = toCivilDate(days);
+    civil_time.hour = static_cast<std::uint8_t>(seconds / (60 * 60));
+    civil_time.minute = static_cast<std::uint8_t>(seconds / 60 % 60);
+    civil_time.second = static_cast<std::uint8_t>(seconds % 60);
+    return civil_time;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "driver/platform/platform.h"
+
+#include <string>
+#include <vector>
+
+#include <cstdint>
+
+// Date of the proleptic Gregorian calendar.
+struct CivilDate {
+    std::int16_t year = 1970;
+    std::uint8_t month = 1;
+    std::uint8_t day = 1;
+};
+
+struct CivilTime {
+    CivilDate date;
+    std::uint8_t hour = 0;
+    std::uint8_t minute = 0;
+    std::uint8_t second = 0;
+};
+
+// Converts Unix timestamps to the civil time of a specific time zone.
+// All the UTC offset changes of the time zone are loaded once, and indexed by day, so that a conversion
+// is a couple of table lookups, instead of a call to localtime_r(), which also knows only about the local time zone of the process.
+class TimeZone {
+public:
+    // Range of times, in seconds since the Unix epoch, whose civil time is representable: [0001-01-01 00:00:00, 9999-12-31 23:59:59],
+    // with some margin for the offset of the time zone.
+    static constexpr std::int64_t min_time = -62135596800 + 86400;
+    static constexpr std::int64_t max_time = 253402300799 - 86400;
+
+    // Returns the time zone with the given IANA name, e.g., "Europe/Berlin". The time zone is loaded on first use, and lives forever.
+    // The local time zone of the process is returned for an empty name, or for a name that can't be resolved.
+    static const TimeZone & get(const std::string & name);
+
+    // Converts the number of days since the Unix epoch to the date.
+    static CivilDate toCivilDate(std::int64_t days);
+
+    // Converts the number of seconds since the Unix epoch to the civil time in this time zone.
+    CivilTime toCivilTime(std::int64_t time) const;
+
+    // Offset of the civil time in this time zone from UTC, in seconds, at the given number of seconds since the Unix epoch.
+    std::int32_t getOffset(std::int64_t time) const;
+
+    const std::string & getName() const {
+        return name;
+    }
+
+public:
+    // A span of time, that starts at the given number of seconds since the Unix epoch, during which the UTC offset doesn't change.
+    struct Period {
+        std::int64_t start;
+        std::int32_t offset;
+    };
+
+    // periods must be ordered by their start, the first period is treated as extending infinitely into the past.
+    explicit TimeZone(const std::string & name_, std::vector<Period> && periods_);
+
+private:
+    std::string name;
+    std::vector<Period> periods;
+    std::vector<std::uint16_t> day_periods; // Index of the period in effect at the start of each tabulated day (in UTC).
+};
+
+// Parses the contents of a TZif file (RFC 8536), including the POSIX TZ string of its footer, if any,
+// which defines the offset changes after the last transition, into the periods of the time zone.
+// Returns false, if the data is malformed, or uses features that are not supported.
+bool parseTZif(const std::string & data, std::vector<TimeZone::Period> & periods);
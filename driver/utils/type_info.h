@@ -4,6 +4,8 @@
 #include "driver/utils/utils.h"
 #include "driver/utils/sql_encoding.h"
 #include "driver/utils/conversion.h"
+#include "driver/utils/time_zone.h"
+#include "driver/utils/wide_integer.h"
 #include "driver/exception.h"
 
 #include <algorithm>
@@ -11,6 +13,8 @@
 #include <cstring>
 #include <limits>
 #include <string>
+#include <string_view>
+#include <tuple>
 
 #define lengthof(a) (sizeof(a) / sizeof(a[0]))
 
@@ -37,6 +41,10 @@ enum class DataSourceTypeId {
     DateTime,
     UUID,
     Array,
+    Int128,
+    UInt128,
+    Int256,
+    UInt256,
 
     // This item must be last, as it is also used
     // to get the number of element in the Enum
@@ -89,6 +97,10 @@ struct TypeInfo {
             case UInt32:
             case Int64:
             case UInt64:
+            case Int128:
+            case UInt128:
+            case Int256:
+            case UInt256:
                 return true;
             default:
                 return false;
@@ -194,6 +206,14 @@ public:
             .octet_length=sizeof(SQLGUID)},
         {.type_id=Array, .type_name="Array", .data_type=SQL_VARCHAR, .column_size=string_max_size,
             .octet_length=string_max_size},
+        {.type_id=Int128, .type_name="Int128", .data_type=SQL_DECIMAL, .column_size=1 + 39,
+            .unsigned_attribute=Signed, .num_prec_radix=10, .octet_length=16},
+        {.type_id=UInt128, .type_name="UInt128", .data_type=SQL_DECIMAL, .column_size=39,
+            .unsigned_attribute=Unsigned, .num_prec_radix=10, .octet_length=16},
+        {.type_id=Int256, .type_name="Int256", .data_type=SQL_DECIMAL, .column_size=1 + 77,
+            .unsigned_attribute=Signed, .num_prec_radix=10, .octet_length=32},
+        {.type_id=UInt256, .type_name="UInt256", .data_type=SQL_DECIMAL, .column_size=78,
+            .unsigned_attribute=Unsigned, .num_prec_radix=10, .octet_length=32},
     }};
 
     // To avoid repetition in the table above,
@@ -272,7 +292,7 @@ struct ParamBindingInfo
 /// Helper structure that represents different aspects of parameter info in a prepared query.
 struct ParamInfo {
     std::string name;
-    std::string tmp_placeholder;
+    std::size_t offset = 0; // Position in the query text, from which the placeholder of the parameter has been cut out.
 };
 
 struct BoundTypeInfo {
@@ -342,18 +362,11 @@ inline SQLRETURN fillOutputBuffer(
     return SQL_SUCCESS;
 }
 
-// Change encoding, when appropriate, and write the result to the buffer.
-// Extra string copy happens here for wide char strings, and strings that require encoding change.
-template <typename CharType, typename LengthType1, typename LengthType2, typename ConversionContext>
-inline SQLRETURN fillOutputString(
-    const std::string & in_value,
+template <typename CharType, typename LengthType>
+inline void validateOutputStringBuffer(
     void * out_value,
-    LengthType1 out_value_max_length,
-    LengthType2 * out_value_length,
-    bool in_length_in_bytes,
-    bool out_length_in_bytes,
-    bool ensure_nts,
-    ConversionContext && context
+    LengthType out_value_max_length,
+    bool out_length_in_bytes
 ) {
     if (out_value) {
         if (out_value_max_length < 0)
@@ -362,9 +375,19 @@ inline SQLRETURN fillOutputString(
         if (out_length_in_bytes && (out_value_max_length % sizeof(CharType)) != 0)
             throw SqlException("Invalid string or buffer length", "HY090");
     }
+}
 
-    auto converted = fromUTF8<CharType>(in_value, context);
-
+// Write the string, that is already in the application encoding, to the buffer.
+// Returns false if the string, including the null terminating character, doesn't fit into the buffer.
+template <typename CharType, typename LengthType1, typename LengthType2>
+inline bool fillOutputConvertedStringInternal(
+    const std::basic_string_view<CharType> & converted,
+    void * out_value,
+    LengthType1 out_value_max_length,
+    LengthType2 * out_value_length,
+    bool out_length_in_bytes,
+    bool ensure_nts
+) {
     const auto converted_length_in_symbols = converted.size();
     const auto converted_length_in_bytes = converted_length_in_symbols * sizeof(CharType);
     const auto out_value_max_length_in_symbols = (out_length_in_bytes ? (out_value_max_length / sizeof(CharType)) : out_value_max_length);
@@ -377,8 +400,6 @@ inline SQLRETURN fillOutputString(
         out_value_max_length_in_bytes
     );
 
-    context.string_pool.retireString(std::move(converted));
-
     if (out_value_length) {
         if (out_length_in_bytes)
             *out_value_length = converted_length_in_bytes;
@@ -393,7 +414,55 @@ inline SQLRETURN fillOutputString(
             reinterpret_cast<CharType *>(out_value)[out_value_max_length_in_symbols - 1] = CharType{};
     }
 
-    if ((converted_length_in_symbols + 1) > out_value_max_length_in_symbols) // +1 for null terminating character
+    return ((converted_length_in_symbols + 1) <= out_value_max_length_in_symbols); // +1 for null terminating character
+}
+
+// Change encoding, when appropriate, and write the result to the buffer.
+// Extra string copy happens here for wide char strings, and strings that require encoding change.
+template <typename CharType, typename LengthType1, typename LengthType2, typename ConversionContext>
+inline SQLRETURN fillOutputString(
+    const std::string_view & in_value,
+    void * out_value,
+    LengthType1 out_value_max_length,
+    LengthType2 * out_value_length,
+    bool in_length_in_bytes,
+    bool out_length_in_bytes,
+    bool ensure_nts,
+    ConversionContext && context
+) {
+    validateOutputStringBuffer<CharType>(out_value, out_value_max_length, out_length_in_bytes);
+
+    auto converted = fromUTF8<CharType>(in_value, context);
+
+    const auto fits = fillOutputConvertedStringInternal<CharType>(
+        converted,
+        out_value,
+        out_value_max_length,
+        out_value_length,
+        out_length_in_bytes,
+        ensure_nts
+    );
+
+    context.string_pool.retireString(std::move(converted));
+
+    if (!fits)
+        throw SqlException("String data, right truncated", "01004", SQL_SUCCESS_WITH_INFO);
+
+    return SQL_SUCCESS;
+}
+
+// Same as above, but for the string that is already in the application encoding, e.g., the one converted and cached earlier.
+template <typename CharType, typename LengthType1, typename LengthType2>
+inline SQLRETURN fillOutputConvertedString(
+    const std::basic_string_view<CharType> & converted,
+    void * out_value,
+    LengthType1 out_value_max_length,
+    LengthType2 * out_value_length,
+    bool length_in_bytes
+) {
+    validateOutputStringBuffer<CharType>(out_value, out_value_max_length, length_in_bytes);
+
+    if (!fillOutputConvertedStringInternal<CharType>(converted, out_value, out_value_max_length, out_value_length, length_in_bytes, true))
         throw SqlException("String data, right truncated", "01004", SQL_SUCCESS_WITH_INFO);
 
     return SQL_SUCCESS;
@@ -401,7 +470,7 @@ inline SQLRETURN fillOutputString(
 
 template <typename CharType, typename LengthType1, typename LengthType2, typename ConversionContext = DefaultConversionContext>
 inline SQLRETURN fillOutputString(
-    const std::string & in_value,
+    const std::string_view & in_value,
     void * out_value,
     LengthType1 out_value_max_length,
     LengthType2 * out_value_length,
@@ -553,34 +622,29 @@ struct WireTypeAnyAsString
     using SimpleTypeWrapper<std::string>::SimpleTypeWrapper;
 };
 
+// Number of days since the Unix epoch. Date is a calendar day, so it is the same in every time zone.
 struct WireTypeDateAsInt {
-    explicit WireTypeDateAsInt(const std::string & timezone_)
-        : timezone(&timezone_)
-    {
-    }
-
     using ContainerIntType = std::uint16_t;
 
     ContainerIntType value = 0;
-    const std::string * timezone;
 };
 
 struct WireTypeDateTimeAsInt {
-    explicit WireTypeDateTimeAsInt(const std::string & timezone_)
-        : timezone(&timezone_)
+    explicit WireTypeDateTimeAsInt(const TimeZone & time_zone_)
+        : time_zone(&time_zone_)
     {
     }
 
     using ContainerIntType = std::uint32_t;
 
     ContainerIntType value = 0;
-    const std::string * timezone;
+    const TimeZone * time_zone;
 };
 
 struct WireTypeDateTime64AsInt {
-    explicit WireTypeDateTime64AsInt(std::int16_t precision_, const std::string & timezone_)
+    explicit WireTypeDateTime64AsInt(std::int16_t precision_, const TimeZone & time_zone_)
         : precision(precision_)
-        , timezone(&timezone_)
+        , time_zone(&time_zone_)
     {
     }
 
@@ -588,7 +652,7 @@ struct WireTypeDateTime64AsInt {
 
     ContainerIntType value = 0;
     std::int16_t precision;
-    const std::string * timezone;
+    const TimeZone * time_zone;
 };
 
 template <DataSourceTypeId Id> struct DataSourceType; // Leave unimplemented for general case.
@@ -619,9 +683,8 @@ struct DataSourceType<DataSourceTypeId::Decimal> {
     // An integer type big enough to hold the integer value that is built from all
     // decimal digits of Decimal/Numeric values, as if there is no decimal point.
     // Size of this integer defines the upper bound of the "info" the internal
-    // representation can carry.
-    // TODO: switch to some 128-bit or even arbitrary-precision unsigned integer type.
-    using ContainerIntType = std::uint_fast64_t;
+    // representation can carry, which is enough for Decimal256 and (U)Int256 values.
+    using ContainerIntType = WideUInt<256>;
 
     ContainerIntType value = 0;
     std::int8_t sign = 0;
@@ -647,6 +710,31 @@ struct DataSourceType<DataSourceTypeId::Decimal128>
 {
 };
 
+// Integers that do not fit into 64 bits are kept in the same representation as Decimal values, with zero scale.
+template <>
+struct DataSourceType<DataSourceTypeId::Int128>
+    : public DataSourceType<DataSourceTypeId::Decimal>
+{
+};
+
+template <>
+struct DataSourceType<DataSourceTypeId::UInt128>
+    : public DataSourceType<DataSourceTypeId::Decimal>
+{
+};
+
+template <>
+struct DataSourceType<DataSourceTypeId::Int256>
+    : public DataSourceType<DataSourceTypeId::Decimal>
+{
+};
+
+template <>
+struct DataSourceType<DataSourceTypeId::UInt256>
+    : public DataSourceType<DataSourceTypeId::Decimal>
+{
+};
+
 template <>
 struct DataSourceType<DataSourceTypeId::FixedString>
     : public SimpleTypeWrapper<std::string>
@@ -1168,7 +1256,6 @@ namespace value_manip {
         using DestinationType = DataSourceType<DataSourceTypeId::Decimal>;
 
         static inline void convert(const SourceType & src, DestinationType & dest) {
-            constexpr auto dest_value_max = (std::numeric_limits<std::decay_t<decltype(dest.value)>>::max)();
             constexpr std::uint32_t dec_mult = 10;
 
             std::size_t left_n = 0;
@@ -1214,17 +1301,8 @@ namespace value_manip {
                     case '9': {
                         const std::uint32_t next_dec_dig = static_cast<unsigned char>(ch - '0');
 
-                        if (dest.value != 0) {
-                            if ((dest_value_max / dec_mult) < dest.value)
-                                throw std::runtime_error("Cannot interpret '" + src + "' as Decimal/Numeric: value is too big for internal representation");
-                            dest.value *= dec_mult;
-                        }
-
-                        if (next_dec_dig != 0) {
-                            if ((dest_value_max - next_dec_dig) < dest.value)
-                                throw std::runtime_error("Cannot interpret '" + src + "' as Decimal/Numeric: value is too big for internal representation");
-                            dest.value += next_dec_dig;
-                        }
+                        if (!dest.value.tryMultiplyAdd(dec_mult, next_dec_dig))
+                            throw std::runtime_error("Cannot interpret '" + src + "' as Decimal/Numeric: value is too big for internal representation");
 
                         if (dot_met)
                             ++right_n;
@@ -1240,7 +1318,7 @@ namespace value_manip {
                 }
             }
 
-            if (dest.value == 0)
+            if (dest.value.isZero())
                 dest.sign = 1;
 
             dest.precision = left_n + right_n;
@@ -1275,6 +1353,56 @@ namespace value_manip {
         }
     };
 
+    template <>
+    struct from_value<std::string>::to_value<DataSourceType<DataSourceTypeId::Int128>> {
+        using DestinationType = DataSourceType<DataSourceTypeId::Int128>;
+
+        static inline void convert(const SourceType & src, DestinationType & dest) {
+            return to_value<DataSourceType<DataSourceTypeId::Decimal>>::convert(src, dest);
+        }
+    };
+
+    template <>
+    struct from_value<std::string>::to_value<DataSourceType<DataSourceTypeId::UInt128>> {
+        using DestinationType = DataSourceType<DataSourceTypeId::UInt128>;
+
+        static inline void convert(const SourceType & src, DestinationType & dest) {
+            return to_value<DataSourceType<DataSourceTypeId::Decimal>>::convert(src, dest);
+        }
+    };
+
+    template <>
+    struct from_value<std::string>::to_value<DataSourceType<DataSourceTypeId::Int256>> {
+        using DestinationType = DataSourceType<DataSourceTypeId::Int256>;
+
+        static inline void convert(const SourceType & src, DestinationType & dest) {
+            return to_value<DataSourceType<DataSourceTypeId::Decimal>>::convert(src, dest);
+        }
+    };
+
+    template <>
+    struct from_value<std::string>::to_value<DataSourceType<DataSourceTypeId::UInt256>> {
+        using DestinationType = DataSourceType<DataSourceTypeId::UInt256>;
+
+        static inline void convert(const SourceType & src, DestinationType & dest) {
+            return to_value<DataSourceType<DataSourceTypeId::Decimal>>::convert(src, dest);
+        }
+    };
+
+    // Used for string values that are not owned by std::string, e.g., the ones stored in a column arena.
+    // Conversions to anything other than application strings are done through a temporary std::string.
+    template <>
+    struct from_value<std::string_view> {
+        using SourceType = std::string_view;
+
+        template <typename DestinationType>
+        struct to_value {
+            static inline void convert(const SourceType & src, DestinationType & dest) {
+                return from_value<std::string>::template to_value<DestinationType>::convert(std::string{src}, dest);
+            }
+        };
+    };
+
     template <>
     struct from_value<std::int64_t> {
         using SourceType = std::int64_t;
@@ -1634,24 +1762,9 @@ namespace value_manip {
             dest.precision = src.precision;
             dest.scale = src.scale;
 
-            constexpr auto dest_max = (std::numeric_limits<decltype(dest.value)>::max)();
-            constexpr std::uint32_t byte_mult = 1 << 8;
-
-            for (std::size_t i = 1; i <= lengthof(src.val); ++i) {
-                const std::uint32_t next_byte_dig = static_cast<unsigned char>(src.val[lengthof(src.val) - i]);
-
-                if (dest.value != 0) {
-                    if ((dest_max / byte_mult) < dest.value)
-                        throw std::runtime_error("Numeric value is too big for internal representation");
-                    dest.value *= byte_mult;
-                }
-
-                if (next_byte_dig != 0) {
-                    if ((dest_max - next_byte_dig) < dest.value)
-                        throw std::runtime_error("Numeric value is too big for internal representation");
-                    dest.value += next_byte_dig;
-                }
-            }
+            // The internal representation is wider than the 128-bit little-endian magnitude of ODBC Numeric, so any value fits.
+            static_assert(sizeof(src.val) <= decltype(dest.value)::byte_count);
+            dest.value.assignLittleEndian(src.val, sizeof(src.val), false);
         }
     };
 
@@ -1808,18 +1921,28 @@ namespace value_manip {
         static inline void convert(const SourceType & src, DestinationType & dest) {
             dest.reserve(128);
 
+            // Extract the decimal digits, least significant first, dividing by 10^9 at once
+            // and then splitting each 9-digit chunk in native arithmetic.
+            constexpr std::uint32_t chunk_mult = 1'000'000'000;
+            constexpr std::size_t chunk_digits = 9;
+
+            char digits[96];
+            std::size_t digit_count = 0;
+
             auto tmp_value = src.value;
-            constexpr std::uint32_t dec_mult = 10;
 
-            while (tmp_value != 0 || dest.size() < src.scale) {
-                char next_dig = '0';
+            while (!tmp_value.isZero()) {
+                auto chunk = tmp_value.divideBy(chunk_mult);
+                const auto is_last_chunk = tmp_value.isZero();
 
-                if (tmp_value != 0) {
-                    next_dig += tmp_value % dec_mult;
-                    tmp_value /= dec_mult;
+                for (std::size_t i = 0; i < chunk_digits && (chunk != 0 || !is_last_chunk); ++i) {
+                    digits[digit_count++] = static_cast<char>('0' + chunk % 10);
+                    chunk /= 10;
                 }
+            }
 
-                dest.push_back(next_dig);
+            for (std::size_t i = 0; i < digit_count || dest.size() < src.scale; ++i) {
+                dest.push_back(i < digit_count ? digits[i] : '0');
 
                 if (dest.size() == src.scale)
                     dest.push_back('.');
@@ -1827,7 +1950,7 @@ namespace value_manip {
 
             if (dest.empty())
                 dest.push_back('0');
-            else if (src.sign == 0 && src.value != 0)
+            else if (src.sign == 0 && digit_count != 0)
                 dest.push_back('-');
 
             std::reverse(dest.begin(), dest.end());
@@ -1847,9 +1970,7 @@ namespace value_manip {
             if (dest.precision < 0 || dest.precision < dest.scale)
                 throw std::runtime_error("Bad Numeric specification");
 
-            constexpr auto src_value_max = (std::numeric_limits<decltype(src.value)>::max)();
             constexpr std::uint32_t dec_mult = 10;
-            constexpr std::uint32_t byte_mult = 1 << 8;
 
             dest.sign = src.sign;
 
@@ -1863,26 +1984,26 @@ namespace value_manip {
             // Adjust the detected scale if needed.
 
             while (tmp_src.scale < dest.scale) {
-                if ((src_value_max / dec_mult) < tmp_src.value)
+                if (!tmp_src.value.tryMultiplyAdd(dec_mult, 0))
                     throw std::runtime_error("Cannot fit source Numeric value into destination Numeric specification: value is too big for internal representation");
 
-                tmp_src.value *= dec_mult;
                 ++tmp_src.scale;
             }
 
             while (dest.scale < tmp_src.scale) {
-                tmp_src.value /= dec_mult;
+                tmp_src.value.divideBy(dec_mult);
                 --tmp_src.scale;
             }
 
             // Transfer the value.
 
-            for (std::size_t i = 0; tmp_src.value != 0; ++i) {
-                if (i >= lengthof(dest.val) || i > dest.precision)
-                    throw std::runtime_error("Cannot fit source Numeric value into destination Numeric specification: value is too big for ODBC Numeric representation");
+            const auto byte_count = tmp_src.value.significantByteCount();
+
+            if (byte_count > lengthof(dest.val) || (byte_count > 0 && byte_count - 1 > dest.precision))
+                throw std::runtime_error("Cannot fit source Numeric value into destination Numeric specification: value is too big for ODBC Numeric representation");
 
-                dest.val[i] = static_cast<std::uint32_t>(tmp_src.value % byte_mult);
-                tmp_src.value /= byte_mult;
+            for (std::size_t i = 0; i < byte_count; ++i) {
+                dest.val[i] = tmp_src.value.byteAt(i);
             }
         }
     };
@@ -1923,6 +2044,54 @@ namespace value_manip {
         };
     };
 
+    template <>
+    struct from_value<DataSourceType<DataSourceTypeId::Int128>> {
+        using SourceType = DataSourceType<DataSourceTypeId::Int128>;
+
+        template <typename DestinationType>
+        struct to_value {
+            static inline void convert(const SourceType & src, DestinationType & dest) {
+                return from_value<DataSourceType<DataSourceTypeId::Decimal>>::template to_value<DestinationType>::convert(src, dest);
+            }
+        };
+    };
+
+    template <>
+    struct from_value<DataSourceType<DataSourceTypeId::UInt128>> {
+        using SourceType = DataSourceType<DataSourceTypeId::UInt128>;
+
+        template <typename DestinationType>
+        struct to_value {
+            static inline void convert(const SourceType & src, DestinationType & dest) {
+                return from_value<DataSourceType<DataSourceTypeId::Decimal>>::template to_value<DestinationType>::convert(src, dest);
+            }
+        };
+    };
+
+    template <>
+    struct from_value<DataSourceType<DataSourceTypeId::Int256>> {
+        using SourceType = DataSourceType<DataSourceTypeId::Int256>;
+
+        template <typename DestinationType>
+        struct to_value {
+            static inline void convert(const SourceType & src, DestinationType & dest) {
+                return from_value<DataSourceType<DataSourceTypeId::Decimal>>::template to_value<DestinationType>::convert(src, dest);
+            }
+        };
+    };
+
+    template <>
+    struct from_value<DataSourceType<DataSourceTypeId::UInt256>> {
+        using SourceType = DataSourceType<DataSourceTypeId::UInt256>;
+
+        template <typename DestinationType>
+        struct to_value {
+            static inline void convert(const SourceType & src, DestinationType & dest) {
+                return from_value<DataSourceType<DataSourceTypeId::Decimal>>::template to_value<DestinationType>::convert(src, dest);
+            }
+        };
+    };
+
     template <>
     struct from_value<WireTypeAnyAsString> {
         using SourceType = WireTypeAnyAsString;
@@ -1952,19 +2121,11 @@ namespace value_manip {
         using DestinationType = DataSourceType<DataSourceTypeId::Date>;
 
         static inline void convert(const SourceType & src, DestinationType & dest) {
-            std::tm tm = {};
+            const auto date = TimeZone::toCivilDate(src.value);
 
-            {
-                // TODO: convert time according to src.timezone
-
-                std::time_t time = src.value;
-                time = time * 24 * 60 * 60; // Now it's seconds since epoch.
-                toLocalTime(time, tm);
-            }
-
-            dest.value.year = 1900 + tm.tm_year;
-            dest.value.month = 1 + tm.tm_mon;
-            dest.value.day = tm.tm_mday;
+            dest.value.year = date.year;
+            dest.value.month = date.month;
+            dest.value.day = date.day;
         }
     };
 
@@ -1985,21 +2146,14 @@ namespace value_manip {
         using DestinationType = DataSourceType<DataSourceTypeId::DateTime>;
 
         static inline void convert(const SourceType & src, DestinationType & dest) {
-            std::tm tm = {};
-
-            {
-                // TODO: convert time according to src.timezone
-
-                const std::time_t time = src.value;
-                toLocalTime(time, tm);
-            }
-
-            dest.value.year = 1900 + tm.tm_year;
-            dest.value.month = 1 + tm.tm_mon;
-            dest.value.day = tm.tm_mday;
-            dest.value.hour = tm.tm_hour;
-            dest.value.minute = tm.tm_min;
-            dest.value.second = tm.tm_sec;
+            const auto time = src.time_zone->toCivilTime(src.value);
+
+            dest.value.year = time.date.year;
+            dest.value.month = time.date.month;
+            dest.value.day = time.date.day;
+            dest.value.hour = time.hour;
+            dest.value.minute = time.minute;
+            dest.value.second = time.second;
             dest.value.fraction = 0;
         }
     };
@@ -2023,28 +2177,27 @@ namespace value_manip {
         static inline void convert(const SourceType & src, DestinationType & dest) {
             static constexpr SQLUINTEGER pow10[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
 
-            const auto secs = src.value / pow10[src.precision];
-            const auto fraction = std::abs(src.value % pow10[src.precision]);
+            // Values before the epoch are negative, but their fractional part still counts forward from the whole second.
+            auto secs = src.value / pow10[src.precision];
+            auto fraction = src.value % pow10[src.precision];
 
-            if (secs < 0 || secs > std::numeric_limits<std::time_t>::max())
-                throw std::runtime_error("Cannot represent " + std::to_string(secs) + " seconds since the Unix epoch as SQL_TIMESTAMP_STRUCT");
+            if (fraction < 0) {
+                secs -= 1;
+                fraction += pow10[src.precision];
+            }
 
-            std::tm tm = {};
+            if (secs < TimeZone::min_time || secs > TimeZone::max_time)
+                throw std::runtime_error("Cannot represent " + std::to_string(secs) + " seconds since the Unix epoch as SQL_TIMESTAMP_STRUCT");
 
-            {
-                // TODO: convert time according to src.timezone
+            const auto time = src.time_zone->toCivilTime(secs);
 
-                const std::time_t time = secs;
-                toLocalTime(time, tm);
-            }
-
-            dest.value.year = 1900 + tm.tm_year;
-            dest.value.month = 1 + tm.tm_mon;
-            dest.value.day = tm.tm_mday;
-            dest.value.hour = tm.tm_hour;
-            dest.value.minute = tm.tm_min;
-            dest.value.second = tm.tm_sec;
-            dest.value.fraction = fraction;
+            dest.value.year = time.date.year;
+            dest.value.month = time.date.month;
+            dest.value.day = time.date.day;
+            dest.value.hour = time.hour;
+            dest.value.minute = time.minute;
+            dest.value.second = time.second;
+            dest.value.fraction = fraction * pow10[9 - src.precision]; // In nanoseconds.
         }
     };
 
@@ -2080,7 +2233,7 @@ namespace value_manip {
                 if (dest.indicator && dest.indicator != dest.value_size)
                     *dest.indicator = 0; // (Null) indicator pointer of the binding. Value is not null here so we store 0 in it.
 
-                if constexpr (std::is_same_v<SourceType, std::string>) {
+                if constexpr (std::is_same_v<SourceType, std::string> || std::is_same_v<SourceType, std::string_view>) {
                     return fillOutputString<char>(src, dest.value, dest.value_max_size, dest.value_size, true, std::forward<ConversionContext>(context));
                 }
                 else if constexpr (is_string_data_source_type_v<SourceType>) {
@@ -2107,7 +2260,7 @@ namespace value_manip {
                 if (dest.indicator && dest.indicator != dest.value_size)
                     *dest.indicator = 0; // (Null) indicator pointer of the binding. Value is not null here so we store 0 in it.
 
-                if constexpr (std::is_same_v<SourceType, std::string>) {
+                if constexpr (std::is_same_v<SourceType, std::string> || std::is_same_v<SourceType, std::string_view>) {
                     return fillOutputString<char16_t>(src, dest.value, dest.value_max_size, dest.value_size, true, std::forward<ConversionContext>(context));
                 }
                 else if constexpr (is_string_data_source_type_v<SourceType>) {
@@ -2462,47 +2615,173 @@ inline auto readReadyDataTo(const BindingInfo & src, T & dest) {
     }
 }
 
+// Index of the first occurrence of T in the tuple, or the size of the tuple, if there is none.
+template <typename T, typename Tuple> struct TupleIndex; // Leave unimplemented for general case.
+
+template <typename T>
+struct TupleIndex<T, std::tuple<>>
+    : public std::integral_constant<std::size_t, 0>
+{
+};
+
+template <typename T, typename... Types>
+struct TupleIndex<T, std::tuple<T, Types...>>
+    : public std::integral_constant<std::size_t, 0>
+{
+};
+
+template <typename T, typename U, typename... Types>
+struct TupleIndex<T, std::tuple<U, Types...>>
+    : public std::integral_constant<std::size_t, 1 + TupleIndex<T, std::tuple<Types...>>::value>
+{
+};
+
+// Buffer representations of the C types that values can be written to. Several C types may share the same representation.
+using WritableBufferTypes = std::tuple<
+    char *,
+    char16_t *,
+    SQLCHAR,
+    SQLSCHAR,
+    SQLSMALLINT,
+    SQLUSMALLINT,
+    SQLINTEGER,
+    SQLUINTEGER,
+    SQLBIGINT,
+    SQLUBIGINT,
+    SQLREAL,
+    SQLDOUBLE,
+    SQLGUID,
+    SQL_NUMERIC_STRUCT,
+    SQL_DATE_STRUCT,
+    SQL_TIME_STRUCT,
+    SQL_TIMESTAMP_STRUCT
+>;
+
+inline constexpr std::size_t writable_buffer_type_count = std::tuple_size_v<WritableBufferTypes>;
+
+template <typename BufferType>
+inline constexpr std::size_t getWritableBufferTypeIndex() {
+    return TupleIndex<BufferType, WritableBufferTypes>::value;
+}
+
+// Index of the representation of the C type in WritableBufferTypes, or writable_buffer_type_count, if values can't be written to it.
+inline std::size_t getWritableBufferTypeIndex(SQLSMALLINT c_type) {
+    switch (c_type) {
+        case SQL_C_CHAR:           return getWritableBufferTypeIndex< char *               >();
+        case SQL_C_WCHAR:          return getWritableBufferTypeIndex< char16_t *           >();
+        case SQL_C_BIT:            return getWritableBufferTypeIndex< SQLCHAR              >();
+        case SQL_C_TINYINT:        return getWritableBufferTypeIndex< SQLSCHAR             >();
+        case SQL_C_STINYINT:       return getWritableBufferTypeIndex< SQLSCHAR             >();
+        case SQL_C_UTINYINT:       return getWritableBufferTypeIndex< SQLCHAR              >();
+        case SQL_C_SHORT:          return getWritableBufferTypeIndex< SQLSMALLINT          >();
+        case SQL_C_SSHORT:         return getWritableBufferTypeIndex< SQLSMALLINT          >();
+        case SQL_C_USHORT:         return getWritableBufferTypeIndex< SQLUSMALLINT         >();
+        case SQL_C_LONG:           return getWritableBufferTypeIndex< SQLINTEGER           >();
+        case SQL_C_SLONG:          return getWritableBufferTypeIndex< SQLINTEGER           >();
+        case SQL_C_ULONG:          return getWritableBufferTypeIndex< SQLUINTEGER          >();
+        case SQL_C_SBIGINT:        return getWritableBufferTypeIndex< SQLBIGINT            >();
+        case SQL_C_UBIGINT:        return getWritableBufferTypeIndex< SQLUBIGINT           >();
+        case SQL_C_FLOAT:          return getWritableBufferTypeIndex< SQLREAL              >();
+        case SQL_C_DOUBLE:         return getWritableBufferTypeIndex< SQLDOUBLE            >();
+        case SQL_C_BINARY:         return getWritableBufferTypeIndex< char *               >();
+        case SQL_C_GUID:           return getWritableBufferTypeIndex< SQLGUID              >();
+
+//      case SQL_C_BOOKMARK:       return getWritableBufferTypeIndex< BOOKMARK             >();
+//      case SQL_C_VARBOOKMARK:    return getWritableBufferTypeIndex< SQLCHAR *            >();
+
+        case SQL_C_NUMERIC:        return getWritableBufferTypeIndex< SQL_NUMERIC_STRUCT   >();
+
+        case SQL_C_DATE:
+        case SQL_C_TYPE_DATE:      return getWritableBufferTypeIndex< SQL_DATE_STRUCT      >();
+
+        case SQL_C_TIME:
+        case SQL_C_TYPE_TIME:      return getWritableBufferTypeIndex< SQL_TIME_STRUCT      >();
+
+        case SQL_C_TIMESTAMP:
+        case SQL_C_TYPE_TIMESTAMP: return getWritableBufferTypeIndex< SQL_TIMESTAMP_STRUCT >();
+
+        default:                   return writable_buffer_type_count;
+    }
+}
+
+// Writes the value into the bound buffer, whose C type is represented by BufferType.
+template <typename BufferType, typename T, typename ConversionContext>
+inline SQLRETURN writeDataAs(const T & src, BindingInfo & dest, ConversionContext && context) {
+    if constexpr (std::is_same_v<BufferType, char *> || std::is_same_v<BufferType, char16_t *>)
+        return value_manip::to_buffer<BufferType>::template from_value<T>::convert(src, dest, std::forward<ConversionContext>(context));
+    else
+        return value_manip::to_buffer<BufferType>::template from_value<T>::convert(src, dest);
+}
+
+// Converts the value to the string, that writeDataFrom() would write into a binding of SQL_C_CHAR/SQL_C_BINARY (for CharType == char)
+// or SQL_C_WCHAR (for CharType == char16_t), without writing it anywhere. The string is allocated from the string pool of the context.
+template <typename CharType, typename T, typename ConversionContext>
+inline std::basic_string<CharType> convertDataToString(const T & src, ConversionContext && context) {
+    if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>) {
+        return fromUTF8<CharType>(src, context);
+    }
+    else if constexpr (is_string_data_source_type_v<T>) {
+        return fromUTF8<CharType>(src.value, context);
+    }
+    else {
+        std::string dest_obj;
+        value_manip::to_null(dest_obj);
+        value_manip::from_value<T>::template to_value<std::string>::convert(src, dest_obj);
+        return fromUTF8<CharType>(dest_obj, context);
+    }
+}
+
 template <typename T, typename ConversionContext>
-inline auto writeDataFrom(const T & src, BindingInfo & dest, ConversionContext && context) {
+inline SQLRETURN writeDataFrom(const T & src, BindingInfo & dest, ConversionContext && context) {
     switch (dest.c_type) {
-        case SQL_C_CHAR:           return value_manip::to_buffer< char *               >::template from_value< T >::convert(src, dest, std::forward<ConversionContext>(context));
-        case SQL_C_WCHAR:          return value_manip::to_buffer< char16_t *           >::template from_value< T >::convert(src, dest, std::forward<ConversionContext>(context));
-        case SQL_C_BIT:            return value_manip::to_buffer< SQLCHAR              >::template from_value< T >::convert(src, dest);
-        case SQL_C_TINYINT:        return value_manip::to_buffer< SQLSCHAR             >::template from_value< T >::convert(src, dest);
-        case SQL_C_STINYINT:       return value_manip::to_buffer< SQLSCHAR             >::template from_value< T >::convert(src, dest);
-        case SQL_C_UTINYINT:       return value_manip::to_buffer< SQLCHAR              >::template from_value< T >::convert(src, dest);
-        case SQL_C_SHORT:          return value_manip::to_buffer< SQLSMALLINT          >::template from_value< T >::convert(src, dest);
-        case SQL_C_SSHORT:         return value_manip::to_buffer< SQLSMALLINT          >::template from_value< T >::convert(src, dest);
-        case SQL_C_USHORT:         return value_manip::to_buffer< SQLUSMALLINT         >::template from_value< T >::convert(src, dest);
-        case SQL_C_LONG:           return value_manip::to_buffer< SQLINTEGER           >::template from_value< T >::convert(src, dest);
-        case SQL_C_SLONG:          return value_manip::to_buffer< SQLINTEGER           >::template from_value< T >::convert(src, dest);
-        case SQL_C_ULONG:          return value_manip::to_buffer< SQLUINTEGER          >::template from_value< T >::convert(src, dest);
-        case SQL_C_SBIGINT:        return value_manip::to_buffer< SQLBIGINT            >::template from_value< T >::convert(src, dest);
-        case SQL_C_UBIGINT:        return value_manip::to_buffer< SQLUBIGINT           >::template from_value< T >::convert(src, dest);
-        case SQL_C_FLOAT:          return value_manip::to_buffer< SQLREAL              >::template from_value< T >::convert(src, dest);
-        case SQL_C_DOUBLE:         return value_manip::to_buffer< SQLDOUBLE            >::template from_value< T >::convert(src, dest);
-        case SQL_C_BINARY:         return value_manip::to_buffer< char *               >::template from_value< T >::convert(src, dest, std::forward<ConversionContext>(context));
-        case SQL_C_GUID:           return value_manip::to_buffer< SQLGUID              >::template from_value< T >::convert(src, dest);
-
-//      case SQL_C_BOOKMARK:       return value_manip::to_buffer< BOOKMARK             >::template from_value< T >::convert(src, dest);
-//      case SQL_C_VARBOOKMARK:    return value_manip::to_buffer< SQLCHAR *            >::template from_value< T >::convert(src, dest);
-
-        case SQL_C_NUMERIC:        return value_manip::to_buffer< SQL_NUMERIC_STRUCT   >::template from_value< T >::convert(src, dest);
+        case SQL_C_CHAR:           return writeDataAs< char *               >(src, dest, std::forward<ConversionContext>(context));
+        case SQL_C_WCHAR:          return writeDataAs< char16_t *           >(src, dest, std::forward<ConversionContext>(context));
+        case SQL_C_BIT:            return writeDataAs< SQLCHAR              >(src, dest, std::forward<ConversionContext>(context));
+        case SQL_C_TINYINT:        return writeDataAs< SQLSCHAR             >(src, dest, std::forward<ConversionContext>(context));
+        case SQL_C_STINYINT:       return writeDataAs< SQLSCHAR             >(src, dest, std::forward<ConversionContext>(context));
+        case SQL_C_UTINYINT:       return writeDataAs< SQLCHAR              >(src, dest, std::forward<ConversionContext>(context));
+        case SQL_C_SHORT:          return writeDataAs< SQLSMALLINT          >(src, dest, std::forward<ConversionContext>(context));
+        case SQL_C_SSHORT:         return writeDataAs< SQLSMALLINT          >(src, dest, std::forward<ConversionContext>(context));
+        case SQL_C_USHORT:         return writeDataAs< SQLUSMALLINT         >(src, dest, std::forward<ConversionContext>(context));
+        case SQL_C_LONG:           return writeDataAs< SQLINTEGER           >(src, dest, std::forward<ConversionContext>(context));
+        case SQL_C_SLONG:          return writeDataAs< SQLINTEGER           >(src, dest, std::forward<ConversionContext>(context));
+        case SQL_C_ULONG:          return writeDataAs< SQLUINTEGER          >(src, dest, std::forward<ConversionContext>(context));
+        case SQL_C_SBIGINT:        return writeDataAs< SQLBIGINT            >(src, dest, std::forward<ConversionContext>(context));
+        case SQL_C_UBIGINT:        return writeDataAs< SQLUBIGINT           >(src, dest, std::forward<ConversionContext>(context));
+        case SQL_C_FLOAT:          return writeDataAs< SQLREAL              >(src, dest, std::forward<ConversionContext>(context));
+        case SQL_C_DOUBLE:         return writeDataAs< SQLDOUBLE            >(src, dest, std::forward<ConversionContext>(context));
+        case SQL_C_BINARY:         return writeDataAs< char *               >(src, dest, std::forward<ConversionContext>(context));
+        case SQL_C_GUID:           return writeDataAs< SQLGUID              >(src, dest, std::forward<ConversionContext>(context));
+
+//      case SQL_C_BOOKMARK:       return writeDataAs< BOOKMARK             >(src, dest, std::forward<ConversionContext>(context));
+//      case SQL_C_VARBOOKMARK:    return writeDataAs< SQLCHAR *            >(src, dest, std::forward<ConversionContext>(context));
+
+        case SQL_C_NUMERIC:        return writeDataAs< SQL_NUMERIC_STRUCT   >(src, dest, std::forward<ConversionContext>(context));
 
         case SQL_C_DATE:
-        case SQL_C_TYPE_DATE:      return value_manip::to_buffer< SQL_DATE_STRUCT      >::template from_value< T >::convert(src, dest);
+        case SQL_C_TYPE_DATE:      return writeDataAs< SQL_DATE_STRUCT      >(src, dest, std::forward<ConversionContext>(context));
 
         case SQL_C_TIME:
-        case SQL_C_TYPE_TIME:      return value_manip::to_buffer< SQL_TIME_STRUCT      >::template from_value< T >::convert(src, dest);
+        case SQL_C_TYPE_TIME:      return writeDataAs< SQL_TIME_STRUCT      >(src, dest, std::forward<ConversionContext>(context));
 
         case SQL_C_TIMESTAMP:
-        case SQL_C_TYPE_TIMESTAMP: return value_manip::to_buffer< SQL_TIMESTAMP_STRUCT >::template from_value< T >::convert(src, dest);
+        case SQL_C_TYPE_TIMESTAMP: return writeDataAs< SQL_TIMESTAMP_STRUCT >(src, dest, std::forward<ConversionContext>(context));
 
         default:
             throw std::runtime_error("Unable to write data into bound buffer: destination type representation not supported");
     }
 }
 
+// Writes the string, that is already converted to the encoding of SQL_C_CHAR/SQL_C_BINARY (for CharType == char)
+// or SQL_C_WCHAR (for CharType == char16_t), into the bound buffer, same way writeDataFrom() would do for the original value.
+template <typename CharType>
+inline SQLRETURN writeConvertedStringTo(const std::basic_string_view<CharType> & src, BindingInfo & dest) {
+    if (dest.indicator && dest.indicator != dest.value_size)
+        *dest.indicator = 0; // (Null) indicator pointer of the binding. Value is not null here so we store 0 in it.
+
+    return fillOutputConvertedString<CharType>(src, dest.value, dest.value_max_size, dest.value_size, true);
+}
+
 inline std::string toSqlQueryValue(UnsignedAttribute attr)
 {
     using enum UnsignedAttribute;
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "driver/platform/platform.h"
+
+#include <array>
+
+#include <cstddef>
+#include <cstdint>
+
+// Fixed-width unsigned integer, wide enough to hold the values of Decimal128/Decimal256 and (U)Int128/(U)Int256 types.
+// Only the operations needed for decoding such values and for converting them to/from text and SQL_NUMERIC_STRUCT are implemented.
+// The value is stored in 32-bit limbs, least significant first, so that every operation can be carried out
+// in plain 64-bit arithmetic, without relying on compiler-specific 128-bit integer types.
+template <std::size_t Bits>
+class WideUInt {
+    static_assert(Bits > 0 && Bits % 32 == 0, "WideUInt must consist of whole 32-bit limbs");
+
+public:
+    static constexpr std::size_t limb_count = Bits / 32;
+    static constexpr std::size_t byte_count = Bits / 8;
+
+    constexpr WideUInt() noexcept = default;
+
+    constexpr WideUInt(std::uint64_t value) noexcept {
+        limbs[0] = static_cast<std::uint32_t>(value);
+        if constexpr (limb_count > 1)
+            limbs[1] = static_cast<std::uint32_t>(value >> 32);
+    }
+
+    // Assigns the little-endian integer of size bytes (at most byte_count) located at data.
+    // If the integer is signed and negative, its absolute value is assigned, and true is returned.
+    bool assignLittleEndian(const void * data, std::size_t size, bool is_signed) noexcept {
+        const auto * bytes = static_cast<const unsigned char *>(data);
+        const bool is_negative = (is_signed && size > 0 && (bytes[size - 1] & 0x80) != 0);
+        const unsigned char fill = (is_negative ? 0xFF : 0x00);
+
+        for (std::size_t i = 0; i < limb_count; ++i) {
+            std::uint32_t limb = 0;
+            for (std::size_t j = 4; j > 0; --j) {
+                const auto pos = i * 4 + j - 1;
+                limb = (limb << 8) | (pos < size ? bytes[pos] : fill);
+            }
+            limbs[i] = limb;
+        }
+
+        if (is_negative)
+            negate();
+
+        return is_negative;
+    }
+
+    // Number of bytes needed to represent the value, zero for zero.
+    std::size_t significantByteCount() const noexcept {
+        for (std::size_t i = limb_count; i > 0; --i) {
+            if (const auto limb = limbs[i - 1]; limb != 0) {
+                std::size_t count = (i - 1) * 4 + 1;
+                for (auto rest = limb >> 8; rest != 0; rest >>= 8)
+                    ++count;
+                return count;
+            }
+        }
+
+        return 0;
+    }
+
+    unsigned char byteAt(std::size_t idx) const noexcept {
+        return static_cast<unsigned char>(limbs[idx / 4] >> (idx % 4 * 8));
+    }
+
+    bool isZero() const noexcept {
+        for (const auto limb : limbs) {
+            if (limb != 0)
+                return false;
+        }
+
+        return true;
+    }
+
+    // Computes value * mult + add. Returns false and leaves the value unspecified, if the result does not fit.
+    bool tryMultiplyAdd(std::uint32_t mult, std::uint32_t add) noexcept {
+        std::uint64_t carry = add;
+
+        for (auto & limb : limbs) {
+            const std::uint64_t tmp = static_cast<std::uint64_t>(limb) * mult + carry;
+            limb = static_cast<std::uint32_t>(tmp);
+            carry = tmp >> 32;
+        }
+
+        return (carry == 0);
+    }
+
+    // Divides the value by divisor in place and returns the remainder.
+    std::uint32_t divideBy(std::uint32_t divisor) noexcept {
+        std::uint64_t remainder = 0;
+
+        for (std::size_t i = limb_count; i > 0; --i) {
+            const std::uint64_t tmp = (remainder << 32) | limbs[i - 1];
+            limbs[i - 1] = static_cast<std::uint32_t>(tmp / divisor);
+            remainder = tmp % divisor;
+        }
+
+        return static_cast<std::uint32_t>(remainder);
+    }
+
+    friend bool operator== (const WideUInt & lhs, const WideUInt & rhs) noexcept {
+        return lhs.limbs == rhs.limbs;
+    }
+
+    friend bool operator!= (const WideUInt & lhs, const WideUInt & rhs) noexcept {
+        return lhs.limbs != rhs.limbs;
+    }
+
+private:
+    void negate() noexcept {
+        std::uint64_t carry = 1;
+
+        for (auto & limb : limbs) {
+            const std::uint64_t tmp = static_cast<std::uint64_t>(static_cast<std::uint32_t>(~limb)) + carry;
+            limb = static_cast<std::uint32_t>(tmp);
+            carry = tmp >> 32;
+        }
+    }
+
+private:
+    std::array<std::uint32_t, limb_count> limbs = {};
+};